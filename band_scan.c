@@ -0,0 +1,334 @@
+/*
+ * band_scan.c
+ *
+ * Parallel band scan across idle tuners
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "hdhomerun.h"
+#include "hdhomerun_device.h"
+#include "band_scan.h"
+#include "status_fields.h"
+
+// Same timing as hdhomerun_device_wait_for_lock: let the signal reading
+// settle, give up at once if there is no signal, otherwise wait for lock.
+#define BAND_SCAN_SETTLE_MS 250
+#define BAND_SCAN_LOCK_TIMEOUT_MS 2500
+#define BAND_SCAN_ID_TIMEOUT_MS 2000   // TSID/BSID arrive after the PSI/L1 is read
+#define BAND_SCAN_POLL_MS 100
+
+struct band_scan_worker {
+    struct band_scan *scan;
+    pthread_t thread;
+    bool started;
+    bool running;                   // Guarded by scan->lock
+    struct band_scan_tuner tuner;
+};
+
+struct band_scan {
+    pthread_mutex_t lock;
+    bool cancel;
+    int queue[BAND_SCAN_MAX_CHANNELS];  // Indexes into results, in scan order
+    bool taken[BAND_SCAN_MAX_CHANNELS]; // Queue entry handed out
+    int queue_count;
+    int channel_count;
+    int tuners_used;
+    struct band_scan_result results[BAND_SCAN_MAX_CHANNELS];
+    int tuner_count;
+    struct band_scan_worker workers[BAND_SCAN_MAX_TUNERS];
+};
+
+static void sleep_ms(long ms) {
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+static long elapsed_since_ms(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
+static bool scan_cancelled(struct band_scan *scan) {
+    pthread_mutex_lock(&scan->lock);
+    bool cancelled = scan->cancel;
+    pthread_mutex_unlock(&scan->lock);
+    return cancelled;
+}
+
+/*
+ * tuner_is_idle
+ * A tuner is free to scan when nothing is streaming from it and no other
+ * client holds its lockkey.
+ */
+static bool tuner_is_idle(struct hdhomerun_device_t *hd, int tuner_index) {
+    char path[64];
+    char *value;
+
+    snprintf(path, sizeof(path), "/tuner%d/target", tuner_index);
+    if (hdhomerun_device_get_var(hd, path, &value, NULL) > 0 && value[0] && strcmp(value, "none") != 0) {
+        return false;
+    }
+    snprintf(path, sizeof(path), "/tuner%d/lockkey", tuner_index);
+    if (hdhomerun_device_get_var(hd, path, &value, NULL) > 0 && value[0] && strcmp(value, "none") != 0) {
+        return false;
+    }
+    return true;
+}
+
+static void record_status(struct band_scan_result *res, const struct hdhomerun_tuner_status_t *status, const char *raw_status) {
+    struct status_fields fields;
+    status_fields_init(&fields);
+    status_fields_parse(&fields, raw_status);
+
+    res->signal_present = status->signal_present;
+    res->locked = status->lock_supported;
+    snprintf(res->lock_str, sizeof(res->lock_str), "%s", status->lock_str);
+    res->ss = status->signal_strength;
+    res->snq = status->signal_to_noise_quality;
+    res->seq = status->symbol_error_quality;
+    res->ss_dbm = fields.db[STATUS_KEY_SS];
+    res->snq_db = fields.db[STATUS_KEY_SNQ];
+}
+
+/*
+ * scan_channel
+ * Tunes one channel and fills res. Returns BAND_SCAN_DONE once measured,
+ * BAND_SCAN_FAILED if the tuner didn't answer the tune or status request,
+ * or BAND_SCAN_PENDING if the scan was cancelled part way through.
+ */
+static enum band_scan_state scan_channel(struct band_scan *scan, struct hdhomerun_device_t *hd, unsigned int channel,
+                         struct band_scan_result *res) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    char tune_str[32];
+    snprintf(tune_str, sizeof(tune_str), "auto:%u", channel);
+    if (hdhomerun_device_set_tuner_channel(hd, tune_str) <= 0) {
+        res->scan_ms = elapsed_since_ms(&start);
+        return BAND_SCAN_FAILED;
+    }
+    sleep_ms(BAND_SCAN_SETTLE_MS);
+
+    struct hdhomerun_tuner_status_t status;
+    char *raw_status;
+    for (;;) {
+        if (scan_cancelled(scan)) return BAND_SCAN_PENDING;
+        if (hdhomerun_device_get_tuner_status(hd, &raw_status, &status) <= 0) {
+            res->scan_ms = elapsed_since_ms(&start);
+            return BAND_SCAN_FAILED;
+        }
+        record_status(res, &status, raw_status);
+        if (!status.signal_present || status.lock_supported || status.lock_unsupported) break;
+        if (elapsed_since_ms(&start) >= BAND_SCAN_SETTLE_MS + BAND_SCAN_LOCK_TIMEOUT_MS) break;
+        sleep_ms(BAND_SCAN_POLL_MS);
+    }
+
+    if (res->locked) {
+        bool atsc3 = strstr(res->lock_str, "atsc3") != NULL;
+        long id_deadline_ms = elapsed_since_ms(&start) + BAND_SCAN_ID_TIMEOUT_MS;
+        for (;;) {
+            if (scan_cancelled(scan)) return BAND_SCAN_PENDING;
+            char *info;
+            if (atsc3) {
+                if (hdhomerun_device_get_tuner_plpinfo(hd, &info) > 0) res->bsid = status_fields_lookup(info, STATUS_KEY_BSID);
+                if (res->bsid != STATUS_VALUE_NONE) break;
+            } else {
+                if (hdhomerun_device_get_tuner_streaminfo(hd, &info) > 0) res->tsid = status_fields_lookup(info, STATUS_KEY_TSID);
+                if (res->tsid != STATUS_VALUE_NONE) break;
+            }
+            if (elapsed_since_ms(&start) >= id_deadline_ms) break;
+            sleep_ms(BAND_SCAN_POLL_MS);
+        }
+        // Signal figures are steadier once the tuner has been locked a while
+        if (hdhomerun_device_get_tuner_status(hd, &raw_status, &status) > 0) {
+            record_status(res, &status, raw_status);
+        }
+        char *plpinfo;
+        if (atsc3 && hdhomerun_device_get_tuner_plpinfo(hd, &plpinfo) > 0) {
+            res->plp_mask = scan_db_plp_mask(plpinfo);
+        }
+    }
+
+    res->scan_ms = elapsed_since_ms(&start);
+    return BAND_SCAN_DONE;
+}
+
+static void* band_scan_worker_thread(void *arg) {
+    struct band_scan_worker *worker = (struct band_scan_worker *)arg;
+    struct band_scan *scan = worker->scan;
+    const struct band_scan_tuner *tuner = &worker->tuner;
+
+    // Each worker has its own control connection
+    struct hdhomerun_device_t *hd = hdhomerun_device_create_from_str(tuner->ip_str, NULL);
+    if (hd) hdhomerun_device_set_tuner(hd, tuner->tuner_index);
+
+    char restore_channel[64] = "";
+    bool idle = hd && !scan_cancelled(scan) && tuner_is_idle(hd, tuner->tuner_index);
+
+    // Hold the lockkey while scanning so no other client retunes the tuner
+    // under us; losing the race to another client means it isn't idle
+    char *lock_error = NULL;
+    if (idle && hdhomerun_device_tuner_lockkey_request(hd, &lock_error) <= 0) idle = false;
+    if (idle) {
+        struct hdhomerun_tuner_status_t status;
+        char *raw_status;
+        if (hdhomerun_device_get_tuner_status(hd, &raw_status, &status) > 0) {
+            snprintf(restore_channel, sizeof(restore_channel), "%s", status.channel);
+        }
+        pthread_mutex_lock(&scan->lock);
+        scan->tuners_used++;
+        pthread_mutex_unlock(&scan->lock);
+    }
+
+    while (idle) {
+        pthread_mutex_lock(&scan->lock);
+        int q = 0;
+        while (q < scan->queue_count &&
+               (scan->taken[q] || strcmp(scan->results[scan->queue[q]].channelmap, tuner->channelmap) != 0)) q++;
+        if (scan->cancel || q >= scan->queue_count) {
+            pthread_mutex_unlock(&scan->lock);
+            break;
+        }
+        scan->taken[q] = true;
+        struct band_scan_result *shared = &scan->results[scan->queue[q]];
+        shared->state = BAND_SCAN_SCANNING;
+        shared->device_id = tuner->device_id;
+        shared->tuner_index = tuner->tuner_index;
+        struct band_scan_result res = *shared;
+        pthread_mutex_unlock(&scan->lock);
+
+        res.state = scan_channel(scan, hd, res.channel, &res);
+
+        pthread_mutex_lock(&scan->lock);
+        *shared = res;
+        pthread_mutex_unlock(&scan->lock);
+    }
+
+    if (idle && restore_channel[0]) {
+        hdhomerun_device_set_tuner_channel(hd, restore_channel);
+    }
+    if (idle) hdhomerun_device_tuner_lockkey_release(hd);
+    if (hd) hdhomerun_device_destroy(hd);
+
+    pthread_mutex_lock(&scan->lock);
+    worker->running = false;
+    pthread_mutex_unlock(&scan->lock);
+    return NULL;
+}
+
+struct band_scan* band_scan_start(const struct band_scan_tuner tuners[], int tuner_count,
+                                  const struct band_scan_channel channels[], int channel_count,
+                                  const enum scan_db_verdict verdicts[]) {
+    if (tuner_count > BAND_SCAN_MAX_TUNERS) tuner_count = BAND_SCAN_MAX_TUNERS;
+    if (channel_count > BAND_SCAN_MAX_CHANNELS) channel_count = BAND_SCAN_MAX_CHANNELS;
+
+    struct band_scan *scan = calloc(1, sizeof(struct band_scan));
+    if (!scan) return NULL;
+    pthread_mutex_init(&scan->lock, NULL);
+    scan->channel_count = channel_count;
+    scan->tuner_count = tuner_count;
+
+    for (int i = 0; i < channel_count; i++) {
+        struct band_scan_result *res = &scan->results[i];
+        res->channel = channels[i].channel;
+        snprintf(res->channelmap, sizeof(res->channelmap), "%s", channels[i].channelmap);
+        res->state = BAND_SCAN_PENDING;
+        res->ss_dbm = res->snq_db = STATUS_VALUE_NONE;
+        res->tsid = res->bsid = STATUS_VALUE_NONE;
+        if (verdicts && verdicts[i] == SCAN_DB_DEAD) res->state = BAND_SCAN_SKIPPED;
+    }
+
+    // Known-live channels first, then the ones with no (current) result
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < channel_count; i++) {
+            enum scan_db_verdict verdict = verdicts ? verdicts[i] : SCAN_DB_UNKNOWN;
+            if (verdict == SCAN_DB_DEAD) continue;
+            if ((verdict == SCAN_DB_LIVE) == (pass == 0)) scan->queue[scan->queue_count++] = i;
+        }
+    }
+
+    for (int i = 0; i < tuner_count; i++) {
+        struct band_scan_worker *worker = &scan->workers[i];
+        worker->scan = scan;
+        worker->tuner = tuners[i];
+        worker->running = true;
+        if (pthread_create(&worker->thread, NULL, band_scan_worker_thread, worker) == 0) {
+            worker->started = true;
+        } else {
+            worker->running = false;
+        }
+    }
+    return scan;
+}
+
+void band_scan_cancel(struct band_scan *scan) {
+    if (!scan) return;
+    pthread_mutex_lock(&scan->lock);
+    scan->cancel = true;
+    pthread_mutex_unlock(&scan->lock);
+}
+
+void band_scan_destroy(struct band_scan *scan) {
+    if (!scan) return;
+    for (int i = 0; i < scan->tuner_count; i++) {
+        if (scan->workers[i].started) pthread_join(scan->workers[i].thread, NULL);
+    }
+    pthread_mutex_destroy(&scan->lock);
+    free(scan);
+}
+
+int band_scan_channel_count(struct band_scan *scan) {
+    return scan ? scan->channel_count : 0;
+}
+
+void band_scan_get_result(struct band_scan *scan, int index, struct band_scan_result *out) {
+    memset(out, 0, sizeof(*out));
+    if (!scan || index < 0 || index >= scan->channel_count) return;
+
+    pthread_mutex_lock(&scan->lock);
+    *out = scan->results[index];
+    pthread_mutex_unlock(&scan->lock);
+}
+
+int band_scan_tuners_used(struct band_scan *scan) {
+    if (!scan) return 0;
+    pthread_mutex_lock(&scan->lock);
+    int used = scan->tuners_used;
+    pthread_mutex_unlock(&scan->lock);
+    return used;
+}
+
+int band_scan_done_count(struct band_scan *scan) {
+    if (!scan) return 0;
+    int done = 0;
+    pthread_mutex_lock(&scan->lock);
+    for (int i = 0; i < scan->channel_count; i++) {
+        if (scan->results[i].state == BAND_SCAN_DONE || scan->results[i].state == BAND_SCAN_FAILED) done++;
+    }
+    pthread_mutex_unlock(&scan->lock);
+    return done;
+}
+
+bool band_scan_active(struct band_scan *scan) {
+    if (!scan) return false;
+
+    bool active = false;
+    pthread_mutex_lock(&scan->lock);
+    for (int i = 0; i < scan->tuner_count && !active; i++) {
+        active = scan->workers[i].running;
+    }
+    pthread_mutex_unlock(&scan->lock);
+    return active;
+}
@@ -0,0 +1,97 @@
+/*
+ * band_scan.h
+ *
+ * Parallel band scan across idle tuners
+ * Channels are handed out one at a time to a worker per tuner, so every
+ * idle tuner on a device (or on several devices) scans part of the band
+ * at once, and results land in one table indexed by channel. Devices on
+ * different channel maps each take only the channels of their own map.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef BAND_SCAN_H
+#define BAND_SCAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scan_db.h"
+
+#define BAND_SCAN_MAX_TUNERS 64
+#define BAND_SCAN_MAX_CHANNELS 256
+
+struct band_scan_tuner {
+    uint32_t device_id;
+    char ip_str[64];
+    int tuner_index;
+    char channelmap[32];        // Scans only channels of this map
+};
+
+struct band_scan_channel {
+    unsigned int channel;
+    char channelmap[32];
+};
+
+enum band_scan_state {
+    BAND_SCAN_PENDING,          // Not scanned yet, or the scan was cancelled first
+    BAND_SCAN_SCANNING,
+    BAND_SCAN_DONE,
+    BAND_SCAN_FAILED,           // A control request failed; nothing was measured
+    BAND_SCAN_SKIPPED,          // Recently confirmed dead in the scan db
+};
+
+struct band_scan_result {
+    unsigned int channel;
+    char channelmap[32];
+    enum band_scan_state state;
+    uint32_t device_id;         // Tuner that scanned the channel
+    int tuner_index;
+
+    bool signal_present;
+    bool locked;
+    char lock_str[32];
+    unsigned int ss, snq, seq;  // Percent
+    long ss_dbm, snq_db;        // STATUS_VALUE_NONE if the model doesn't report them
+    long tsid;                  // ATSC 1.0, STATUS_VALUE_NONE if not seen
+    long bsid;                  // ATSC 3.0, STATUS_VALUE_NONE if not seen
+    uint64_t plp_mask;          // ATSC 3.0: bit n set if PLP n is present
+    long scan_ms;
+};
+
+struct band_scan;
+
+// Starts one worker per tuner. Each worker first checks that its tuner is
+// idle (no stream target, no lockkey) and takes the tuner's lockkey for
+// the length of the scan, dropping out if either fails; idle tuners then
+// take channels of their map from a shared queue until the list is done.
+// Every tuner is put back on its original channel, and its lockkey
+// released, when its worker finishes.
+// verdicts (may be NULL) orders the queue: known-live channels go first,
+// and dead ones are marked BAND_SCAN_SKIPPED without being tuned.
+struct band_scan* band_scan_start(const struct band_scan_tuner tuners[], int tuner_count,
+                                  const struct band_scan_channel channels[], int channel_count,
+                                  const enum scan_db_verdict verdicts[]);
+
+// Stops handing out channels and abandons the ones being scanned.
+void band_scan_cancel(struct band_scan *scan);
+
+// Joins the workers and frees the scan.
+void band_scan_destroy(struct band_scan *scan);
+
+int band_scan_channel_count(struct band_scan *scan);
+void band_scan_get_result(struct band_scan *scan, int index, struct band_scan_result *out);
+
+// Tuners that passed the idle check, and how many channels have finished
+// (measured or failed)
+int band_scan_tuners_used(struct band_scan *scan);
+int band_scan_done_count(struct band_scan *scan);
+
+// True while any worker is running.
+bool band_scan_active(struct band_scan *scan);
+
+#endif // BAND_SCAN_H
@@ -0,0 +1,199 @@
+/*
+ * capbench.c
+ *
+ * Throughput benchmark for the HTTP capture paths
+ * Serves a fixed volume of TS-sized data over loopback as a device would
+ * on port 5004, and captures it with capture_session once on the
+ * recv/fwrite path and once on the splice path, reporting the capture
+ * thread's CPU per Mbps for each. Built and run by "make bench".
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE // RUSAGE_THREAD
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "capture_engine.h"
+
+#define BENCH_PORT 5004         // capture_session always talks to the device port
+#define BENCH_CHUNK (256 * 1024)
+#define BENCH_POLL_MS 250
+
+// Only the capturing thread is charged, not the loopback server
+#ifdef RUSAGE_THREAD
+#define BENCH_RUSAGE_WHO RUSAGE_THREAD
+#else
+#define BENCH_RUSAGE_WHO RUSAGE_SELF
+#endif
+
+struct bench_server {
+    int listen_sock;
+    uint64_t bytes;
+};
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double cpu_s(void) {
+    struct rusage usage;
+    getrusage(BENCH_RUSAGE_WHO, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+/*
+ * server_thread
+ * Answers one request with an HTTP header and then bytes of 188-byte
+ * packets, then closes the connection.
+ */
+static void* server_thread(void *arg) {
+    struct bench_server *server = (struct bench_server *)arg;
+    int sock = accept(server->listen_sock, NULL, NULL);
+    if (sock < 0) return NULL;
+
+    char request[1024];
+    if (recv(sock, request, sizeof(request), 0) <= 0) {
+        close(sock);
+        return NULL;
+    }
+    const char *reply = "HTTP/1.0 200 OK\r\nContent-Type: video/mpeg\r\n\r\n";
+    send(sock, reply, strlen(reply), MSG_NOSIGNAL);
+
+    static uint8_t chunk[BENCH_CHUNK / 188 * 188];
+    for (size_t i = 0; i < sizeof(chunk); i++) chunk[i] = (i % 188 == 0) ? 0x47 : (uint8_t)i;
+
+    uint64_t left = server->bytes;
+    while (left > 0) {
+        size_t n = left < sizeof(chunk) ? (size_t)left : sizeof(chunk);
+        ssize_t sent = send(sock, chunk, n, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) break;
+        left -= sent;
+    }
+    close(sock);
+    return NULL;
+}
+
+static int open_listener(void) {
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) return -1;
+    int on = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(BENCH_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(sock, 1) < 0) {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+/*
+ * run_capture
+ * Captures one served stream into filename the way http_save_stream does:
+ * poll() for the socket, then pump. Returns false if it didn't complete.
+ */
+static bool run_capture(int listen_sock, uint64_t bytes, bool splice_path, const char *filename) {
+    struct bench_server server = { listen_sock, bytes };
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, server_thread, &server) != 0) return false;
+
+    char err[128];
+    struct capture_session *session = capture_session_open("127.0.0.1", "http://127.0.0.1:5004/tuner0/ch0", filename,
+                                                           err, sizeof(err));
+    if (!session) {
+        fprintf(stderr, "capbench: %s\n", err);
+        shutdown(listen_sock, SHUT_RDWR);
+        pthread_join(thread, NULL);
+        return false;
+    }
+    if (!splice_path) capture_session_disable_splice(session);
+
+    double wall_start = now_s();
+    double cpu_start = cpu_s();
+    int result = 1;
+    while (result > 0) {
+        struct pollfd fds = { capture_session_fd(session), POLLIN, 0 };
+        int ready = poll(&fds, 1, BENCH_POLL_MS);
+        if (ready < 0 && errno != EINTR) break;
+        if (ready > 0) result = capture_session_pump(session);
+    }
+    double cpu = cpu_s() - cpu_start;
+    double wall = now_s() - wall_start;
+    uint64_t captured = capture_session_bytes(session);
+    const char *method = capture_session_method(session);
+    capture_session_close(session);
+    pthread_join(thread, NULL);
+
+    double mbits = captured * 8 / 1e6;
+    printf("  %-12s %8.1f MB  %6.2f s  %8.0f Mbps  CPU %6.3f s  %7.2f us/Mbit  %5.2f%% core per 100 Mbps\n",
+           method, captured / 1e6, wall, wall > 0 ? mbits / wall : 0.0, cpu,
+           mbits > 0 ? cpu * 1e6 / mbits : 0.0, mbits > 0 ? cpu * 100.0 * 100.0 / mbits : 0.0);
+    return result == 0 && captured == bytes;
+}
+
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [-m megabytes] [-n runs] [-o file]\n", program_name);
+    printf("  -m <n>   Megabytes captured per run (default 1024)\n");
+    printf("  -n <n>   Runs of each path (default 3)\n");
+    printf("  -o <f>   Capture file, removed afterwards (default capbench.tmp)\n");
+}
+
+int main(int argc, char **argv) {
+    int megabytes = 1024;
+    int runs = 3;
+    const char *filename = "capbench.tmp";
+    int opt;
+    while ((opt = getopt(argc, argv, "m:n:o:h")) != -1) {
+        switch (opt) {
+            case 'm': megabytes = atoi(optarg); if (megabytes < 1) megabytes = 1; break;
+            case 'n': runs = atoi(optarg); if (runs < 1) runs = 1; break;
+            case 'o': filename = optarg; break;
+            default: print_usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    int listen_sock = open_listener();
+    if (listen_sock < 0) {
+        fprintf(stderr, "capbench: can't listen on 127.0.0.1:%d: %s\n", BENCH_PORT, strerror(errno));
+        return 1;
+    }
+
+    uint64_t bytes = (uint64_t)megabytes * 1000000ULL;
+    printf("capbench: %d x %d MB over loopback into %s\n", runs, megabytes, filename);
+    bool ok = true;
+    for (int r = 0; r < runs && ok; r++) {
+        ok = run_capture(listen_sock, bytes, false, filename) && run_capture(listen_sock, bytes, true, filename);
+    }
+    close(listen_sock);
+    remove(filename);
+    if (!ok) fprintf(stderr, "capbench: a capture did not complete\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,499 @@
+/*
+ * capture_engine.c
+ *
+ * HTTP stream capture sessions and a parallel multi-tuner capture engine
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE // splice()
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "hdhomerun.h"
+#include "hdhomerun_device.h"
+#include "capture_engine.h"
+#include "status_fields.h"
+#include "pretrigger_buffer.h"
+
+#define CAPTURE_DRAIN_BURST 64
+#define CAPTURE_POLL_MS 250
+#define CAPTURE_COUNTER_INTERVAL_MS 1000
+
+#ifdef __linux__
+#define SPLICE_CHUNK (1024 * 1024)
+#endif
+
+struct capture_session {
+    int sock;
+    FILE *f;
+    bool owns_file;
+    bool headers_processed;
+    bool use_splice;
+    int splice_pipe[2];
+    struct pretrigger_buffer *tap;  // Optional copy of everything written
+    uint64_t bytes;
+    bool cut_pending;               // Stop writing at cut_at until the output is swapped
+    uint64_t cut_at;
+    char buffer[65536];
+};
+
+static void set_err(char *err, size_t err_size, const char *msg) {
+    if (err && err_size > 0) snprintf(err, err_size, "%s", msg);
+}
+
+/*
+ * open_session
+ * Shared by both open variants: writes to out if given, else opens filename.
+ */
+static struct capture_session* open_session(const char *ip_addr, const char *url, const char *filename, FILE *out,
+                                            char *err, size_t err_size) {
+    // 1. Create and connect socket
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+        set_err(err, err_size, "Could not create socket.");
+        return NULL;
+    }
+    int rcvbuf_size = 2 * 1024 * 1024;
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf_size, sizeof(rcvbuf_size));
+
+    struct sockaddr_in serv_addr;
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_port = htons(5004);
+    if (inet_pton(AF_INET, ip_addr, &serv_addr.sin_addr) <= 0) {
+        set_err(err, err_size, "Invalid IP address.");
+        close(sock);
+        return NULL;
+    }
+
+    if (connect(sock, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
+        set_err(err, err_size, "Could not connect to device.");
+        close(sock);
+        return NULL;
+    }
+
+    // 2. Send HTTP GET request
+    const char *path_start = strstr(url, "/tuner");
+    if (!path_start) {
+        set_err(err, err_size, "Invalid URL for request.");
+        close(sock);
+        return NULL;
+    }
+    char request[512];
+    snprintf(request, sizeof(request), "GET %s HTTP/1.0\r\nHost: %s\r\nConnection: close\r\n\r\n", path_start, ip_addr);
+    if (send(sock, request, strlen(request), 0) < 0) {
+        set_err(err, err_size, "Failed to send request.");
+        close(sock);
+        return NULL;
+    }
+
+    // 3. Open output file
+    struct capture_session *session = calloc(1, sizeof(struct capture_session));
+    if (!session) {
+        set_err(err, err_size, "Out of memory.");
+        close(sock);
+        return NULL;
+    }
+    session->owns_file = (out == NULL);
+    session->f = out ? out : fopen(filename, "wb");
+    if (!session->f) {
+        set_err(err, err_size, "Failed to open file for writing.");
+        close(sock);
+        free(session);
+        return NULL;
+    }
+    session->sock = sock;
+    fcntl(sock, F_SETFL, O_NONBLOCK);
+
+    // Once the headers are stripped, Linux moves the body straight from the
+    // socket to the file with splice(); elsewhere it stays on recv/fwrite
+    session->splice_pipe[0] = session->splice_pipe[1] = -1;
+#ifdef __linux__
+    if (pipe(session->splice_pipe) == 0) {
+        fcntl(session->splice_pipe[1], F_SETPIPE_SZ, SPLICE_CHUNK);
+        session->use_splice = true;
+    }
+#endif
+    return session;
+}
+
+struct capture_session* capture_session_open(const char *ip_addr, const char *url, const char *filename,
+                                             char *err, size_t err_size) {
+    return open_session(ip_addr, url, filename, NULL, err, err_size);
+}
+
+struct capture_session* capture_session_open_to(const char *ip_addr, const char *url, FILE *out,
+                                                char *err, size_t err_size) {
+    if (!out) {
+        set_err(err, err_size, "No output file.");
+        return NULL;
+    }
+    return open_session(ip_addr, url, NULL, out, err, err_size);
+}
+
+void capture_session_set_output(struct capture_session *session, FILE *out) {
+    if (!session || !out) return;
+    session->f = out;
+    session->cut_pending = false;
+}
+
+void capture_session_request_cut(struct capture_session *session, int align) {
+    if (!session || session->cut_pending) return;
+    if (align < 1) align = 1;
+    session->cut_at = (session->bytes + align - 1) / align * align;
+    session->cut_pending = true;
+}
+
+bool capture_session_cut_ready(struct capture_session *session) {
+    return session && session->cut_pending && session->bytes >= session->cut_at;
+}
+
+/*
+ * write_room
+ * How much the next read may write: up to max, but never past a pending cut.
+ */
+static size_t write_room(struct capture_session *session, size_t max) {
+    if (!session->cut_pending || !session->headers_processed) return max;
+    if (session->bytes >= session->cut_at) return 0;
+    uint64_t room = session->cut_at - session->bytes;
+    return room < max ? (size_t)room : max;
+}
+
+void capture_session_disable_splice(struct capture_session *session) {
+    if (session) session->use_splice = false;
+}
+
+void capture_session_set_tap(struct capture_session *session, struct pretrigger_buffer *tap) {
+    if (!session) return;
+    session->tap = tap;
+    if (tap) session->use_splice = false; // The tap needs the data in user space
+}
+
+void capture_session_close(struct capture_session *session) {
+    if (!session) return;
+    if (session->splice_pipe[0] >= 0) {
+        close(session->splice_pipe[0]);
+        close(session->splice_pipe[1]);
+    }
+    if (session->owns_file) fclose(session->f);
+    close(session->sock);
+    free(session);
+}
+
+int capture_session_fd(struct capture_session *session) {
+    return session ? session->sock : -1;
+}
+
+uint64_t capture_session_bytes(struct capture_session *session) {
+    return session ? session->bytes : 0;
+}
+
+const char* capture_session_method(struct capture_session *session) {
+    return (session && session->use_splice) ? "splice" : "recv/fwrite";
+}
+
+#ifdef __linux__
+/*
+ * splice_socket_to_file
+ * Moves whatever is queued on the socket into out_fd through a pipe, so the
+ * stream never passes through a user-space buffer.
+ * Returns bytes written, 0 when the peer closed, -1 with errno on error.
+ * EINVAL/ENOSYS mean splice is unsupported and nothing was consumed.
+ */
+static ssize_t splice_socket_to_file(int sock, int pipe_fds[2], int out_fd, size_t max_len) {
+    ssize_t moved_in = splice(sock, NULL, pipe_fds[1], NULL, max_len, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (moved_in <= 0) return moved_in;
+
+    ssize_t left = moved_in;
+    while (left > 0) {
+        ssize_t moved_out = splice(pipe_fds[0], NULL, out_fd, NULL, left, SPLICE_F_MOVE);
+        if (moved_out < 0 && errno == EINTR) continue;
+        if (moved_out <= 0) {
+            errno = EIO; // Data already left the socket; don't report it as a fallback case
+            return -1;
+        }
+        left -= moved_out;
+    }
+    return moved_in;
+}
+#endif
+
+int capture_session_pump(struct capture_session *session) {
+    // Drain what is queued, bounded so a saturated socket can't starve the caller
+    for (int burst = 0; burst < CAPTURE_DRAIN_BURST; burst++) {
+        if (capture_session_cut_ready(session)) return 1; // Rest stays queued for the next output
+#ifdef __linux__
+        if (session->use_splice && session->headers_processed) {
+            ssize_t moved = splice_socket_to_file(session->sock, session->splice_pipe, fileno(session->f),
+                                                  write_room(session, SPLICE_CHUNK));
+            if (moved > 0) {
+                session->bytes += moved;
+                continue;
+            } else if (moved == 0) {
+                return 0; // Connection closed by server, successful completion
+            } else if (errno == EINVAL || errno == ENOSYS) {
+                session->use_splice = false;
+            } else {
+                return (errno == EWOULDBLOCK || errno == EAGAIN) ? 1 : -1;
+            }
+        }
+#endif
+
+        int bytes_read = recv(session->sock, session->buffer, write_room(session, sizeof(session->buffer) - 1), 0);
+        if (bytes_read > 0) {
+            char *data_to_write = session->buffer;
+            int len_to_write = bytes_read;
+            if (!session->headers_processed) {
+                session->buffer[bytes_read] = '\0';
+                char *body_start = strstr(session->buffer, "\r\n\r\n");
+                if (body_start) {
+                    body_start += 4; // Move pointer past the CRLFCRLF
+                    len_to_write = bytes_read - (body_start - session->buffer);
+                    data_to_write = body_start;
+                    session->headers_processed = true;
+                } else {
+                    // Headers not fully received in this chunk, so write nothing yet
+                    len_to_write = 0;
+                }
+            }
+            if (len_to_write > 0) {
+                fwrite(data_to_write, 1, len_to_write, session->f);
+                session->bytes += len_to_write;
+                if (session->tap) pretrigger_buffer_append(session->tap, data_to_write, len_to_write);
+            }
+            // Splice writes go to the fd directly, so drain stdio's buffer first
+            if (session->use_splice && session->headers_processed) fflush(session->f);
+        } else if (bytes_read == 0) {
+            return 0; // Connection closed by server, successful completion
+        } else {
+            // EAGAIN means the socket is drained; anything else is a real error
+            return (errno == EWOULDBLOCK || errno == EAGAIN) ? 1 : -1;
+        }
+    }
+    return 1;
+}
+
+// --- Parallel capture engine ---
+
+struct capture_worker {
+    struct capture_engine *engine;
+    pthread_t thread;
+    bool started;
+    struct capture_job job;
+    struct capture_progress progress;  // Guarded by engine->lock
+};
+
+struct capture_engine {
+    pthread_mutex_t lock;
+    bool cancel;
+    int count;
+    struct capture_worker workers[CAPTURE_ENGINE_MAX_JOBS];
+};
+
+static long elapsed_since_ms(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
+/*
+ * read_error_counters
+ * Reads the tuner's cumulative te/ne/se counters from /tunerN/debug.
+ */
+static bool read_error_counters(struct hdhomerun_device_t *hd, int tuner_index, long counters[3]) {
+    char debug_path[64];
+    char *debug_str;
+    snprintf(debug_path, sizeof(debug_path), "/tuner%d/debug", tuner_index);
+    if (!hd || hdhomerun_device_get_var(hd, debug_path, &debug_str, NULL) <= 0) return false;
+
+    struct status_fields fields;
+    status_fields_init(&fields);
+    status_fields_parse(&fields, debug_str);
+    counters[0] = fields.value[STATUS_KEY_TE];
+    counters[1] = fields.value[STATUS_KEY_NE];
+    counters[2] = fields.value[STATUS_KEY_SE];
+    return counters[0] != -999 && counters[1] != -999 && counters[2] != -999;
+}
+
+static void set_state(struct capture_worker *worker, enum capture_job_state state, const char *message) {
+    pthread_mutex_lock(&worker->engine->lock);
+    worker->progress.state = state;
+    if (message) snprintf(worker->progress.message, sizeof(worker->progress.message), "%s", message);
+    pthread_mutex_unlock(&worker->engine->lock);
+}
+
+static void* capture_worker_thread(void *arg) {
+    struct capture_worker *worker = (struct capture_worker *)arg;
+    struct capture_engine *engine = worker->engine;
+    const struct capture_job *job = &worker->job;
+
+    // Each worker gets its own control connection for the error counters
+    struct hdhomerun_device_t *hd = hdhomerun_device_create_from_str(job->ip_str, NULL);
+    if (hd) hdhomerun_device_set_tuner(hd, job->tuner_index);
+    long start_counters[3] = {0, 0, 0};
+    bool have_counters = read_error_counters(hd, job->tuner_index, start_counters);
+
+    char err[128];
+    struct capture_session *session = capture_session_open(job->ip_str, job->url, job->filename, err, sizeof(err));
+    if (!session) {
+        set_state(worker, CAPTURE_JOB_FAILED, err);
+        if (hd) hdhomerun_device_destroy(hd);
+        return NULL;
+    }
+    set_state(worker, CAPTURE_JOB_RUNNING, NULL);
+
+    struct timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    long next_counter_ms = CAPTURE_COUNTER_INTERVAL_MS;
+    enum capture_job_state final_state = CAPTURE_JOB_DONE;
+    const char *final_message = NULL;
+
+    for (;;) {
+        long elapsed_ms = elapsed_since_ms(&start_time);
+        if (elapsed_ms >= job->duration_ms) break;
+
+        pthread_mutex_lock(&engine->lock);
+        bool cancelled = engine->cancel;
+        pthread_mutex_unlock(&engine->lock);
+        if (cancelled) {
+            final_state = CAPTURE_JOB_CANCELLED;
+            break;
+        }
+
+        long wait_ms = job->duration_ms - elapsed_ms;
+        if (wait_ms > CAPTURE_POLL_MS) wait_ms = CAPTURE_POLL_MS;
+        struct pollfd pfd = { capture_session_fd(session), POLLIN, 0 };
+        int ready = poll(&pfd, 1, (int)wait_ms);
+        if (ready < 0 && errno != EINTR) {
+            final_state = CAPTURE_JOB_FAILED;
+            final_message = "poll() failed.";
+            break;
+        }
+
+        int pump_result = 1;
+        if (ready > 0) pump_result = capture_session_pump(session);
+
+        long counters[3];
+        bool counters_updated = false;
+        if (have_counters && elapsed_ms >= next_counter_ms) {
+            next_counter_ms = elapsed_ms + CAPTURE_COUNTER_INTERVAL_MS;
+            counters_updated = read_error_counters(hd, job->tuner_index, counters);
+        }
+
+        pthread_mutex_lock(&engine->lock);
+        worker->progress.bytes = capture_session_bytes(session);
+        worker->progress.elapsed_ms = elapsed_since_ms(&start_time);
+        if (counters_updated) {
+            worker->progress.te = counters[0] - start_counters[0];
+            worker->progress.ne = counters[1] - start_counters[1];
+            worker->progress.se = counters[2] - start_counters[2];
+        }
+        pthread_mutex_unlock(&engine->lock);
+
+        if (pump_result == 0) break; // Device ended the stream
+        if (pump_result < 0) {
+            final_state = CAPTURE_JOB_FAILED;
+            final_message = "Connection error.";
+            break;
+        }
+    }
+
+    capture_session_close(session);
+
+    // The HTTP request retuned the tuner; put it back where it was
+    if (hd && job->restore_channel[0]) {
+        hdhomerun_device_set_tuner_channel(hd, job->restore_channel);
+    }
+    if (hd) hdhomerun_device_destroy(hd);
+
+    set_state(worker, final_state, final_message);
+    return NULL;
+}
+
+struct capture_engine* capture_engine_start(const struct capture_job jobs[], int count) {
+    if (count > CAPTURE_ENGINE_MAX_JOBS) count = CAPTURE_ENGINE_MAX_JOBS;
+
+    struct capture_engine *engine = calloc(1, sizeof(struct capture_engine));
+    if (!engine) return NULL;
+    pthread_mutex_init(&engine->lock, NULL);
+    engine->count = count;
+
+    for (int i = 0; i < count; i++) {
+        struct capture_worker *worker = &engine->workers[i];
+        worker->engine = engine;
+        worker->job = jobs[i];
+        worker->progress.state = CAPTURE_JOB_PENDING;
+        if (pthread_create(&worker->thread, NULL, capture_worker_thread, worker) == 0) {
+            worker->started = true;
+        } else {
+            worker->progress.state = CAPTURE_JOB_FAILED;
+            snprintf(worker->progress.message, sizeof(worker->progress.message), "Could not start worker thread.");
+        }
+    }
+    return engine;
+}
+
+void capture_engine_cancel(struct capture_engine *engine) {
+    if (!engine) return;
+    pthread_mutex_lock(&engine->lock);
+    engine->cancel = true;
+    pthread_mutex_unlock(&engine->lock);
+}
+
+void capture_engine_destroy(struct capture_engine *engine) {
+    if (!engine) return;
+    for (int i = 0; i < engine->count; i++) {
+        if (engine->workers[i].started) pthread_join(engine->workers[i].thread, NULL);
+    }
+    pthread_mutex_destroy(&engine->lock);
+    free(engine);
+}
+
+int capture_engine_job_count(struct capture_engine *engine) {
+    return engine ? engine->count : 0;
+}
+
+const struct capture_job* capture_engine_get_job(struct capture_engine *engine, int index) {
+    if (!engine || index < 0 || index >= engine->count) return NULL;
+    return &engine->workers[index].job;
+}
+
+void capture_engine_get_progress(struct capture_engine *engine, int index, struct capture_progress *out) {
+    memset(out, 0, sizeof(*out));
+    if (!engine || index < 0 || index >= engine->count) return;
+
+    pthread_mutex_lock(&engine->lock);
+    *out = engine->workers[index].progress;
+    pthread_mutex_unlock(&engine->lock);
+}
+
+bool capture_engine_active(struct capture_engine *engine) {
+    if (!engine) return false;
+
+    bool active = false;
+    pthread_mutex_lock(&engine->lock);
+    for (int i = 0; i < engine->count && !active; i++) {
+        enum capture_job_state state = engine->workers[i].progress.state;
+        active = (state == CAPTURE_JOB_PENDING || state == CAPTURE_JOB_RUNNING);
+    }
+    pthread_mutex_unlock(&engine->lock);
+    return active;
+}
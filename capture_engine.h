@@ -0,0 +1,114 @@
+/*
+ * capture_engine.h
+ *
+ * HTTP stream capture sessions and a parallel multi-tuner capture engine
+ * A session owns the socket and output file for one /tunerN/ download; the
+ * engine runs many sessions at once, one worker thread each, and exposes
+ * their progress for a single combined view.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef CAPTURE_ENGINE_H
+#define CAPTURE_ENGINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define CAPTURE_ENGINE_MAX_JOBS 64
+
+// --- Single capture session ---
+
+struct capture_session;
+
+// Connects to ip_addr:5004, requests the /tunerN/... path from url and opens
+// filename for writing. On failure returns NULL with a message in err.
+struct capture_session* capture_session_open(const char *ip_addr, const char *url, const char *filename,
+                                             char *err, size_t err_size);
+void capture_session_close(struct capture_session *session);
+
+// Same, but writes to a caller-owned file (e.g. a capture_ring segment),
+// which can be swapped between pumps with capture_session_set_output.
+struct capture_session* capture_session_open_to(const char *ip_addr, const char *url, FILE *out,
+                                                char *err, size_t err_size);
+void capture_session_set_output(struct capture_session *session, FILE *out);
+
+// Asks the session to stop writing at the next multiple of align bytes, so
+// an output can be swapped on a packet boundary (188 for TS). Once
+// capture_session_cut_ready is true, pumps leave data queued on the socket
+// until capture_session_set_output is called.
+void capture_session_request_cut(struct capture_session *session, int align);
+bool capture_session_cut_ready(struct capture_session *session);
+
+// Keeps the session on recv/fwrite even where splice is available, e.g. to
+// compare the two paths.
+void capture_session_disable_splice(struct capture_session *session);
+
+// Also copies the stream into a pre-trigger buffer. Disables the splice path.
+struct pretrigger_buffer;
+void capture_session_set_tap(struct capture_session *session, struct pretrigger_buffer *tap);
+
+// Socket to poll() for POLLIN before calling capture_session_pump.
+int capture_session_fd(struct capture_session *session);
+
+// Moves everything queued on the socket to the file, in bounded bursts.
+// Returns 1 while the stream is open, 0 when the device closed it, -1 on error.
+int capture_session_pump(struct capture_session *session);
+
+uint64_t capture_session_bytes(struct capture_session *session);
+const char* capture_session_method(struct capture_session *session);
+
+// --- Parallel capture engine ---
+
+enum capture_job_state {
+    CAPTURE_JOB_PENDING,
+    CAPTURE_JOB_RUNNING,
+    CAPTURE_JOB_DONE,
+    CAPTURE_JOB_FAILED,
+    CAPTURE_JOB_CANCELLED,
+};
+
+struct capture_job {
+    uint32_t device_id;
+    int tuner_index;
+    char ip_str[64];
+    char url[256];
+    char filename[256];
+    char restore_channel[128];  // Retuned to after the capture when non-empty
+    int duration_ms;
+};
+
+struct capture_progress {
+    enum capture_job_state state;
+    uint64_t bytes;
+    long elapsed_ms;
+    long te, ne, se;            // Transport/network/sequence errors since start
+    char message[128];          // Failure reason, if any
+};
+
+struct capture_engine;
+
+// Starts one worker thread per job. Jobs are copied.
+struct capture_engine* capture_engine_start(const struct capture_job jobs[], int count);
+
+// Stops all sessions early; files keep what was written so far.
+void capture_engine_cancel(struct capture_engine *engine);
+
+// Joins the workers and frees the engine.
+void capture_engine_destroy(struct capture_engine *engine);
+
+int capture_engine_job_count(struct capture_engine *engine);
+const struct capture_job* capture_engine_get_job(struct capture_engine *engine, int index);
+void capture_engine_get_progress(struct capture_engine *engine, int index, struct capture_progress *out);
+
+// True while any job is pending or running.
+bool capture_engine_active(struct capture_engine *engine);
+
+#endif // CAPTURE_ENGINE_H
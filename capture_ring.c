@@ -0,0 +1,121 @@
+/*
+ * capture_ring.c
+ *
+ * Fixed-size on-disk ring of capture segment files
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "capture_ring.h"
+
+struct capture_ring {
+    char base[256];
+    char ext[16];
+    int segment_count;
+    int segment_ms;
+
+    FILE *f;
+    long seq;                              // Sequence number of the current segment
+    bool present[CAPTURE_RING_MAX_SEGMENTS];  // Slot holds a completed segment
+    struct timespec segment_start;
+    int events;
+};
+
+static void slot_filename(struct capture_ring *ring, int slot, char *out, size_t out_size) {
+    snprintf(out, out_size, "%s.ring%02d%s", ring->base, slot, ring->ext);
+}
+
+static bool open_segment(struct capture_ring *ring) {
+    char filename[300];
+    int slot = (int)(ring->seq % ring->segment_count);
+    slot_filename(ring, slot, filename, sizeof(filename));
+
+    ring->present[slot] = false;
+    ring->f = fopen(filename, "wb");
+    clock_gettime(CLOCK_MONOTONIC, &ring->segment_start);
+    return ring->f != NULL;
+}
+
+struct capture_ring* capture_ring_open(const char *base, const char *ext, int segment_count, int segment_ms) {
+    struct capture_ring *ring = calloc(1, sizeof(struct capture_ring));
+    if (!ring) return NULL;
+
+    strncpy(ring->base, base, sizeof(ring->base) - 1);
+    strncpy(ring->ext, ext ? ext : "", sizeof(ring->ext) - 1);
+    if (segment_count < 2) segment_count = 2;
+    if (segment_count > CAPTURE_RING_MAX_SEGMENTS) segment_count = CAPTURE_RING_MAX_SEGMENTS;
+    ring->segment_count = segment_count;
+    ring->segment_ms = segment_ms > 0 ? segment_ms : 60000;
+
+    if (!open_segment(ring)) {
+        free(ring);
+        return NULL;
+    }
+    return ring;
+}
+
+void capture_ring_close(struct capture_ring *ring) {
+    if (!ring) return;
+    if (ring->f) fclose(ring->f);
+    free(ring);
+}
+
+FILE* capture_ring_file(struct capture_ring *ring) {
+    return ring ? ring->f : NULL;
+}
+
+bool capture_ring_rotate_due(struct capture_ring *ring) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long elapsed_ms = (now.tv_sec - ring->segment_start.tv_sec) * 1000 + (now.tv_nsec - ring->segment_start.tv_nsec) / 1000000;
+    return elapsed_ms >= ring->segment_ms;
+}
+
+FILE* capture_ring_rotate(struct capture_ring *ring) {
+    if (ring->f) {
+        fclose(ring->f);
+        ring->f = NULL;
+        ring->present[ring->seq % ring->segment_count] = true;
+    }
+    ring->seq++;
+    open_segment(ring);
+    return ring->f;
+}
+
+int capture_ring_freeze(struct capture_ring *ring, int keep) {
+    if (keep > ring->segment_count - 1) keep = ring->segment_count - 1;
+
+    // Completed segments are seq-1, seq-2, ...; walk back to the oldest kept
+    long first = ring->seq - keep;
+    if (first < 0) first = 0;
+
+    int saved = 0;
+    int event = ring->events + 1;
+    for (long s = first; s < ring->seq; s++) {
+        int slot = (int)(s % ring->segment_count);
+        if (!ring->present[slot]) continue;
+
+        char from[300], to[320];
+        slot_filename(ring, slot, from, sizeof(from));
+        snprintf(to, sizeof(to), "%s-event%03d-%02d%s", ring->base, event, saved + 1, ring->ext);
+        if (rename(from, to) == 0) {
+            ring->present[slot] = false;
+            saved++;
+        }
+    }
+    if (saved > 0) ring->events = event;
+    return saved;
+}
+
+int capture_ring_event_count(struct capture_ring *ring) {
+    return ring ? ring->events : 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * capture_ring.h
+ *
+ * Fixed-size on-disk ring of capture segment files
+ * Continuous captures rotate through N segment files so disk use stays
+ * bounded; when an error is seen, the most recent segments are renamed
+ * out of the ring so they survive.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef CAPTURE_RING_H
+#define CAPTURE_RING_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#define CAPTURE_RING_MAX_SEGMENTS 100
+
+struct capture_ring;
+
+// Segments are named "<base>.ringNN<ext>" and each covers segment_ms.
+// Opens the first segment; returns NULL if it can't be created.
+struct capture_ring* capture_ring_open(const char *base, const char *ext, int segment_count, int segment_ms);
+
+// Closes the current segment. Segments still in the ring are left on disk.
+void capture_ring_close(struct capture_ring *ring);
+
+// The segment currently being written.
+FILE* capture_ring_file(struct capture_ring *ring);
+
+// True once the current segment has run for segment_ms.
+bool capture_ring_rotate_due(struct capture_ring *ring);
+
+// Closes the current segment and opens the next slot, overwriting the
+// oldest one. Returns the new segment, or NULL on failure.
+FILE* capture_ring_rotate(struct capture_ring *ring);
+
+// Renames up to keep of the most recently completed segments (oldest first)
+// to "<base>-eventNNN-MM<ext>". Returns how many were saved; only a freeze
+// that saved something counts as an event.
+int capture_ring_freeze(struct capture_ring *ring, int keep);
+
+// Number of freeze events that saved segments so far.
+int capture_ring_event_count(struct capture_ring *ring);
+
+#endif // CAPTURE_RING_H
@@ -0,0 +1,132 @@
+/*
+ * counter_watch.c
+ *
+ * Background polling of a tuner's transport/network/sequence error counters
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "hdhomerun.h"
+#include "hdhomerun_device.h"
+#include "counter_watch.h"
+#include "status_fields.h"
+
+struct counter_watch {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool stop;
+
+    char ip_str[64];
+    int tuner_index;
+    int interval_ms;
+
+    uint64_t readings;          // Guarded by lock, as are the counters
+    long te, ne, se;
+};
+
+/*
+ * wait_interval
+ * Sleeps until the next poll is due, returning early on stop.
+ * Called with the watch lock held.
+ */
+static void wait_interval(struct counter_watch *watch) {
+    struct timeval now;
+    struct timespec deadline;
+    gettimeofday(&now, NULL);
+    long nsec = now.tv_usec * 1000L + (long)(watch->interval_ms % 1000) * 1000000L;
+    deadline.tv_sec = now.tv_sec + watch->interval_ms / 1000 + nsec / 1000000000L;
+    deadline.tv_nsec = nsec % 1000000000L;
+
+    while (!watch->stop) {
+        if (pthread_cond_timedwait(&watch->wake, &watch->lock, &deadline) != 0) break;
+    }
+}
+
+static void* counter_watch_thread(void *arg) {
+    struct counter_watch *watch = (struct counter_watch *)arg;
+    struct hdhomerun_device_t *hd = NULL;
+    char debug_path[64];
+    snprintf(debug_path, sizeof(debug_path), "/tuner%d/debug", watch->tuner_index);
+
+    pthread_mutex_lock(&watch->lock);
+    while (!watch->stop) {
+        pthread_mutex_unlock(&watch->lock);
+
+        if (!hd) hd = hdhomerun_device_create_from_str(watch->ip_str, NULL);
+        char *debug_str;
+        struct status_fields fields;
+        bool ok = hd && hdhomerun_device_get_var(hd, debug_path, &debug_str, NULL) > 0;
+        if (ok) {
+            status_fields_init(&fields);
+            status_fields_parse(&fields, debug_str);
+        }
+
+        pthread_mutex_lock(&watch->lock);
+        if (ok) {
+            watch->te = fields.value[STATUS_KEY_TE];
+            watch->ne = fields.value[STATUS_KEY_NE];
+            watch->se = fields.value[STATUS_KEY_SE];
+            watch->readings++;
+        }
+        wait_interval(watch);
+    }
+    pthread_mutex_unlock(&watch->lock);
+
+    if (hd) hdhomerun_device_destroy(hd);
+    return NULL;
+}
+
+struct counter_watch* counter_watch_start(const char *ip_str, int tuner_index, int interval_ms) {
+    struct counter_watch *watch = calloc(1, sizeof(struct counter_watch));
+    if (!watch) return NULL;
+
+    snprintf(watch->ip_str, sizeof(watch->ip_str), "%s", ip_str);
+    watch->tuner_index = tuner_index;
+    watch->interval_ms = interval_ms > 0 ? interval_ms : 1000;
+    pthread_mutex_init(&watch->lock, NULL);
+    pthread_cond_init(&watch->wake, NULL);
+
+    if (pthread_create(&watch->thread, NULL, counter_watch_thread, watch) != 0) {
+        pthread_cond_destroy(&watch->wake);
+        pthread_mutex_destroy(&watch->lock);
+        free(watch);
+        return NULL;
+    }
+    return watch;
+}
+
+void counter_watch_stop(struct counter_watch *watch) {
+    if (!watch) return;
+
+    pthread_mutex_lock(&watch->lock);
+    watch->stop = true;
+    pthread_cond_signal(&watch->wake);
+    pthread_mutex_unlock(&watch->lock);
+
+    pthread_join(watch->thread, NULL);
+    pthread_cond_destroy(&watch->wake);
+    pthread_mutex_destroy(&watch->lock);
+    free(watch);
+}
+
+uint64_t counter_watch_get(struct counter_watch *watch, long *te, long *ne, long *se) {
+    if (!watch) return 0;
+    pthread_mutex_lock(&watch->lock);
+    uint64_t readings = watch->readings;
+    *te = watch->te;
+    *ne = watch->ne;
+    *se = watch->se;
+    pthread_mutex_unlock(&watch->lock);
+    return readings;
+}
@@ -0,0 +1,34 @@
+/*
+ * counter_watch.h
+ *
+ * Background polling of a tuner's transport/network/sequence error counters
+ * Reads /tunerN/debug on its own control connection and thread, so a slow
+ * control reply never holds up a capture's receive loop.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef COUNTER_WATCH_H
+#define COUNTER_WATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+struct counter_watch;
+
+// Starts polling the tuner every interval_ms, beginning at once.
+struct counter_watch* counter_watch_start(const char *ip_str, int tuner_index, int interval_ms);
+
+// Stops the thread and frees the watch. Waits out a query in flight.
+void counter_watch_stop(struct counter_watch *watch);
+
+// Copies the latest te/ne/se readings without blocking on the device.
+// Returns the number of readings taken so far (0 if none yet).
+uint64_t counter_watch_get(struct counter_watch *watch, long *te, long *ne, long *se);
+
+#endif // COUNTER_WATCH_H
@@ -0,0 +1,64 @@
+/*
+ * device_inventory.c
+ *
+ * Last known list of HDHomeRun devices
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "device_inventory.h"
+
+#define DEVICE_INVENTORY_HEADER "# hdhomerun_tui devices v1"
+
+int device_inventory_load(const char *path, struct inventory_device devices[], int max_devices) {
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+
+    int count = 0;
+    char line[256];
+    while (count < max_devices && fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+
+        struct inventory_device dev;
+        memset(&dev, 0, sizeof(dev));
+        int legacy;
+        if (sscanf(line, "%" SCNx32 " %63s %d %d", &dev.device_id, dev.ip_str, &dev.tuner_count, &legacy) != 4) continue;
+        if (dev.tuner_count <= 0 || device_inventory_find(devices, count, dev.device_id) >= 0) continue;
+        dev.is_legacy = legacy != 0;
+        devices[count++] = dev;
+    }
+    fclose(f);
+    return count;
+}
+
+int device_inventory_save(const char *path, const struct inventory_device devices[], int count) {
+    char tmp_path[300];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *f = fopen(tmp_path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "%s\n", DEVICE_INVENTORY_HEADER);
+    fprintf(f, "# device ip tuners legacy\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(f, "%08" PRIX32 " %s %d %d\n", devices[i].device_id, devices[i].ip_str,
+                devices[i].tuner_count, devices[i].is_legacy ? 1 : 0);
+    }
+    if (fclose(f) != 0) { remove(tmp_path); return -1; }
+    return rename(tmp_path, path);
+}
+
+int device_inventory_find(const struct inventory_device devices[], int count, uint32_t device_id) {
+    for (int i = 0; i < count; i++) {
+        if (devices[i].device_id == device_id) return i;
+    }
+    return -1;
+}
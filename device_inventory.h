@@ -0,0 +1,41 @@
+/*
+ * device_inventory.h
+ *
+ * Last known list of HDHomeRun devices
+ * Saved after every discovery and loaded at startup, so the tuner list can
+ * be drawn straight away while live discovery runs in the background.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef DEVICE_INVENTORY_H
+#define DEVICE_INVENTORY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DEVICE_INVENTORY_DEFAULT_PATH "hdhomerun_tui.devices"
+#define DEVICE_INVENTORY_MAX_DEVICES 64
+
+struct inventory_device {
+    uint32_t device_id;
+    char ip_str[64];
+    int tuner_count;
+    bool is_legacy;
+};
+
+// Returns the number of devices read, 0 if the file is missing or empty.
+int device_inventory_load(const char *path, struct inventory_device devices[], int max_devices);
+
+// Replaces the file atomically. Returns 0 on success.
+int device_inventory_save(const char *path, const struct inventory_device devices[], int count);
+
+// Index of device_id in devices, or -1.
+int device_inventory_find(const struct inventory_device devices[], int count, uint32_t device_id);
+
+#endif // DEVICE_INVENTORY_H
@@ -0,0 +1,137 @@
+/*
+ * device_pool.c
+ *
+ * Pool of control connections, one per device
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "device_pool.h"
+
+struct pool_entry {
+    uint32_t device_id;
+    char ip_str[64];
+    struct hdhomerun_device_t *hd;  // NULL while closed or in backoff
+    long last_used_ms;
+    long retry_at_ms;               // No reconnect before this
+    int backoff_ms;                 // Next backoff; 0 after a good connect
+};
+
+struct device_pool {
+    int idle_ms;
+    int count;
+    struct pool_entry entries[DEVICE_POOL_MAX_DEVICES];
+};
+
+static long now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+static struct pool_entry* find_entry(struct device_pool *pool, uint32_t device_id) {
+    for (int i = 0; i < pool->count; i++) {
+        if (pool->entries[i].device_id == device_id) return &pool->entries[i];
+    }
+    return NULL;
+}
+
+static void close_entry(struct pool_entry *entry) {
+    if (entry->hd) hdhomerun_device_destroy(entry->hd);
+    entry->hd = NULL;
+}
+
+/*
+ * start_backoff
+ * Holds off reconnecting, doubling the wait after each failure in a row.
+ */
+static void start_backoff(struct pool_entry *entry, long now) {
+    if (entry->backoff_ms < DEVICE_POOL_BACKOFF_MIN_MS) entry->backoff_ms = DEVICE_POOL_BACKOFF_MIN_MS;
+    entry->retry_at_ms = now + entry->backoff_ms;
+    entry->backoff_ms *= 2;
+    if (entry->backoff_ms > DEVICE_POOL_BACKOFF_MAX_MS) entry->backoff_ms = DEVICE_POOL_BACKOFF_MAX_MS;
+}
+
+struct device_pool* device_pool_create(int idle_ms) {
+    struct device_pool *pool = calloc(1, sizeof(struct device_pool));
+    if (!pool) return NULL;
+    pool->idle_ms = idle_ms;
+    return pool;
+}
+
+void device_pool_destroy(struct device_pool *pool) {
+    if (!pool) return;
+    for (int i = 0; i < pool->count; i++) close_entry(&pool->entries[i]);
+    free(pool);
+}
+
+struct hdhomerun_device_t* device_pool_get(struct device_pool *pool, uint32_t device_id, const char *ip_str) {
+    if (!pool) return NULL;
+    long now = now_ms();
+
+    struct pool_entry *entry = find_entry(pool, device_id);
+    if (entry && strcmp(entry->ip_str, ip_str) != 0) {
+        // Same device at a new address: start over
+        close_entry(entry);
+        snprintf(entry->ip_str, sizeof(entry->ip_str), "%s", ip_str);
+        entry->retry_at_ms = 0;
+        entry->backoff_ms = 0;
+    }
+    if (!entry) {
+        if (pool->count >= DEVICE_POOL_MAX_DEVICES) return NULL;
+        entry = &pool->entries[pool->count++];
+        memset(entry, 0, sizeof(*entry));
+        entry->device_id = device_id;
+        snprintf(entry->ip_str, sizeof(entry->ip_str), "%s", ip_str);
+    }
+    entry->last_used_ms = now;
+
+    if (entry->hd) return entry->hd;
+    if (now < entry->retry_at_ms) return NULL;
+
+    // Use the IP address so devices outside the broadcast domain work too
+    entry->hd = hdhomerun_device_create_from_str(entry->ip_str, NULL);
+    if (entry->hd && hdhomerun_device_get_device_id(entry->hd) == 0) {
+        close_entry(entry);
+    }
+    if (!entry->hd) {
+        start_backoff(entry, now_ms());
+        return NULL;
+    }
+    entry->backoff_ms = 0;
+    return entry->hd;
+}
+
+void device_pool_report_failure(struct device_pool *pool, uint32_t device_id) {
+    if (!pool) return;
+    struct pool_entry *entry = find_entry(pool, device_id);
+    if (!entry) return;
+    close_entry(entry);
+    start_backoff(entry, now_ms());
+}
+
+void device_pool_expire(struct device_pool *pool) {
+    if (!pool) return;
+    long now = now_ms();
+    for (int i = 0; i < pool->count; i++) {
+        struct pool_entry *entry = &pool->entries[i];
+        if (entry->hd && now - entry->last_used_ms > pool->idle_ms) close_entry(entry);
+    }
+}
+
+void device_pool_remove(struct device_pool *pool, uint32_t device_id) {
+    if (!pool) return;
+    struct pool_entry *entry = find_entry(pool, device_id);
+    if (!entry) return;
+    close_entry(entry);
+    *entry = pool->entries[--pool->count];
+}
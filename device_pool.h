@@ -0,0 +1,56 @@
+/*
+ * device_pool.h
+ *
+ * Pool of control connections, one per device
+ * Lets the UI move between tuners on different devices without tearing
+ * down and re-opening a control connection each time. Handles that go
+ * unused are closed after an idle period, and a device that stops
+ * answering is reconnected with exponential backoff.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef DEVICE_POOL_H
+#define DEVICE_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hdhomerun.h"
+#include "hdhomerun_device.h"
+
+#define DEVICE_POOL_MAX_DEVICES 64
+#define DEVICE_POOL_DEFAULT_IDLE_MS (5 * 60 * 1000)
+#define DEVICE_POOL_BACKOFF_MIN_MS 500
+#define DEVICE_POOL_BACKOFF_MAX_MS 30000
+
+// Not thread-safe, and neither are the handles; the UI thread owns both.
+// Worker threads (pollers, captures, scans) keep their own connections.
+struct device_pool;
+
+struct device_pool* device_pool_create(int idle_ms);
+void device_pool_destroy(struct device_pool *pool);
+
+// Returns the handle for a device, connecting on first use. A new handle is
+// checked with one request before it is handed out. Returns NULL while the
+// device is in backoff after a failure. The handle stays valid until the
+// next call to device_pool_expire, device_pool_report_failure,
+// device_pool_remove or device_pool_destroy.
+struct hdhomerun_device_t* device_pool_get(struct device_pool *pool, uint32_t device_id, const char *ip_str);
+
+// A request on the device's handle failed to get an answer. Closes the
+// handle and holds off reconnecting for the current backoff, which doubles
+// on each failure up to DEVICE_POOL_BACKOFF_MAX_MS.
+void device_pool_report_failure(struct device_pool *pool, uint32_t device_id);
+
+// Closes handles not handed out for longer than the idle period.
+void device_pool_expire(struct device_pool *pool);
+
+// Forgets a device, e.g. when it has gone or moved to another address.
+void device_pool_remove(struct device_pool *pool, uint32_t device_id);
+
+#endif // DEVICE_POOL_H
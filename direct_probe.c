@@ -0,0 +1,153 @@
+/*
+ * direct_probe.c
+ *
+ * Unicast probing of HDHomeRun devices that broadcast discovery can't reach
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include "hdhomerun.h"
+#include "hdhomerun_device.h"
+#include "direct_probe.h"
+
+// One tuner status query, on its own control connection
+struct tuner_query {
+    pthread_t thread;
+    bool started;
+    const char *ip_str;
+    int tuner_index;
+    bool ok;
+};
+
+struct target_job {
+    pthread_t thread;
+    bool started;
+    const char *target;
+    struct direct_probe_result *result;
+};
+
+static void* tuner_query_thread(void *arg) {
+    struct tuner_query *query = (struct tuner_query *)arg;
+    struct hdhomerun_device_t *hd = hdhomerun_device_create_from_str(query->ip_str, NULL);
+    if (!hd) return NULL;
+
+    char *status_str;
+    struct hdhomerun_tuner_status_t status;
+    hdhomerun_device_set_tuner(hd, query->tuner_index);
+    query->ok = hdhomerun_device_get_tuner_status(hd, &status_str, &status) > 0;
+    hdhomerun_device_destroy(hd);
+    return NULL;
+}
+
+/*
+ * run_tuner_queries
+ * Queries the given tuner slots all at once, so a device with no such
+ * tuner costs one control timeout instead of one per slot.
+ */
+static void run_tuner_queries(const char *ip_str, struct tuner_query queries[], int count) {
+    for (int i = 0; i < count; i++) {
+        queries[i].ip_str = ip_str;
+        queries[i].ok = false;
+        queries[i].started = pthread_create(&queries[i].thread, NULL, tuner_query_thread, &queries[i]) == 0;
+        if (!queries[i].started) tuner_query_thread(&queries[i]);
+    }
+    for (int i = 0; i < count; i++) {
+        if (queries[i].started) pthread_join(queries[i].thread, NULL);
+    }
+}
+
+int direct_probe_model_tuner_count(const char *hwmodel) {
+    // The tuner count is the leading digit of the part after the dash,
+    // e.g. HDHR5-4DT, HDTC-2US, HDHR3-6CC-3X2
+    const char *dash = strchr(hwmodel, '-');
+    if (!dash || !isdigit((unsigned char)dash[1])) return 0;
+    int count = atoi(dash + 1);
+    return (count >= 1 && count <= DIRECT_PROBE_MAX_TUNERS) ? count : 0;
+}
+
+/*
+ * resolve_tuner_count
+ * Trusts the model's tuner count if tuner N-1 answers and tuner N doesn't;
+ * otherwise queries every slot and counts the ones that answer from 0.
+ */
+static void resolve_tuner_count(struct direct_probe_result *result) {
+    struct tuner_query queries[DIRECT_PROBE_MAX_TUNERS];
+    memset(queries, 0, sizeof(queries));
+
+    int model_count = direct_probe_model_tuner_count(result->hwmodel);
+    if (model_count > 0) {
+        int n = 0;
+        queries[n++].tuner_index = model_count - 1;
+        if (model_count < DIRECT_PROBE_MAX_TUNERS) queries[n++].tuner_index = model_count;
+        run_tuner_queries(result->ip_str, queries, n);
+        result->tuner_queries += n;
+        if (queries[0].ok && (n == 1 || !queries[1].ok)) {
+            result->tuner_count = model_count;
+            result->count_from_model = true;
+            return;
+        }
+        memset(queries, 0, sizeof(queries));
+    }
+
+    for (int i = 0; i < DIRECT_PROBE_MAX_TUNERS; i++) queries[i].tuner_index = i;
+    run_tuner_queries(result->ip_str, queries, DIRECT_PROBE_MAX_TUNERS);
+    result->tuner_queries += DIRECT_PROBE_MAX_TUNERS;
+
+    result->tuner_count = 0;
+    while (result->tuner_count < DIRECT_PROBE_MAX_TUNERS && queries[result->tuner_count].ok) result->tuner_count++;
+}
+
+static void* target_job_thread(void *arg) {
+    struct target_job *job = (struct target_job *)arg;
+    struct direct_probe_result *result = job->result;
+
+    struct hdhomerun_device_t *hd = hdhomerun_device_create_from_str(job->target, NULL);
+    if (!hd) return NULL;
+
+    result->device_id = hdhomerun_device_get_device_id(hd);
+    if (result->device_id == 0) {
+        hdhomerun_device_destroy(hd);
+        return NULL;
+    }
+
+    struct in_addr addr;
+    addr.s_addr = htonl(hdhomerun_device_get_device_ip(hd));
+    inet_ntop(AF_INET, &addr, result->ip_str, sizeof(result->ip_str));
+
+    char *hwmodel;
+    if (hdhomerun_device_get_var(hd, "/sys/hwmodel", &hwmodel, NULL) > 0) {
+        snprintf(result->hwmodel, sizeof(result->hwmodel), "%s", hwmodel);
+    }
+    hdhomerun_device_destroy(hd);
+
+    resolve_tuner_count(result);
+    result->found = result->tuner_count > 0;
+    return NULL;
+}
+
+void direct_probe_targets(const char *const targets[], int count, struct direct_probe_result results[]) {
+    if (count > DIRECT_PROBE_MAX_TARGETS) count = DIRECT_PROBE_MAX_TARGETS;
+
+    struct target_job jobs[DIRECT_PROBE_MAX_TARGETS];
+    for (int i = 0; i < count; i++) {
+        memset(&results[i], 0, sizeof(results[i]));
+        jobs[i].target = targets[i];
+        jobs[i].result = &results[i];
+        jobs[i].started = pthread_create(&jobs[i].thread, NULL, target_job_thread, &jobs[i]) == 0;
+        if (!jobs[i].started) target_job_thread(&jobs[i]);
+    }
+    for (int i = 0; i < count; i++) {
+        if (jobs[i].started) pthread_join(jobs[i].thread, NULL);
+    }
+}
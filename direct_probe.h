@@ -0,0 +1,42 @@
+/*
+ * direct_probe.h
+ *
+ * Unicast probing of HDHomeRun devices that broadcast discovery can't reach
+ * Every target is probed on its own thread. The tuner count comes from the
+ * model name in /sys/hwmodel where it can be, confirmed by two tuner
+ * queries; otherwise all tuner slots are queried at once.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef DIRECT_PROBE_H
+#define DIRECT_PROBE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DIRECT_PROBE_MAX_TARGETS 64
+#define DIRECT_PROBE_MAX_TUNERS 16
+
+struct direct_probe_result {
+    bool found;                 // Device answered and has at least one tuner
+    uint32_t device_id;
+    char ip_str[64];
+    char hwmodel[32];           // Empty if /sys/hwmodel didn't answer
+    int tuner_count;
+    bool count_from_model;      // Tuner count came from hwmodel, not a full probe
+    int tuner_queries;          // Tuner status queries it took
+};
+
+// Probes targets (IPs or device IDs) in parallel; results[i] is for targets[i].
+void direct_probe_targets(const char *const targets[], int count, struct direct_probe_result results[]);
+
+// Tuner count encoded in a model name such as "HDHR5-4DT", or 0 if unknown.
+int direct_probe_model_tuner_count(const char *hwmodel);
+
+#endif // DIRECT_PROBE_H
@@ -40,6 +40,10 @@
  * https://github.com/drmpeg/dtv-utils/blob/master/l1dump.c
  * */
 
+#ifdef __linux__
+#define _GNU_SOURCE // RUSAGE_THREAD
+#endif
+
 #include <ncurses.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -63,11 +67,29 @@
 #include <netdb.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <sys/resource.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #include "l1_detail_parser.h"
-
-#define MAX_DEVICES 10
-#define MAX_TUNERS_TOTAL 32 // Max combined tuners from all devices
+#include "status_poller.h"
+#include "status_fields.h"
+#include "query_cache.h"
+#include "metrics_export.h"
+#include "capture_engine.h"
+#include "capture_ring.h"
+#include "pretrigger_buffer.h"
+#include "ts_writer.h"
+#include "counter_watch.h"
+#include "band_scan.h"
+#include "scan_db.h"
+#include "device_inventory.h"
+#include "direct_probe.h"
+#include "device_pool.h"
+
+#define MAX_DEVICES 64
+#define MAX_TUNERS_TOTAL 256 // Max combined tuners from all devices
 #define BAR_WIDTH 30
 #define MAX_CHANNELS 256
 #define LEFT_PANE_WIDTH 14
@@ -77,13 +99,55 @@
 
 static const char* TUI_VERSION = "0.8.6";
 
-// Global variable to hold device filter from command line
+// Devices given on the command line (-d a,b,c and/or --hosts), as IDs or IPs;
+// target_device is the same list joined with commas, for messages
 static char* target_device = NULL;
+static char* target_list[DIRECT_PROBE_MAX_TARGETS];
+static int target_count = 0;
 
 // Global debug logging
 static FILE* debug_log_file = NULL;
 static bool verbose_mode = false;
 
+// Status polling: rate from the command line, one poller per device in the
+// tuner list, and the poller for the selected device
+static int poll_interval_ms = STATUS_POLLER_DEFAULT_INTERVAL_MS;
+static struct status_poller* device_pollers[MAX_DEVICES];
+static int device_poller_count = 0;
+static struct status_poller* active_poller = NULL;
+
+// UI control connections, kept open per device while the selection moves around
+static struct device_pool* device_pool = NULL;
+
+// L1 change trackers, one per tuner, kept for the life of the program
+static struct l1_tracker* l1_trackers[MAX_TUNERS_TOTAL];
+static uint32_t l1_tracker_device[MAX_TUNERS_TOTAL];
+static int l1_tracker_tuner[MAX_TUNERS_TOTAL];
+static int l1_tracker_count = 0;
+
+// Capture length for timed saves, and the segment ring used by continuous capture
+static int capture_duration_ms = 30000;
+#define MAX_CAPTURE_SECONDS (7 * 24 * 3600) // -t limit; well inside an int of milliseconds
+static int ring_segment_count = 10;
+static int ring_segment_seconds = 60;
+static int ring_keep_segments = 3;
+static int ring_max_events = 10;     // Events kept per continuous capture; later errors are only logged
+static int pretrigger_seconds = 10; // Kept in memory by autorestart saves, 0 = off
+static int posttrigger_seconds = 5; // Recorded into the event clip after an error
+
+// Headless metrics export (no ncurses)
+static bool headless_mode = false;
+static const char* metrics_target = "-";
+static enum metrics_format metrics_fmt = METRICS_FORMAT_JSON;
+static int metrics_interval_sec = 10;
+static bool metrics_l1_details = false;
+static volatile sig_atomic_t headless_stop = 0;
+
+// Scan results kept between runs, so seek and band scan can skip dead channels
+static const char* scan_db_path = SCAN_DB_DEFAULT_PATH;
+static int scan_db_ttl_sec = SCAN_DB_DEFAULT_TTL_SEC;
+static struct scan_db* scan_db = NULL;
+
 // Debug logging function
 void log_debug(const char* format, ...) {
     if (!verbose_mode) return;
@@ -91,8 +155,9 @@ void log_debug(const char* format, ...) {
     va_list args;
     time_t now = time(NULL);
     char timestamp[26];
-    struct tm* tm_info = localtime(&now);
-    strftime(timestamp, 26, "%Y-%m-%d %H:%M:%S", tm_info);
+    struct tm tm_info;
+    localtime_r(&now, &tm_info); // Also called from headless L1 worker threads
+    strftime(timestamp, 26, "%Y-%m-%d %H:%M:%S", &tm_info);
     
     if (debug_log_file) {
         fprintf(debug_log_file, "[%s] ", timestamp);
@@ -117,6 +182,7 @@ struct unified_tuner {
 struct channel_list {
     unsigned int channels[MAX_CHANNELS];
     int count;
+    char map[32];               // Channel map name, the scan db key
 };
 
 // A struct to hold a single line of PLP info for sorting
@@ -136,43 +202,80 @@ enum save_mode {
 };
 
 // Function Prototypes
+int discover_devices(struct inventory_device devices[], int max_devices);
+int build_tuner_list(const struct inventory_device devices[], int device_count, struct unified_tuner tuners[]);
 int discover_and_build_tuner_list(struct unified_tuner tuners[]);
+int load_cached_tuner_list(struct unified_tuner tuners[]);
+void start_background_discovery(const struct unified_tuner tuners[], int total_tuners);
+int finish_background_discovery(struct inventory_device devices[], bool wait);
+bool merge_discovered_devices(struct unified_tuner tuners[], int *total_tuners, int *highlight,
+                              const struct inventory_device devices[], int device_count);
 void draw_signal_bar(WINDOW *win, int y, int x, const char *label, int percentage, int db_value, const char* db_unit);
 void print_line_in_box(WINDOW *win, int y, int x, const char *fmt, ...);
-int draw_status_pane(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info, int scroll_offset);
+int draw_status_pane(WINDOW *win, struct status_poller *poller, struct unified_tuner *tuner_info, int scroll_offset);
+int draw_dashboard_pane(WINDOW *win, struct unified_tuner tuners[], int total_tuners, int highlight, int scroll_offset);
+struct status_poller* get_device_poller(struct unified_tuner *tuner_info);
+void remove_device_poller(uint32_t device_id);
+struct l1_tracker* get_l1_tracker(struct unified_tuner *tuner_info);
+void update_poller_watch_masks(struct unified_tuner tuners[], int total_tuners, int highlight, bool all_tuners);
+void destroy_device_pollers(void);
+int run_headless(void);
 int show_help_screen(WINDOW *parent_win);
 char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mode, struct unified_tuner *tuner_info, bool debug_enabled);
+char* capture_locked_tuners(WINDOW *parent_win, struct unified_tuner tuners[], int total_tuners, int highlight, bool all_devices);
+char* ring_capture_stream(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info);
+char* scan_band(WINDOW *parent_win, struct unified_tuner tuners[], int total_tuners, int highlight,
+                const struct channel_list *list, bool all_devices);
 int main_loop(void);
 int compare_channels(const void *a, const void *b);
 int compare_plps(const void *a, const void *b);
-void populate_channel_list(struct hdhomerun_device_t *hd, struct channel_list *list);
-long parse_db_value(const char *status_str, const char *key);
-long parse_status_value(const char *status_str, const char *key);
+bool populate_channel_list(struct hdhomerun_device_t *hd, struct channel_list *list);
 char* stream_to_vlc(struct hdhomerun_device_t *hd, WINDOW *win, pid_t *vlc_pid, struct unified_tuner *tuner_info);
 int select_program_menu(WINDOW *win, char *streaminfo_str, char *selected_program_str, int *selected_plp);
 int get_udp_port();
 int show_plp_details_screen(WINDOW *parent_win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info);
-int http_save_stream(const char *ip_addr, const char *url, const char *filename, WINDOW *win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info, bool autorestart_enabled, int save_attempts, int max_save_attempts, bool *out_aborted, bool *out_error_detected, bool debug_enabled);
+int http_save_stream(const char *ip_addr, const char *url, const char *filename, WINDOW *win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info, bool autorestart_enabled, int save_attempts, int max_save_attempts, bool *out_aborted, bool *out_error_detected, bool debug_enabled, struct pretrigger_buffer *pretrigger);
 
 /*
- * discover_and_build_tuner_list
- * Finds HDHomeRun devices and populates a flat list of all available tuners.
+ * target_matches_device
+ * True if a -d/--hosts entry names this device by ID or IP.
  */
-int discover_and_build_tuner_list(struct unified_tuner tuners[]) {
-    clear();
-    if (target_device) {
-        mvprintw(0, 0, "Discovering HDHomeRun device: %s...", target_device);
-        log_debug("Starting discovery for specific device: %s", target_device);
-    } else {
-        mvprintw(0, 0, "Discovering HDHomeRun devices...");
-        log_debug("Starting discovery for all devices");
+static bool target_matches_device(const char *target, uint32_t device_id, const char *ip_str) {
+    char device_id_str[16];
+    snprintf(device_id_str, sizeof(device_id_str), "%08X", device_id);
+    return strcasecmp(target, device_id_str) == 0 || strcmp(target, ip_str) == 0;
+}
+
+/*
+ * device_matches_target
+ * True if no devices were given on the command line, or if one of them names this device.
+ */
+static bool device_matches_target(uint32_t device_id, const char *ip_str) {
+    if (target_count == 0) return true;
+
+    log_debug("Checking if device matches target '%s': DeviceID=%08X, IP=%s",
+              target_device, device_id, ip_str);
+    for (int t = 0; t < target_count; t++) {
+        if (target_matches_device(target_list[t], device_id, ip_str)) {
+            log_debug("Device MATCHES target %s!", target_list[t]);
+            return true;
+        }
     }
-    refresh();
+    log_debug("Device does NOT match any target");
+    return false;
+}
 
+/*
+ * discover_devices
+ * Finds HDHomeRun devices without touching the screen, so it can also run on
+ * the background discovery thread. A non-empty result is saved as the device
+ * inventory. Returns the number of devices, or -1 if discovery itself failed.
+ */
+int discover_devices(struct inventory_device devices[], int max_devices) {
     struct hdhomerun_discover_t *ds = hdhomerun_discover_create(NULL);
     if (!ds) {
         log_debug("ERROR: Failed to create discovery object");
-        return 0;
+        return -1;
     }
 
     uint32_t device_types[1] = { HDHOMERUN_DEVICE_TYPE_TUNER };
@@ -180,145 +283,296 @@ int discover_and_build_tuner_list(struct unified_tuner tuners[]) {
     if (hdhomerun_discover2_find_devices_broadcast(ds, HDHOMERUN_DISCOVER_FLAGS_IPV4_GENERAL, device_types, 1) < 0) {
         log_debug("ERROR: Discovery broadcast failed");
         hdhomerun_discover_destroy(ds);
-        return 0;
+        return -1;
     }
     log_debug("Discovery broadcast completed");
 
-    int total_tuner_count = 0;
+    int device_count = 0;
     struct hdhomerun_discover2_device_t *device = hdhomerun_discover2_iter_device_first(ds);
     log_debug("Iterating through discovered devices...");
-    while (device && total_tuner_count < MAX_TUNERS_TOTAL) {
-        uint32_t device_id = hdhomerun_discover2_device_get_device_id(device);
-        int tuner_count = hdhomerun_discover2_device_get_tuner_count(device);
-        bool is_legacy = hdhomerun_discover2_device_is_legacy(device);
-        char ip_str[64];
+    while (device && device_count < max_devices) {
+        struct inventory_device *dev = &devices[device_count];
+        dev->device_id = hdhomerun_discover2_device_get_device_id(device);
+        dev->tuner_count = hdhomerun_discover2_device_get_tuner_count(device);
+        dev->is_legacy = hdhomerun_discover2_device_is_legacy(device);
 
         struct hdhomerun_discover2_device_if_t *device_if = hdhomerun_discover2_iter_device_if_first(device);
         struct sockaddr_storage ip_address;
         hdhomerun_discover2_device_if_get_ip_addr(device_if, &ip_address);
-        hdhomerun_sock_sockaddr_to_ip_str(ip_str, (struct sockaddr *)&ip_address, true);
+        hdhomerun_sock_sockaddr_to_ip_str(dev->ip_str, (struct sockaddr *)&ip_address, true);
         
         log_debug("Found device: ID=%08X, IP=%s, Tuners=%d, Legacy=%s", 
-                  device_id, ip_str, tuner_count, is_legacy ? "yes" : "no");
+                  dev->device_id, dev->ip_str, dev->tuner_count, dev->is_legacy ? "yes" : "no");
 
         // Filter by device if specified on command line
-        bool device_matches = true;
-        if (target_device != NULL) {
-            char device_id_str[16];
-            snprintf(device_id_str, sizeof(device_id_str), "%08X", device_id);
-            
-            log_debug("Checking if device matches target '%s': DeviceID=%s, IP=%s",
-                      target_device, device_id_str, ip_str);
-            
-            // Check if target matches device ID or IP address
-            if (strcasecmp(target_device, device_id_str) != 0 && 
-                strcmp(target_device, ip_str) != 0) {
-                device_matches = false;
-                log_debug("Device does NOT match target (ID comparison: %s, IP comparison: %s)",
-                          strcasecmp(target_device, device_id_str) != 0 ? "false" : "true",
-                          strcmp(target_device, ip_str) != 0 ? "false" : "true");
-            } else {
-                log_debug("Device MATCHES target!");
-            }
-        }
-
-        if (device_matches) {
-            log_debug("Adding %d tuners from device %08X to tuner list", tuner_count, device_id);
-            for (int i = 0; i < tuner_count && total_tuner_count < MAX_TUNERS_TOTAL; i++) {
-                tuners[total_tuner_count].device_id = device_id;
-                strcpy(tuners[total_tuner_count].ip_str, ip_str);
-                tuners[total_tuner_count].tuner_index = i;
-                tuners[total_tuner_count].total_tuners_on_device = tuner_count;
-                tuners[total_tuner_count].is_legacy = is_legacy;
-                log_debug("  Added tuner %d: %08X-%d (%s)", 
-                          total_tuner_count, device_id, i, ip_str);
-                total_tuner_count++;
-            }
-        }
+        if (device_matches_target(dev->device_id, dev->ip_str)) device_count++;
 
         device = hdhomerun_discover2_iter_device_next(device);
     }
 
     hdhomerun_discover_destroy(ds);
-    log_debug("Discovery complete. Total tuners found: %d", total_tuner_count);
+    log_debug("Discovery complete. Total devices found: %d", device_count);
     
-    // If no devices found and a specific target was provided, try direct connection
+    // Targets that broadcast discovery didn't find are probed directly, all at once.
     // This is needed for connecting across Layer 3 boundaries where broadcast discovery fails
-    if (total_tuner_count == 0 && target_device != NULL) {
-        log_debug("No devices found via broadcast discovery. Attempting direct connection to: %s", target_device);
-        
-        // Try to create a device directly from the target string (supports IP or device ID)
-        struct hdhomerun_device_t *test_hd = hdhomerun_device_create_from_str(target_device, NULL);
-        if (test_hd) {
-            log_debug("Direct device connection created successfully");
-            
-            // Try to get device ID to confirm connectivity
-            uint32_t device_id = hdhomerun_device_get_device_id(test_hd);
-            if (device_id != 0) {
-                log_debug("Device responded with ID: %08X", device_id);
-                
-                // Get the actual IP address
-                uint32_t device_ip = hdhomerun_device_get_device_ip(test_hd);
-                struct in_addr addr;
-                addr.s_addr = htonl(device_ip);
-                char ip_str[64];
-                strncpy(ip_str, inet_ntoa(addr), sizeof(ip_str) - 1);
-                ip_str[sizeof(ip_str) - 1] = '\0';
-                log_debug("Device IP address: %s", ip_str);
-                
-                // Probe for tuner count by trying each tuner until we get an error
-                int tuner_count = 0;
-                for (int i = 0; i < 16; i++) {  // Max 16 tuners (reasonable limit)
-                    hdhomerun_device_set_tuner(test_hd, i);
-                    char *status_str = NULL;
-                    struct hdhomerun_tuner_status_t status;
-                    
-                    // Try to get tuner status - if it fails, we've exceeded tuner count
-                    int result = hdhomerun_device_get_tuner_status(test_hd, &status_str, &status);
-                    if (result <= 0) {
-                        log_debug("Tuner %d query failed, stopping probe", i);
-                        break;
-                    }
-                    tuner_count = i + 1;
-                    log_debug("Tuner %d responded successfully", i);
-                }
-                
-                log_debug("Direct connection determined %d tuners", tuner_count);
-                
-                if (tuner_count > 0) {
-                    // Add all tuners to the list
-                    bool is_legacy = false;  // Assume non-legacy for direct connections
-                    
-                    for (int i = 0; i < tuner_count && total_tuner_count < MAX_TUNERS_TOTAL; i++) {
-                        tuners[total_tuner_count].device_id = device_id;
-                        strcpy(tuners[total_tuner_count].ip_str, ip_str);
-                        tuners[total_tuner_count].tuner_index = i;
-                        tuners[total_tuner_count].total_tuners_on_device = tuner_count;
-                        tuners[total_tuner_count].is_legacy = is_legacy;
-                        log_debug("  Added tuner %d: %08X-%d (%s) via direct connection", 
-                                  total_tuner_count, device_id, i, ip_str);
-                        total_tuner_count++;
-                    }
-                } else {
-                    log_debug("WARNING: Device responded but no tuners found");
-                }
-            } else {
-                log_debug("ERROR: Device connection created but device did not respond");
+    const char *unmatched[DIRECT_PROBE_MAX_TARGETS];
+    int unmatched_count = 0;
+    for (int t = 0; t < target_count; t++) {
+        bool found = false;
+        for (int d = 0; d < device_count && !found; d++) {
+            found = target_matches_device(target_list[t], devices[d].device_id, devices[d].ip_str);
+        }
+        if (!found) unmatched[unmatched_count++] = target_list[t];
+    }
+
+    if (unmatched_count > 0) {
+        log_debug("%d target(s) not found via broadcast discovery. Attempting direct connection", unmatched_count);
+        struct direct_probe_result results[DIRECT_PROBE_MAX_TARGETS];
+        direct_probe_targets(unmatched, unmatched_count, results);
+
+        for (int t = 0; t < unmatched_count; t++) {
+            const struct direct_probe_result *r = &results[t];
+            if (r->device_id == 0) {
+                log_debug("ERROR: %s did not respond to a direct connection", unmatched[t]);
+                continue;
             }
-            
-            hdhomerun_device_destroy(test_hd);
-        } else {
-            log_debug("ERROR: Failed to create direct device connection");
+            log_debug("%s responded with ID: %08X, IP: %s, model: %s", unmatched[t], r->device_id, r->ip_str,
+                      r->hwmodel[0] ? r->hwmodel : "unknown");
+            log_debug("Direct connection determined %d tuners (%s, %d tuner queries)", r->tuner_count,
+                      r->count_from_model ? "from hwmodel" : "by probing", r->tuner_queries);
+            if (!r->found) {
+                log_debug("WARNING: Device responded but no tuners found");
+                continue;
+            }
+            if (device_count >= max_devices || device_inventory_find(devices, device_count, r->device_id) >= 0) continue;
+
+            devices[device_count].device_id = r->device_id;
+            snprintf(devices[device_count].ip_str, sizeof(devices[device_count].ip_str), "%s", r->ip_str);
+            devices[device_count].tuner_count = r->tuner_count;
+            devices[device_count].is_legacy = false;  // Assume non-legacy for direct connections
+            device_count++;
         }
-        
-        log_debug("Direct connection attempt complete. Total tuners: %d", total_tuner_count);
+        log_debug("Direct connection attempt complete. Total devices: %d", device_count);
     }
+
+    if (device_count > 0 && device_inventory_save(DEVICE_INVENTORY_DEFAULT_PATH, devices, device_count) != 0) {
+        log_debug("WARNING: Could not save device inventory to %s", DEVICE_INVENTORY_DEFAULT_PATH);
+    }
+    return device_count;
+}
+
+/*
+ * build_tuner_list
+ * Flattens a device list into one entry per tuner.
+ */
+int build_tuner_list(const struct inventory_device devices[], int device_count, struct unified_tuner tuners[]) {
+    int total_tuner_count = 0;
+    for (int d = 0; d < device_count; d++) {
+        const struct inventory_device *dev = &devices[d];
+        log_debug("Adding %d tuners from device %08X to tuner list", dev->tuner_count, dev->device_id);
+        for (int i = 0; i < dev->tuner_count && total_tuner_count < MAX_TUNERS_TOTAL; i++) {
+            tuners[total_tuner_count].device_id = dev->device_id;
+            snprintf(tuners[total_tuner_count].ip_str, sizeof(tuners[total_tuner_count].ip_str), "%s", dev->ip_str);
+            tuners[total_tuner_count].tuner_index = i;
+            tuners[total_tuner_count].total_tuners_on_device = dev->tuner_count;
+            tuners[total_tuner_count].is_legacy = dev->is_legacy;
+            log_debug("  Added tuner %d: %08X-%d (%s)", 
+                      total_tuner_count, dev->device_id, i, dev->ip_str);
+            total_tuner_count++;
+        }
+    }
+    return total_tuner_count;
+}
+
+/*
+ * discover_and_build_tuner_list
+ * Finds HDHomeRun devices and populates a flat list of all available tuners.
+ */
+int discover_and_build_tuner_list(struct unified_tuner tuners[]) {
+    if (!headless_mode) clear();
+    if (target_device) {
+        if (!headless_mode) mvprintw(0, 0, "Discovering HDHomeRun device: %s...", target_device);
+        log_debug("Starting discovery for specific device: %s", target_device);
+    } else {
+        if (!headless_mode) mvprintw(0, 0, "Discovering HDHomeRun devices...");
+        log_debug("Starting discovery for all devices");
+    }
+    if (!headless_mode) refresh();
+
+    struct inventory_device devices[DEVICE_INVENTORY_MAX_DEVICES];
+    int device_count = discover_devices(devices, DEVICE_INVENTORY_MAX_DEVICES);
+    int total_tuner_count = build_tuner_list(devices, device_count > 0 ? device_count : 0, tuners);
+    log_debug("Total tuners found: %d", total_tuner_count);
     
-    clear();
-    refresh();
+    if (!headless_mode) {
+        clear();
+        refresh();
+    }
     return total_tuner_count;
 }
 
+/*
+ * load_cached_tuner_list
+ * Builds the tuner list from the saved device inventory, keeping only the
+ * device given with -d, if any. Returns 0 if there is nothing usable.
+ */
+int load_cached_tuner_list(struct unified_tuner tuners[]) {
+    struct inventory_device devices[DEVICE_INVENTORY_MAX_DEVICES];
+    int loaded = device_inventory_load(DEVICE_INVENTORY_DEFAULT_PATH, devices, DEVICE_INVENTORY_MAX_DEVICES);
+    int device_count = 0;
+    for (int i = 0; i < loaded; i++) {
+        if (device_matches_target(devices[i].device_id, devices[i].ip_str)) devices[device_count++] = devices[i];
+    }
+    log_debug("Device inventory: %d of %d cached devices usable", device_count, loaded);
+    return build_tuner_list(devices, device_count, tuners);
+}
+
+// Live discovery started behind a tuner list loaded from the inventory
+struct background_discovery {
+    pthread_t thread;
+    atomic_bool done;
+    int device_count;
+    struct inventory_device devices[DEVICE_INVENTORY_MAX_DEVICES];
+    int known_count;            // Devices in the tuner list when it started
+    struct inventory_device known[DEVICE_INVENTORY_MAX_DEVICES];
+};
+
+static struct background_discovery* background_discovery = NULL;
+
+/*
+ * reprobe_missing_devices
+ * Broadcasts get lost, so a known device that discovery didn't report is
+ * probed directly at its last address before it is given up on. Devices
+ * that answer are added to the discovery result.
+ */
+static int reprobe_missing_devices(struct background_discovery *discovery) {
+    const char *targets[DIRECT_PROBE_MAX_TARGETS];
+    const struct inventory_device *missing[DIRECT_PROBE_MAX_TARGETS];
+    int missing_count = 0;
+    for (int i = 0; i < discovery->known_count && missing_count < DIRECT_PROBE_MAX_TARGETS; i++) {
+        if (device_inventory_find(discovery->devices, discovery->device_count, discovery->known[i].device_id) >= 0) continue;
+        missing[missing_count] = &discovery->known[i];
+        targets[missing_count++] = discovery->known[i].ip_str;
+    }
+    if (missing_count == 0) return 0;
+
+    struct direct_probe_result results[DIRECT_PROBE_MAX_TARGETS];
+    direct_probe_targets(targets, missing_count, results);
+
+    int kept = 0;
+    for (int i = 0; i < missing_count; i++) {
+        const struct direct_probe_result *r = &results[i];
+        if (!r->found || r->device_id != missing[i]->device_id) {
+            log_debug("Discovery: device %08X did not answer at %s", missing[i]->device_id, missing[i]->ip_str);
+            continue;
+        }
+        if (discovery->device_count >= DEVICE_INVENTORY_MAX_DEVICES) break;
+        struct inventory_device *dev = &discovery->devices[discovery->device_count++];
+        *dev = *missing[i];
+        snprintf(dev->ip_str, sizeof(dev->ip_str), "%s", r->ip_str);
+        dev->tuner_count = r->tuner_count;
+        kept++;
+    }
+    log_debug("Discovery: %d of %d devices missed by discovery answered directly", kept, missing_count);
+    return kept;
+}
+
+static void* background_discovery_thread(void *arg) {
+    struct background_discovery *discovery = (struct background_discovery *)arg;
+    int device_count = discover_devices(discovery->devices, DEVICE_INVENTORY_MAX_DEVICES);
+    discovery->device_count = device_count > 0 ? device_count : 0;
+    if (reprobe_missing_devices(discovery) > 0 &&
+        device_inventory_save(DEVICE_INVENTORY_DEFAULT_PATH, discovery->devices, discovery->device_count) != 0) {
+        log_debug("WARNING: Could not save device inventory to %s", DEVICE_INVENTORY_DEFAULT_PATH);
+    }
+    // Nothing answered at all: more likely our network than every device,
+    // so keep the list we have
+    if (discovery->device_count == 0) discovery->device_count = -1;
+    atomic_store(&discovery->done, true);
+    return NULL;
+}
+
+void start_background_discovery(const struct unified_tuner tuners[], int total_tuners) {
+    if (background_discovery) return;
+    struct background_discovery *discovery = calloc(1, sizeof(struct background_discovery));
+    if (!discovery) return;
+    atomic_init(&discovery->done, false);
+    for (int i = 0; i < total_tuners && discovery->known_count < DEVICE_INVENTORY_MAX_DEVICES; i++) {
+        if (tuners[i].tuner_index != 0) continue;
+        struct inventory_device *dev = &discovery->known[discovery->known_count++];
+        dev->device_id = tuners[i].device_id;
+        snprintf(dev->ip_str, sizeof(dev->ip_str), "%s", tuners[i].ip_str);
+        dev->tuner_count = tuners[i].total_tuners_on_device;
+        dev->is_legacy = tuners[i].is_legacy;
+    }
+    if (pthread_create(&discovery->thread, NULL, background_discovery_thread, discovery) != 0) {
+        free(discovery);
+        return;
+    }
+    log_debug("Background discovery started");
+    background_discovery = discovery;
+}
+
+/*
+ * finish_background_discovery
+ * Collects the result once the background discovery is done (or, with wait,
+ * blocks until it is). Returns the device count, -1 if nothing answered
+ * (the current list should be kept), or -2 if it is still running or was
+ * never started.
+ */
+int finish_background_discovery(struct inventory_device devices[], bool wait) {
+    struct background_discovery *discovery = background_discovery;
+    if (!discovery || (!wait && !atomic_load(&discovery->done))) return -2;
+
+    pthread_join(discovery->thread, NULL);
+    int device_count = discovery->device_count;
+    if (devices && device_count > 0) memcpy(devices, discovery->devices, device_count * sizeof(struct inventory_device));
+    free(discovery);
+    background_discovery = NULL;
+    return device_count;
+}
+
+/*
+ * merge_discovered_devices
+ * Rebuilds tuners[] from a fresh discovery, keeping the highlight on the same
+ * tuner where it still exists. Pollers of devices that are gone, or that
+ * came back with a different address or tuner count, are stopped; the rest
+ * keep running. Returns true if the selected tuner went away or moved.
+ */
+bool merge_discovered_devices(struct unified_tuner tuners[], int *total_tuners, int *highlight,
+                              const struct inventory_device devices[], int device_count) {
+    struct unified_tuner selected = tuners[*highlight];
+    bool selected_moved = false;
+
+    for (int i = 0; i < *total_tuners; i++) {
+        if (tuners[i].tuner_index != 0) continue; // One check per device
+        int d = device_inventory_find(devices, device_count, tuners[i].device_id);
+        if (d >= 0 && strcmp(devices[d].ip_str, tuners[i].ip_str) == 0 &&
+            devices[d].tuner_count == tuners[i].total_tuners_on_device) {
+            continue;
+        }
+        log_debug("Discovery: device %08X %s", tuners[i].device_id, d < 0 ? "is gone" : "has changed");
+        remove_device_poller(tuners[i].device_id);
+        device_pool_remove(device_pool, tuners[i].device_id);
+        if (tuners[i].device_id == selected.device_id) selected_moved = true;
+    }
+    for (int d = 0; d < device_count; d++) {
+        bool known = false;
+        for (int i = 0; i < *total_tuners && !known; i++) known = tuners[i].device_id == devices[d].device_id;
+        if (!known) log_debug("Discovery: new device %08X (%s)", devices[d].device_id, devices[d].ip_str);
+    }
+
+    *total_tuners = build_tuner_list(devices, device_count, tuners);
+    for (int i = 0; i < *total_tuners; i++) {
+        if (tuners[i].device_id == selected.device_id && tuners[i].tuner_index == selected.tuner_index) {
+            *highlight = i;
+            return selected_moved;
+        }
+    }
+    if (*highlight >= *total_tuners) *highlight = (*total_tuners > 0) ? *total_tuners - 1 : 0;
+    return true;
+}
+
 /*
  * draw_signal_bar
  * Draws a color-coded bar graph for a signal percentage, with optional dB value.
@@ -364,47 +618,111 @@ void print_line_in_box(WINDOW *win, int y, int x, const char *fmt, ...) {
 }
 
 /*
- * parse_db_value
- * Helper to find a dB value from a key like "ss=100(-35dBm)".
+ * read_debug_fields
+ * Fetches /tunerN/debug and parses its te/ne/se counters in one pass.
+ * Returns false, with every field STATUS_VALUE_NONE, if the query failed.
  */
-long parse_db_value(const char *status_str, const char *key) {
-    const char *key_found = strstr(status_str, key);
-    if (key_found) {
-        const char *paren_open = strchr(key_found, '(');
-        if (paren_open) {
-            return strtol(paren_open + 1, NULL, 10);
-        }
+static bool read_debug_fields(struct hdhomerun_device_t *hd, const char *debug_path, struct status_fields *fields) {
+    char *debug_str;
+    status_fields_init(fields);
+    if (hdhomerun_device_get_var(hd, debug_path, &debug_str, NULL) <= 0) return false;
+    status_fields_parse(fields, debug_str);
+    return true;
+}
+
+
+/*
+ * get_device_poller
+ * Returns the status poller for a tuner's device, starting one on first use.
+ * Each poller keeps its own control connection, so devices refresh in parallel.
+ */
+struct status_poller* get_device_poller(struct unified_tuner *tuner_info) {
+    for (int i = 0; i < device_poller_count; i++) {
+        if (status_poller_get_device_id(device_pollers[i]) == tuner_info->device_id) return device_pollers[i];
+    }
+    if (device_poller_count >= MAX_DEVICES) return NULL;
+
+    int interval_ms = tuner_info->is_legacy && poll_interval_ms < 500 ? 500 : poll_interval_ms;
+    struct status_poller *poller = status_poller_create(tuner_info->device_id, tuner_info->ip_str, interval_ms);
+    if (poller) {
+        log_debug("Started status poller for %08X (%s, interval %d ms)", tuner_info->device_id, tuner_info->ip_str, interval_ms);
+        device_pollers[device_poller_count++] = poller;
     }
-    return -999; // Sentinel for not found
+    return poller;
 }
 
 /*
- * parse_status_value
- * Helper to find a numeric value for a given key in the raw status string.
- * It now uses base 0 for strtol to auto-detect hex (0x) and decimal.
+ * remove_device_poller
+ * Stops the poller for one device, e.g. after discovery finds it has gone.
  */
-long parse_status_value(const char *status_str, const char *key) {
-    const char *found = strstr(status_str, key);
-    if (found) {
-        // Use base 0 to auto-detect number format (e.g., "0x" for hex)
-        return strtol(found + strlen(key), NULL, 0);
+void remove_device_poller(uint32_t device_id) {
+    for (int i = 0; i < device_poller_count; i++) {
+        if (status_poller_get_device_id(device_pollers[i]) != device_id) continue;
+        if (active_poller == device_pollers[i]) active_poller = NULL;
+        status_poller_destroy(device_pollers[i]);
+        device_pollers[i] = device_pollers[--device_poller_count];
+        device_pollers[device_poller_count] = NULL;
+        return;
     }
-    return -999; // Sentinel for not found
 }
 
+/*
+ * destroy_device_pollers
+ * Stops every poller thread and closes their control connections.
+ */
+void destroy_device_pollers(void) {
+    for (int i = 0; i < device_poller_count; i++) {
+        status_poller_destroy(device_pollers[i]);
+        device_pollers[i] = NULL;
+    }
+    device_poller_count = 0;
+    active_poller = NULL;
+}
+
+/*
+ * log_l1_change
+ * Records a broadcaster L1 change reported by a tuner's tracker.
+ */
+static void log_l1_change(void *opaque, const struct l1_change_event *event) {
+    (void)opaque;
+    log_debug("L1 detail changed on %08X tuner %d: L1D_crc 0x%08lx -> 0x%08lx (change #%u)",
+              event->device_id, event->tuner_index, event->old_crc, event->new_crc, event->change_count);
+}
+
+/*
+ * get_l1_tracker
+ * Returns the L1 change tracker for a tuner, creating it on first use.
+ * Main thread only.
+ */
+struct l1_tracker* get_l1_tracker(struct unified_tuner *tuner_info) {
+    for (int i = 0; i < l1_tracker_count; i++) {
+        if (l1_tracker_device[i] == tuner_info->device_id && l1_tracker_tuner[i] == tuner_info->tuner_index) return l1_trackers[i];
+    }
+    if (l1_tracker_count >= MAX_TUNERS_TOTAL) return NULL;
+
+    struct l1_tracker *tracker = l1_tracker_create(tuner_info->device_id, tuner_info->tuner_index, log_l1_change, NULL);
+    if (tracker) {
+        l1_trackers[l1_tracker_count] = tracker;
+        l1_tracker_device[l1_tracker_count] = tuner_info->device_id;
+        l1_tracker_tuner[l1_tracker_count] = tuner_info->tuner_index;
+        l1_tracker_count++;
+    }
+    return tracker;
+}
 
 /*
  * draw_status_pane
- * Fetches and displays the status of a tuner in a dedicated sub-window.
+ * Displays the status of a tuner in a dedicated sub-window, using the latest
+ * snapshot from the background poller so a redraw never waits on the device.
  * Returns the total number of content lines, for scrolling purposes.
  */
-int draw_status_pane(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info, int scroll_offset) {
+int draw_status_pane(WINDOW *win, struct status_poller *poller, struct unified_tuner *tuner_info, int scroll_offset) {
     werase(win);
     box(win, 0, 0);
     
-    if (!hd || !tuner_info) {
+    if (!poller || !tuner_info) {
         mvwprintw(win, 1, 2, "No Tuner Selected");
-        log_debug("draw_status_pane: No device or tuner info");
+        log_debug("draw_status_pane: No poller or tuner info");
         return 0;
     }
 
@@ -412,21 +730,23 @@ int draw_status_pane(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_
     sprintf(title, " Tuner %08X-%d (%s) Status ", tuner_info->device_id, tuner_info->tuner_index, tuner_info->ip_str);
     mvwprintw(win, 0, 2, "%s", title);
 
-    struct hdhomerun_tuner_status_t status;
-    char *raw_status_str;
+    struct tuner_status_snapshot snap;
     bool is_atsc3 = false;
     int total_content_lines = 0;
     int y = 2; // Start drawing at line 2
 
-    log_debug("draw_status_pane: Getting tuner status for %08X-%d", tuner_info->device_id, tuner_info->tuner_index);
-    int status_result = hdhomerun_device_get_tuner_status(hd, &raw_status_str, &status);
-    log_debug("draw_status_pane: get_tuner_status returned %d", status_result);
-    if (status_result > 0) {
-        long bps = parse_status_value(raw_status_str, "bps=");
-        long pps = parse_status_value(raw_status_str, "pps=");
-        long rssi = parse_db_value(raw_status_str, "ss=");
-        long snr = parse_db_value(raw_status_str, "snq=");
-        log_debug("draw_status_pane: Channel=%s, Lock=%s, bps=%ld, pps=%ld", status.channel, status.lock_str, bps, pps);
+    uint64_t version = status_poller_get_snapshot(poller, tuner_info->tuner_index, &snap);
+    if (version == 0) {
+        print_line_in_box(win, y, 2, "Waiting for tuner status...");
+        return 0;
+    }
+    struct hdhomerun_tuner_status_t status = snap.status;
+    if (snap.valid) {
+        long bps = snap.fields.value[STATUS_KEY_BPS];
+        long pps = snap.fields.value[STATUS_KEY_PPS];
+        long rssi = snap.fields.db[STATUS_KEY_SS];
+        long snr = snap.fields.db[STATUS_KEY_SNQ];
+        log_debug("draw_status_pane: Snapshot v%llu Channel=%s, Lock=%s, bps=%ld, pps=%ld", (unsigned long long)version, status.channel, status.lock_str, bps, pps);
 
         total_content_lines = 11; // Base number of lines for the top section
 
@@ -466,11 +786,9 @@ int draw_status_pane(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_
         const char *id_label = is_atsc3 ? "BSID" : "TSID";
         long id_val = -999;
         
-        char *streaminfo;
-        if (hdhomerun_device_get_tuner_streaminfo(hd, &streaminfo) > 0) id_val = parse_status_value(streaminfo, "tsid=");
-        char *plpinfo;
-        if (is_atsc3 && hdhomerun_device_get_tuner_plpinfo(hd, &plpinfo) > 0) {
-            long bsid = parse_status_value(plpinfo, "bsid=");
+        if (snap.has_streaminfo) id_val = snap.fields.value[STATUS_KEY_TSID];
+        if (is_atsc3 && snap.has_plpinfo) {
+            long bsid = snap.fields.value[STATUS_KEY_BSID];
             if (bsid != -999) id_val = bsid;
         }
         if (id_val != -999) {
@@ -485,29 +803,21 @@ int draw_status_pane(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_
         double mbps = (pps > 0 && bps != -999) ? (double)bps / 1000000.0 : 0.0;
         if (y - scroll_offset > 0) { print_line_in_box(win, y - scroll_offset, 2, "%-18s: %.3f Mbps", "Network Rate", mbps); } y++;
 
-        char *target_str;
-        if (hdhomerun_device_get_tuner_target(hd, &target_str) > 0) {
-            if (y - scroll_offset > 0) { print_line_in_box(win, y - scroll_offset, 2, "%-18s: %s", "Network Target", target_str); } y++;
+        if (snap.has_target) {
+            if (y - scroll_offset > 0) { print_line_in_box(win, y - scroll_offset, 2, "%-18s: %s", "Network Target", snap.target); } y++;
         }
         
         if (y - scroll_offset > 0) { mvwhline(win, y - scroll_offset, 2, ACS_HLINE, getmaxx(win) - 4); } y++;
 
-        struct hdhomerun_tuner_vstatus_t vstatus;
-        char *vstatus_str;
-        log_debug("draw_status_pane: Getting vstatus");
-        int vstatus_result = hdhomerun_device_get_tuner_vstatus(hd, &vstatus_str, &vstatus);
-        log_debug("draw_status_pane: get_tuner_vstatus returned %d", vstatus_result);
-        if (vstatus_result > 0 && strlen(vstatus.vchannel) > 0) {
+        struct hdhomerun_tuner_vstatus_t vstatus = snap.vstatus;
+        if (snap.has_vstatus && strlen(vstatus.vchannel) > 0) {
             total_content_lines += 2;
             if (y - scroll_offset > 0) { print_line_in_box(win, y - scroll_offset, 2, "Virtual Channel: %s", vstatus.vchannel); } y++;
             if (y - scroll_offset > 0) { print_line_in_box(win, y - scroll_offset, 2, "Name: %s", vstatus.name); } y++;
         }
         
-        char *streaminfo_prog;
-        log_debug("draw_status_pane: Getting streaminfo");
-        int streaminfo_result = hdhomerun_device_get_tuner_streaminfo(hd, &streaminfo_prog);
-        log_debug("draw_status_pane: get_tuner_streaminfo returned %d", streaminfo_result);
-        if (streaminfo_result > 0) {
+        char *streaminfo_prog = snap.streaminfo;
+        if (snap.has_streaminfo) {
             char *programs[MAX_PROGRAMS];
             int program_count = 0;
             char *streaminfo_copy = strdup(streaminfo_prog);
@@ -575,8 +885,8 @@ int draw_status_pane(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_
             for (int i = 0; i < program_count; i++) free(programs[i]);
         }
         
-        char *plpinfo_str;
-        if (is_atsc3 && hdhomerun_device_get_tuner_plpinfo(hd, &plpinfo_str) > 0) {
+        char *plpinfo_str = snap.plpinfo;
+        if (is_atsc3 && snap.has_plpinfo) {
             struct plp_line plp_lines[MAX_PLPS];
             int plp_count = 0;
             char *plpinfo_copy = strdup(plpinfo_str);
@@ -624,6 +934,95 @@ int draw_status_pane(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_
     return total_content_lines;
 }
 
+/*
+ * update_poller_watch_masks
+ * Points each device poller at the tuners currently on screen: every tuner
+ * in dashboard mode, otherwise only the highlighted one.
+ */
+void update_poller_watch_masks(struct unified_tuner tuners[], int total_tuners, int highlight, bool all_tuners) {
+    uint32_t masks[MAX_DEVICES] = {0};
+
+    for (int i = 0; i < total_tuners; i++) {
+        if (!all_tuners && i != highlight) continue;
+        struct status_poller *poller = get_device_poller(&tuners[i]);
+        for (int d = 0; poller && d < device_poller_count; d++) {
+            if (device_pollers[d] == poller && tuners[i].tuner_index < STATUS_POLLER_MAX_TUNERS) {
+                masks[d] |= (1u << tuners[i].tuner_index);
+            }
+        }
+    }
+    for (int d = 0; d < device_poller_count; d++) {
+        status_poller_set_watch_mask(device_pollers[d], masks[d]);
+    }
+}
+
+/*
+ * draw_dashboard_pane
+ * Displays one summary row per tuner from the pollers' snapshots.
+ * Returns the total number of content lines, for scrolling purposes.
+ */
+int draw_dashboard_pane(WINDOW *win, struct unified_tuner tuners[], int total_tuners, int highlight, int scroll_offset) {
+    werase(win);
+    box(win, 0, 0);
+    mvwprintw(win, 0, 2, " All Tuners (%d) ", total_tuners);
+
+    wattron(win, A_BOLD);
+    print_line_in_box(win, 1, 2, "%-11s %-12s %-16s %4s %4s %4s %8s %s",
+                      "Tuner", "Channel", "Lock", "SS", "SNQ", "SEQ", "Mbps", "PLPs");
+    wattroff(win, A_BOLD);
+
+    struct tuner_status_snapshot snap;
+    int max_rows = getmaxy(win) - 5;
+    int first = scroll_offset;
+    if (highlight >= first + max_rows) first = highlight - max_rows + 1; // Keep the selection visible
+    if (highlight < first) first = highlight;
+    for (int i = first; i < total_tuners && i - first < max_rows; i++) {
+        int y = 2 + i - first;
+        struct status_poller *poller = get_device_poller(&tuners[i]);
+        char tuner_label[16];
+        snprintf(tuner_label, sizeof(tuner_label), "%08X-%d", tuners[i].device_id, tuners[i].tuner_index);
+
+        if (i == highlight) wattron(win, A_REVERSE);
+        if (status_poller_get_snapshot(poller, tuners[i].tuner_index, &snap) == 0) {
+            print_line_in_box(win, y, 2, "%-11s (waiting)", tuner_label);
+        } else if (!snap.valid) {
+            print_line_in_box(win, y, 2, "%-11s (no response)", tuner_label);
+        } else {
+            char plp_summary[24] = "-";  // Fits "<locked>/<total>" for any int, not just 64 PLPs
+            if (snap.has_plpinfo) {
+                int plp_total = 0, plp_locked = 0;
+                const char *line = snap.plpinfo;
+                while (line && *line) {
+                    const char *eol = strchr(line, '\n');
+                    if (isdigit((unsigned char)*line)) { // PLP lines start with "<id>:", skip "bsid="
+                        plp_total++;
+                        const char *lock = strstr(line, "lock=1");
+                        if (lock && (!eol || lock < eol)) plp_locked++;
+                    }
+                    line = eol ? eol + 1 : NULL;
+                }
+                snprintf(plp_summary, sizeof(plp_summary), "%d/%d", plp_locked, plp_total);
+            }
+
+            long bps = snap.fields.value[STATUS_KEY_BPS];
+            double mbps = (bps > 0) ? (double)bps / 1000000.0 : 0.0;
+
+            int color_pair = 1; // Red: no lock
+            if (strstr(snap.status.lock_str, "none") == NULL) {
+                color_pair = (snap.status.symbol_error_quality >= 100) ? 3 : 2;
+            }
+            wattron(win, COLOR_PAIR(color_pair));
+            print_line_in_box(win, y, 2, "%-11s %-12.12s %-16.16s %3u%% %3u%% %3u%% %8.3f %s",
+                              tuner_label, snap.status.channel, snap.status.lock_str,
+                              snap.status.signal_strength, snap.status.signal_to_noise_quality,
+                              snap.status.symbol_error_quality, mbps, plp_summary);
+            wattroff(win, COLOR_PAIR(color_pair));
+        }
+        if (i == highlight) wattroff(win, A_REVERSE);
+    }
+    return total_tuners + 1;
+}
+
 /*
  * compare_channels
  * A helper function for qsort to sort the channel list numerically.
@@ -645,23 +1044,26 @@ int compare_plps(const void *a, const void *b) {
 /*
  * populate_channel_list
  * Gets the tuner's channel map, parses it, and stores a sorted list of channels.
+ * Returns false if the device didn't answer.
  */
-void populate_channel_list(struct hdhomerun_device_t *hd, struct channel_list *list) {
+bool populate_channel_list(struct hdhomerun_device_t *hd, struct channel_list *list) {
     list->count = 0;
+    list->map[0] = '\0';
     char *map_str;
     log_debug("populate_channel_list: Getting channel map");
     int result = hdhomerun_device_get_tuner_channelmap(hd, &map_str);
     log_debug("populate_channel_list: get_tuner_channelmap returned %d", result);
     if (result <= 0) {
         log_debug("populate_channel_list: Failed to get channel map");
-        return;
+        return result == 0;
     }
     log_debug("populate_channel_list: Channel map: %s", map_str);
 
     char *map_copy = strdup(map_str);
-    if (!map_copy) return;
+    if (!map_copy) return true;
 
     char *token = strtok(map_copy, " ");
+    if (token) snprintf(list->map, sizeof(list->map), "%s", token);
     token = strtok(NULL, " "); 
 
     while (token != NULL && list->count < MAX_CHANNELS) {
@@ -671,6 +1073,35 @@ void populate_channel_list(struct hdhomerun_device_t *hd, struct channel_list *l
     free(map_copy);
     if (list->count > 0) qsort(list->channels, list->count, sizeof(unsigned int), compare_channels);
     log_debug("populate_channel_list: Populated %d channels", list->count);
+    return true;
+}
+
+/*
+ * record_scan_result
+ * Stores a seek probe in the scan db. TSID/BSID and PLPs aren't known yet
+ * at that point, so they are kept from the previous entry.
+ */
+static void record_scan_result(uint32_t device_id, const char *map, unsigned int channel, bool locked,
+                               const struct hdhomerun_tuner_status_t *status) {
+    if (!scan_db) return;
+
+    struct scan_db_entry entry;
+    const struct scan_db_entry *old = scan_db_find(scan_db, device_id, map, channel);
+    if (old && locked) {
+        entry = *old;
+    } else {
+        memset(&entry, 0, sizeof(entry));
+        entry.tsid = entry.bsid = STATUS_VALUE_NONE;
+    }
+    entry.device_id = device_id;
+    snprintf(entry.channelmap, sizeof(entry.channelmap), "%s", map);
+    entry.channel = channel;
+    entry.last_scan = time(NULL);
+    entry.locked = locked;
+    entry.ss = status->signal_strength;
+    entry.snq = status->signal_to_noise_quality;
+    entry.seq = status->symbol_error_quality;
+    scan_db_record(scan_db, &entry);
 }
 
 /*
@@ -689,17 +1120,23 @@ int show_help_screen(WINDOW *parent_win) {
         "  PgUp/PgDn    : Scroll status panel if content overflows.",
         "  Lf/Rt Arrows : Change channel.",
         "  +/- Keys     : Seek for next/previous active channel.",
+        "  b            : Scan the channel list on all idle tuners of this device.",
+        "  B            : Scan the channel list on all idle tuners of every device.",
         "  v            : View stream in VLC (select program for ATSC 1.0).",
         "  d (ATSC 3.0) : Show detailed PLP information and SNR requirements.",
         "  c            : Manually tune to a channel/frequency.",
         "  m            : Change the tuner's channel map.",
         "  p            : Set the tuned ATSC 3.0 PLPs.",
-        "  s (ATSC 1.0) : Save a 30-second transport stream capture.",
-        "  s (ATSC 3.0) : Save a 30-second debug capture.",
-        "  a (ATSC 1.0) : Save a 30-second TS capture with error checking.",
-        "  a (ATSC 3.0) : Save a 30-second DBG capture with error checking.",
-        "  x (ATSC 3.0) : Save a 30-second PCAP capture, if supported.",
-        "  z (ATSC 3.0) : Save a 30-second PCAP capture with error checking.",
+        "  o            : Toggle the all-tuners dashboard.",
+        "  s (ATSC 1.0) : Save a transport stream capture (30 s, see -t).",
+        "  s (ATSC 3.0) : Save a debug capture.",
+        "  a (ATSC 1.0) : Save a TS capture with error checking.",
+        "  a (ATSC 3.0) : Save a DBG capture with error checking.",
+        "  x (ATSC 3.0) : Save a PCAP capture, if supported.",
+        "  z (ATSC 3.0) : Save a PCAP capture with error checking.",
+        "  l            : Continuous ring capture; keeps segments around errors.",
+        "  e            : Capture all locked tuners on this device at once.",
+        "  E            : Capture all locked tuners on every device at once.",
         "  Backspace    : During a save, press Backspace to abort.",
         "  r            : Refresh the device list.",
         "  h            : Show this help screen.",
@@ -770,160 +1207,178 @@ int show_help_screen(WINDOW *parent_win) {
     }
 }
 
+// Capture loop cadence: redraws and autorestart status checks are throttled
+// so draining the socket always comes first
+#define CAPTURE_UI_INTERVAL_MS 250
+#define CAPTURE_CHECK_DELAY_MS 2000
+#define CAPTURE_CHECK_INTERVAL_MS 1000
+
+// CPU for the capture is counted on the thread running it, so the status
+// pollers and other workers aren't charged to it
+#ifdef RUSAGE_THREAD
+#define CAPTURE_RUSAGE_WHO RUSAGE_THREAD
+#else
+#define CAPTURE_RUSAGE_WHO RUSAGE_SELF
+#endif
+
 /*
  * http_save_stream
  * Performs a download of an HTTP stream using native sockets, replacing wget.
  * Returns 0 on success, -1 on failure.
  */
-int http_save_stream(const char *ip_addr, const char *url, const char *filename, WINDOW *win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info, bool autorestart_enabled, int save_attempts, int max_save_attempts, bool *out_aborted, bool *out_error_detected, bool debug_enabled) {
+int http_save_stream(const char *ip_addr, const char *url, const char *filename, WINDOW *win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info, bool autorestart_enabled, int save_attempts, int max_save_attempts, bool *out_aborted, bool *out_error_detected, bool debug_enabled, struct pretrigger_buffer *pretrigger) {
     *out_aborted = false;
     *out_error_detected = false;
 
-    // 1. Create and connect socket
-    int sock = socket(AF_INET, SOCK_STREAM, 0);
-    int rcvbuf_size = 2 * 1024 * 1024;
-    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf_size, sizeof(rcvbuf_size));
-    if (sock < 0) {
-        print_line_in_box(win, LINES - 3, 2, "Error: Could not create socket."); wrefresh(win); sleep(2);
-        return -1;
-    }
-
-    struct sockaddr_in serv_addr;
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    serv_addr.sin_port = htons(5004);
-    if (inet_pton(AF_INET, ip_addr, &serv_addr.sin_addr) <= 0) {
-        print_line_in_box(win, LINES - 3, 2, "Error: Invalid IP address."); wrefresh(win); sleep(2);
-        close(sock);
-        return -1;
-    }
-
-    if (connect(sock, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0) {
-        print_line_in_box(win, LINES - 3, 2, "Error: Could not connect to device."); wrefresh(win); sleep(2);
-        close(sock);
-        return -1;
-    }
-
-    // 2. Send HTTP GET request
-    const char *path_start = strstr(url, "/tuner");
-    if (!path_start) {
-        print_line_in_box(win, LINES - 3, 2, "Error: Invalid URL for request."); wrefresh(win); sleep(2);
-        close(sock);
-        return -1;
-    }
-    char request[512];
-    snprintf(request, sizeof(request), "GET %s HTTP/1.0\r\nHost: %s\r\nConnection: close\r\n\r\n", path_start, ip_addr);
-    if (send(sock, request, strlen(request), 0) < 0) {
-        print_line_in_box(win, LINES - 3, 2, "Error: Failed to send request."); wrefresh(win); sleep(2);
-        close(sock);
-        return -1;
-    }
-
-    // 3. Open output file
-    FILE *f = fopen(filename, "wb");
-    if (!f) {
-        print_line_in_box(win, LINES - 3, 2, "Error: Failed to open file for writing."); wrefresh(win); sleep(2);
-        close(sock);
+    // 1. Connect, send the request and open the output file
+    char err[128];
+    struct capture_session *session = capture_session_open(ip_addr, url, filename, err, sizeof(err));
+    if (!session) {
+        print_line_in_box(win, LINES - 3, 2, "Error: %s", err); wrefresh(win); sleep(2);
         return -1;
     }
+    capture_session_set_tap(session, pretrigger);
 
-    // 4. Receive data in a non-blocking loop
-    fcntl(sock, F_SETFL, O_NONBLOCK);
+    // 2. Receive data
     struct timespec start_time, current_time;
     clock_gettime(CLOCK_MONOTONIC, &start_time);
     long elapsed_ms = 0;
-    bool headers_processed = false;
-    char buffer[65536]; // Increased buffer size
-    
-    while (elapsed_ms < 30000) {
+    struct rusage usage_start;
+    getrusage(CAPTURE_RUSAGE_WHO, &usage_start);
+
+    // Capture I/O drives the loop: it sleeps in poll() until the socket or
+    // keyboard is ready, and the redraw and autorestart status query only
+    // run on their own fixed cadence
+    long next_ui_ms = 0;
+    long next_check_ms = CAPTURE_CHECK_DELAY_MS;
+    long stop_ms = capture_duration_ms;
+
+    while (elapsed_ms < stop_ms) {
         clock_gettime(CLOCK_MONOTONIC, &current_time);
         elapsed_ms = (current_time.tv_sec - start_time.tv_sec) * 1000 + (current_time.tv_nsec - start_time.tv_nsec) / 1000000;
-        long remaining_s = (30000 - elapsed_ms) / 1000;
-        if (remaining_s < 0) remaining_s = 0;
-
-        // Update UI
-        draw_status_pane(win, hd, tuner_info, 0);
-        mvwhline(win, LINES - 5, 1, ' ', getmaxx(win) - 2);
-        mvwhline(win, LINES - 4, 1, ' ', getmaxx(win) - 2);
-        mvwhline(win, LINES - 3, 1, ' ', getmaxx(win) - 2);
-        
-        if (debug_enabled) {
-            print_line_in_box(win, LINES - 5, 2, "URL: %s", url);
-        }
-        print_line_in_box(win, LINES - 4, 2, "Saving to %s... %lds remaining.", filename, remaining_s);
-        if (autorestart_enabled) {
-            print_line_in_box(win, LINES - 3, 2, "Press Backspace to stop. (Attempt %d/%d)", save_attempts, max_save_attempts);
-        } else {
-            print_line_in_box(win, LINES - 3, 2, "Press Backspace to stop.");
-        }
-        wrefresh(win);
 
-        // Check for user abort
-        int ch = getch();
-        if (ch == KEY_BACKSPACE) {
-            *out_aborted = true;
-            break;
+        if (elapsed_ms >= next_ui_ms) {
+            next_ui_ms = elapsed_ms + CAPTURE_UI_INTERVAL_MS;
+            long remaining_s = (capture_duration_ms - elapsed_ms) / 1000;
+            if (remaining_s < 0) remaining_s = 0;
+
+            draw_status_pane(win, active_poller, tuner_info, 0);
+            mvwhline(win, LINES - 5, 1, ' ', getmaxx(win) - 2);
+            mvwhline(win, LINES - 4, 1, ' ', getmaxx(win) - 2);
+            mvwhline(win, LINES - 3, 1, ' ', getmaxx(win) - 2);
+            
+            if (debug_enabled) {
+                print_line_in_box(win, LINES - 5, 2, "URL: %s", url);
+            }
+            print_line_in_box(win, LINES - 4, 2, "Saving to %s... %lds remaining.", filename, remaining_s);
+            if (autorestart_enabled) {
+                print_line_in_box(win, LINES - 3, 2, "Press Backspace to stop. (Attempt %d/%d)", save_attempts, max_save_attempts);
+            } else {
+                print_line_in_box(win, LINES - 3, 2, "Press Backspace to stop.");
+            }
+            wrefresh(win);
         }
 
         // Check for signal errors if autorestart is on
-        if (autorestart_enabled && (elapsed_ms >= 2000)) {
+        if (autorestart_enabled && !*out_error_detected && elapsed_ms >= next_check_ms) {
+            next_check_ms = elapsed_ms + CAPTURE_CHECK_INTERVAL_MS;
             struct hdhomerun_tuner_status_t current_status;
             char *current_raw_status;
             if (hdhomerun_device_get_tuner_status(hd, &current_raw_status, &current_status) > 0) {
                 if (current_status.symbol_error_quality < 100) {
                     *out_error_detected = true;
-                    break;
+                    if (!pretrigger || posttrigger_seconds <= 0) break;
+                    // Keep going a little so the event clip shows what followed
+                    pretrigger_buffer_trigger(pretrigger);
+                    if (elapsed_ms + posttrigger_seconds * 1000L < stop_ms) stop_ms = elapsed_ms + posttrigger_seconds * 1000L;
                 }
             }
         }
 
-        // Receive data from socket
-        int bytes_read = recv(sock, buffer, sizeof(buffer), 0);
-        if (bytes_read > 0) {
-            char *data_to_write = buffer;
-            int len_to_write = bytes_read;
-            if (!headers_processed) {
-                char *body_start = strstr(buffer, "\r\n\r\n");
-                if (body_start) {
-                    body_start += 4; // Move pointer past the CRLFCRLF
-                    len_to_write = bytes_read - (body_start - buffer);
-                    data_to_write = body_start;
-                    headers_processed = true;
-                } else {
-                    // Headers not fully received in this chunk, so write nothing yet
-                    len_to_write = 0;
-                }
-            }
-            if (len_to_write > 0) {
-                fwrite(data_to_write, 1, len_to_write, f);
-            }
-        } else if (bytes_read == 0) {
-            // Connection closed by server, successful completion
-            break;
-        } else { // bytes_read < 0
-            if (errno != EWOULDBLOCK && errno != EAGAIN) {
-                // A real error occurred
+        long wait_ms = next_ui_ms - elapsed_ms;
+        if (autorestart_enabled && !*out_error_detected && next_check_ms - elapsed_ms < wait_ms) wait_ms = next_check_ms - elapsed_ms;
+        if (stop_ms - elapsed_ms < wait_ms) wait_ms = stop_ms - elapsed_ms;
+        if (wait_ms < 0) wait_ms = 0;
+
+        struct pollfd fds[2] = {
+            { capture_session_fd(session), POLLIN, 0 },
+            { STDIN_FILENO, POLLIN, 0 },
+        };
+        int ready = poll(fds, 2, (int)wait_ms);
+        if (ready < 0 && errno != EINTR) break;
+
+        // Check for user abort
+        if (ready > 0 && (fds[1].revents & POLLIN)) {
+            if (getch() == KEY_BACKSPACE) {
+                *out_aborted = true;
                 break;
             }
-            // No data right now, just loop again
+        }
+
+        if (ready > 0 && (fds[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+            // 0 means the device closed the stream (successful completion), -1 a real error
+            if (capture_session_pump(session) <= 0) break;
         }
     }
 
-    fclose(f);
-    close(sock);
+    if (verbose_mode) {
+        struct rusage usage_end;
+        getrusage(CAPTURE_RUSAGE_WHO, &usage_end);
+        double cpu_s = (usage_end.ru_utime.tv_sec - usage_start.ru_utime.tv_sec) + (usage_end.ru_stime.tv_sec - usage_start.ru_stime.tv_sec)
+                     + ((usage_end.ru_utime.tv_usec - usage_start.ru_utime.tv_usec) + (usage_end.ru_stime.tv_usec - usage_start.ru_stime.tv_usec)) / 1e6;
+        uint64_t total_bytes = capture_session_bytes(session);
+        double mb = total_bytes / (1024.0 * 1024.0);
+        log_debug("Capture %s: %.2f MB in %.1f s (%.2f Mbps), CPU %.3f s (%.2f ms/MB) via %s",
+                  filename, mb, elapsed_ms / 1000.0, elapsed_ms > 0 ? total_bytes * 8.0 / (elapsed_ms * 1000.0) : 0.0,
+                  cpu_s, mb > 0 ? cpu_s * 1000.0 / mb : 0.0, capture_session_method(session));
+    }
+
+    capture_session_close(session);
     return 0;
 }
 
 
+/*
+ * save_pretrigger_clip
+ * Called when an autorestart save hits an error: writes the buffered
+ * seconds around the error to "<name>-event<ext>" and removes the partial
+ * capture. A details file, if any, follows the clip or is removed with it.
+ * Returns true if a clip was written.
+ */
+static bool save_pretrigger_clip(struct pretrigger_buffer *pretrigger, const char *filename) {
+    const char *last_dot = strrchr(filename, '.');
+    int base_len = last_dot ? (int)(last_dot - filename) : (int)strlen(filename);
+    char clip_filename[512], details_filename[512], clip_details_filename[512];
+    snprintf(clip_filename, sizeof(clip_filename), "%.*s-event%s", base_len, filename, last_dot ? last_dot : "");
+    snprintf(details_filename, sizeof(details_filename), "%.*s.txt", base_len, filename);
+    snprintf(clip_details_filename, sizeof(clip_details_filename), "%.*s-event.txt", base_len, filename);
+
+    long saved = pretrigger_buffer_save(pretrigger, clip_filename);
+    pretrigger_buffer_reset(pretrigger);
+    remove(filename);
+    if (saved > 0) {
+        log_debug("Autorestart: saved %ld byte pre-trigger clip to %s", saved, clip_filename);
+        rename(details_filename, clip_details_filename);
+        return true;
+    }
+    remove(details_filename);
+    return false;
+}
+
 /*
  * save_stream
- * Saves a 30-second transport stream capture to a file.
+ * Saves a timed (default 30-second) capture to a file.
  */
 char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mode, struct unified_tuner *tuner_info, bool debug_enabled) {
+    // The preamble below and the details sidecar read the same variables; fetch each once
+    struct query_cache *qc = query_cache_create(QUERY_CACHE_DEFAULT_TTL_MS);
+    char *result_str = NULL;
+
     struct hdhomerun_tuner_status_t status;
     char *raw_status_str;
-    if (hdhomerun_device_get_tuner_status(hd, &raw_status_str, &status) <= 0) {
+    if (query_cache_get_tuner_status(qc, hd, &raw_status_str, &status) <= 0) {
         print_line_in_box(win, LINES - 3, 2, "Failed to get tuner status."); wrefresh(win); sleep(2);
+        query_cache_destroy(qc);
         return NULL;
     }
 
@@ -933,13 +1388,18 @@ char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mod
 
     if (strstr(status.lock_str, "none") != NULL) {
         print_line_in_box(win, LINES - 3, 2, "No signal lock. Cannot save stream."); wrefresh(win); sleep(2);
+        query_cache_destroy(qc);
         return NULL;
     }
 
     bool is_pcap = (mode == SAVE_NORMAL_PCAP || mode == SAVE_AUTORESTART_PCAP);
     if (is_pcap) {
-        if (parse_db_value(raw_status_str, "ss=") == -999) {
+        struct status_fields status_fields;
+        status_fields_init(&status_fields);
+        status_fields_parse(&status_fields, raw_status_str);
+        if (status_fields.db[STATUS_KEY_SS] == STATUS_VALUE_NONE) {
             print_line_in_box(win, LINES - 3, 2, "PCAP capture not available on this device model."); wrefresh(win); sleep(2);
+            query_cache_destroy(qc);
             return NULL;
         }
     }
@@ -951,22 +1411,28 @@ char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mod
 
     long id_val = 0;
     char *streaminfo;
-    if (hdhomerun_device_get_tuner_streaminfo(hd, &streaminfo) > 0) {
-        long parsed_id = parse_status_value(streaminfo, "tsid=");
+    if (query_cache_get_tuner_streaminfo(qc, hd, &streaminfo) > 0) {
+        long parsed_id = status_fields_lookup(streaminfo, STATUS_KEY_TSID);
         if (parsed_id != -999) id_val = parsed_id;
     }
     
     bool is_atsc3 = (strstr(status.lock_str, "atsc3") != NULL);
     if (is_atsc3) {
         char *plpinfo;
-        if (hdhomerun_device_get_tuner_plpinfo(hd, &plpinfo) > 0) {
-            long bsid = parse_status_value(plpinfo, "bsid=");
+        if (query_cache_get_tuner_plpinfo(qc, hd, &plpinfo) > 0) {
+            long bsid = status_fields_lookup(plpinfo, STATUS_KEY_BSID);
             if (bsid != -999) id_val = bsid;
         }
     }
 
     bool autorestart_enabled = (mode == SAVE_AUTORESTART_TS || mode == SAVE_AUTORESTART_DBG || mode == SAVE_AUTORESTART_PCAP);
-    char *result_str = NULL;
+
+    // Autorestart saves keep the last few seconds in memory so an error
+    // leaves an event clip behind instead of nothing
+    enum pretrigger_format clip_format = !is_atsc3 ? PRETRIGGER_TS : (is_pcap ? PRETRIGGER_PCAP : PRETRIGGER_RAW);
+    struct pretrigger_buffer *pretrigger = autorestart_enabled ? pretrigger_buffer_create(pretrigger_seconds, clip_format) : NULL;
+    int clips_saved = 0;
+    uint64_t dropped_bytes = 0;     // Across autorestarts, for the result line
 
     // --- ATSC 3.0 Capture Logic ---
     if (is_atsc3) {
@@ -981,7 +1447,7 @@ char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mod
             bool plps_locked = false;
             for (int retry = 0; retry < 4; retry++) { // Initial attempt + 3 retries
                 char *plpinfo;
-                if (hdhomerun_device_get_tuner_plpinfo(hd, &plpinfo) > 0) {
+                if (query_cache_get_tuner_plpinfo(qc, hd, &plpinfo) > 0) {
                     char *plpinfo_copy = strdup(plpinfo);
                     if (plpinfo_copy) {
                         char *line = strtok(plpinfo_copy, "\n");
@@ -1035,22 +1501,15 @@ char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mod
             bool error_detected = false;
 
             if (!error_detected) {
-                save_atsc3_details_auto(hd, tuner_info->tuner_index, filename);
+                save_atsc3_details_auto(hd, tuner_info->tuner_index, filename, qc, get_l1_tracker(tuner_info));
             }
             
             // Call the native HTTP download function instead of fork/wget
-            http_save_stream(tuner_info->ip_str, url, filename, win, hd, tuner_info, autorestart_enabled, save_attempts, max_save_attempts, &aborted, &error_detected, debug_enabled);
+            http_save_stream(tuner_info->ip_str, url, filename, win, hd, tuner_info, autorestart_enabled, save_attempts, max_save_attempts, &aborted, &error_detected, debug_enabled, pretrigger);
 
             if (autorestart_enabled && error_detected && save_attempts < max_save_attempts) {
-                remove(filename);
-                // Also remove details file if it was created
-                char details_filename[512];
-                const char* last_dot = strrchr(filename, '.');
-                if (last_dot) {
-                    size_t base_len = last_dot - filename;
-                    snprintf(details_filename, sizeof(details_filename), "%.*s.txt", (int)base_len, filename);
-                    remove(details_filename);
-                }
+                // Keeps the details file alongside the clip, or removes it
+                if (save_pretrigger_clip(pretrigger, filename)) clips_saved++;
                 mvwhline(win, LINES - 4, 1, ' ', getmaxx(win) - 2);
                 mvwhline(win, LINES - 3, 1, ' ', getmaxx(win) - 2);
                 print_line_in_box(win, LINES - 4, 2, "Symbol Quality error. Restarting capture in 1s... (Attempt %d/%d)", save_attempts, max_save_attempts); wrefresh(win);
@@ -1059,21 +1518,15 @@ char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mod
                 hdhomerun_device_set_tuner_channel(hd, original_channel);
                 struct hdhomerun_tuner_status_t lock_status;
                 hdhomerun_device_wait_for_lock(hd, &lock_status);
+                query_cache_invalidate(qc);
                 
                 sleep(1);
                 continue; // Continue the while loop to retry
             } else if (autorestart_enabled && error_detected && save_attempts >= max_save_attempts) {
-                remove(filename);
-                // Also remove details file if it was created
-                char details_filename[512];
-                const char* last_dot = strrchr(filename, '.');
-                if (last_dot) {
-                    size_t base_len = last_dot - filename;
-                    snprintf(details_filename, sizeof(details_filename), "%.*s.txt", (int)base_len, filename);
-                    remove(details_filename);
-                }
+                if (save_pretrigger_clip(pretrigger, filename)) clips_saved++;
                 result_str = (char*)malloc(512);
-                sprintf(result_str, "Signal too unstable. Failed after %d attempts.", max_save_attempts);
+                sprintf(result_str, "Signal too unstable. Failed after %d attempts.\n%d error clip%s saved (*-event files).",
+                        max_save_attempts, clips_saved, clips_saved == 1 ? "" : "s");
                 break;
             }
             
@@ -1090,6 +1543,8 @@ char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mod
     }
 
     // --- ATSC 1.0 Capture Logic ---
+    query_cache_destroy(qc);
+    qc = NULL;
     while(1) {
         char filename[128];
         char time_str[20];
@@ -1102,95 +1557,146 @@ char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mod
 
         char debug_path[64];
         sprintf(debug_path, "/tuner%d/debug", tuner_info->tuner_index);
-        char *debug_str;
-        hdhomerun_device_get_var(hd, debug_path, &debug_str, NULL);
-        long start_te = parse_status_value(debug_str, "te=");
-        long start_ne = parse_status_value(debug_str, "ne=");
-        long start_se = parse_status_value(debug_str, "se=");
+        struct status_fields debug_fields;
+        read_debug_fields(hd, debug_path, &debug_fields);
+        long start_te = debug_fields.value[STATUS_KEY_TE];
+        long start_ne = debug_fields.value[STATUS_KEY_NE];
+        long start_se = debug_fields.value[STATUS_KEY_SE];
 
         if (hdhomerun_device_stream_start(hd) <= 0) {
             print_line_in_box(win, LINES - 3, 2, "Failed to start stream."); wrefresh(win); sleep(2);
+            pretrigger_buffer_destroy(pretrigger);
             return NULL;
         }
 
+        // File I/O runs on a writer thread so a slow disk can't back up
+        // the device's video buffer
         FILE *f = fopen(filename, "wb");
-        if (!f) {
+        struct ts_writer *writer = ts_writer_start(f);
+        if (!writer) {
+            if (f) fclose(f);
             hdhomerun_device_stream_stop(hd);
             print_line_in_box(win, LINES - 3, 2, "Failed to open file for writing."); wrefresh(win); sleep(2);
+            pretrigger_buffer_destroy(pretrigger);
             return NULL;
         }
 
+        // The error counters are read on a helper thread with its own
+        // control connection, so a slow reply can't stall stream_recv
+        struct counter_watch *watch = autorestart_enabled ?
+            counter_watch_start(tuner_info->ip_str, tuner_info->tuner_index, CAPTURE_CHECK_INTERVAL_MS) : NULL;
+        uint64_t last_reading = 0;
+
         struct timespec start_time, current_time;
         clock_gettime(CLOCK_MONOTONIC, &start_time);
         long elapsed_ms = 0;
+        long next_ui_ms = 0;
+        long stop_ms = capture_duration_ms;
         bool error_detected = false;
         bool aborted = false;
         unsigned long long total_bytes = 0;
 
-        while(elapsed_ms < 30000) {
+        while(elapsed_ms < stop_ms) {
             clock_gettime(CLOCK_MONOTONIC, &current_time);
             elapsed_ms = (current_time.tv_sec - start_time.tv_sec) * 1000 + (current_time.tv_nsec - start_time.tv_nsec) / 1000000;
-            long remaining_s = (30000 - elapsed_ms) / 1000;
-            if (remaining_s < 0) remaining_s = 0;
-
-            mvwhline(win, LINES - 4, 1, ' ', getmaxx(win) - 2);
-            mvwhline(win, LINES - 3, 1, ' ', getmaxx(win) - 2);
-            print_line_in_box(win, LINES - 4, 2, "Saving to %s... %lds remaining.", filename, remaining_s);
-            print_line_in_box(win, LINES - 3, 2, "Press Backspace to stop.");
-            wrefresh(win);
 
             size_t actual_size;
             uint8_t *video_data = hdhomerun_device_stream_recv(hd, VIDEO_DATA_BUFFER_SIZE_1S, &actual_size);
 
             if (video_data && actual_size > 0) {
-                fwrite(video_data, 1, actual_size, f);
+                ts_writer_submit(writer, video_data, actual_size);
+                pretrigger_buffer_append(pretrigger, video_data, actual_size);
                 total_bytes += actual_size;
             }
 
-            if (autorestart_enabled) {
-                hdhomerun_device_get_var(hd, debug_path, &debug_str, NULL);
-                long current_te = parse_status_value(debug_str, "te=");
-                long current_ne = parse_status_value(debug_str, "ne=");
-                long current_se = parse_status_value(debug_str, "se=");
+            if (elapsed_ms >= next_ui_ms) {
+                next_ui_ms = elapsed_ms + CAPTURE_UI_INTERVAL_MS;
+                long remaining_s = (capture_duration_ms - elapsed_ms) / 1000;
+                if (remaining_s < 0) remaining_s = 0;
 
+                mvwhline(win, LINES - 4, 1, ' ', getmaxx(win) - 2);
+                mvwhline(win, LINES - 3, 1, ' ', getmaxx(win) - 2);
+                print_line_in_box(win, LINES - 4, 2, "Saving to %s... %lds remaining.", filename, remaining_s);
+                if (ts_writer_bytes_dropped(writer) > 0) {
+                    print_line_in_box(win, LINES - 3, 2, "Press Backspace to stop. Disk too slow: %.2f MB dropped",
+                                      ts_writer_bytes_dropped(writer) / (1024.0 * 1024.0));
+                } else {
+                    print_line_in_box(win, LINES - 3, 2, "Press Backspace to stop.");
+                }
+                wrefresh(win);
+            }
+
+            long current_te, current_ne, current_se;
+            uint64_t reading = counter_watch_get(watch, &current_te, &current_ne, &current_se);
+            if (!error_detected && reading != last_reading) {
+                last_reading = reading;
                 if (current_te > start_te || current_ne > start_ne || current_se > start_se) {
                     error_detected = true;
-                    break;
+                    if (!pretrigger || posttrigger_seconds <= 0) break;
+                    // Keep going a little so the event clip shows what followed
+                    pretrigger_buffer_trigger(pretrigger);
+                    if (elapsed_ms + posttrigger_seconds * 1000L < stop_ms) stop_ms = elapsed_ms + posttrigger_seconds * 1000L;
                 }
             }
-            if (getch() == KEY_BACKSPACE) {
+
+            // Nothing buffered yet: wait on the keyboard briefly instead of spinning
+            struct pollfd key_fd = { STDIN_FILENO, POLLIN, 0 };
+            if (poll(&key_fd, 1, video_data ? 0 : 15) > 0 && getch() == KEY_BACKSPACE) {
                 aborted = true;
                 break;
             }
         }
 
-        fclose(f);
         hdhomerun_device_stream_stop(hd);
+        counter_watch_stop(watch);
+        struct ts_writer_stats writer_stats;
+        ts_writer_finish(writer, &writer_stats);
+        dropped_bytes += writer_stats.bytes_dropped;
+        log_debug("ATSC 1.0 capture %s: %llu bytes written, %llu dropped, writer queue peaked at %d/%d buffers",
+                  filename, (unsigned long long)writer_stats.bytes_written, (unsigned long long)writer_stats.bytes_dropped,
+                  writer_stats.max_depth, TS_WRITER_BUFFER_COUNT);
         
         if (aborted) {
+            pretrigger_buffer_destroy(pretrigger);
             result_str = (char*)malloc(512);
-            sprintf(result_str, "Save aborted. Partial file %s may remain.", filename);
+            if (dropped_bytes > 0) {
+                sprintf(result_str, "Save aborted. Partial file %s may remain.\n%.2f MB dropped (disk too slow)",
+                        filename, (double)dropped_bytes / (1024*1024));
+            } else {
+                sprintf(result_str, "Save aborted. Partial file %s may remain.", filename);
+            }
             
             // ATSC 1.0 doesn't need restoration - tuner continues running
             return result_str;
         }
 
-        hdhomerun_device_get_var(hd, debug_path, &debug_str, NULL);
-        long end_te = parse_status_value(debug_str, "te=");
-        long end_ne = parse_status_value(debug_str, "ne=");
-        long end_se = parse_status_value(debug_str, "se=");
+        read_debug_fields(hd, debug_path, &debug_fields);
+        long end_te = debug_fields.value[STATUS_KEY_TE];
+        long end_ne = debug_fields.value[STATUS_KEY_NE];
+        long end_se = debug_fields.value[STATUS_KEY_SE];
 
         if (autorestart_enabled && error_detected) {
-            remove(filename);
+            if (save_pretrigger_clip(pretrigger, filename)) clips_saved++;
             print_line_in_box(win, LINES - 4, 2, "Error detected. Restarting capture in 1s..."); wrefresh(win);
             sleep(1);
             continue;
         }
         
+        pretrigger_buffer_destroy(pretrigger);
         result_str = (char*)malloc(512);
-        sprintf(result_str, "Saved %.2f MB to %s\nErrors: %ld transport, %ld network, %ld sequence", 
-            (double)total_bytes / (1024*1024), filename,
-            end_te - start_te, end_ne - start_ne, end_se - start_se);
+        if (dropped_bytes > 0) {
+            // Includes drops in earlier files of an autorestart run
+            sprintf(result_str, "Saved %.2f MB to %s, %.2f MB dropped (disk too slow)\nErrors: %ld transport, %ld network, %ld sequence",
+                (double)total_bytes / (1024*1024), filename, (double)dropped_bytes / (1024*1024),
+                end_te - start_te, end_ne - start_ne, end_se - start_se);
+        } else if (clips_saved > 0) {
+            sprintf(result_str, "Saved %.2f MB to %s after %d error clip%s (*-event.ts)",
+                (double)total_bytes / (1024*1024), filename, clips_saved, clips_saved == 1 ? "" : "s");
+        } else {
+            sprintf(result_str, "Saved %.2f MB to %s\nErrors: %ld transport, %ld network, %ld sequence", 
+                (double)total_bytes / (1024*1024), filename,
+                end_te - start_te, end_ne - start_ne, end_se - start_se);
+        }
         
         // ATSC 1.0 doesn't need restoration - tuner continues running
         return result_str;
@@ -1204,10 +1710,607 @@ char* save_stream(struct hdhomerun_device_t *hd, WINDOW *win, enum save_mode mod
         hdhomerun_device_set_tuner_channel(hd, original_channel);
         struct hdhomerun_tuner_status_t lock_status;
         hdhomerun_device_wait_for_lock(hd, &lock_status);
+        query_cache_destroy(qc);
+        pretrigger_buffer_destroy(pretrigger);
         
         return result_str; // May be NULL if there was an early error
     }
 
+/*
+ * build_capture_job
+ * Fills a parallel-capture job for a tuner if it currently has a lock,
+ * using the same URL and file naming as save_stream. ATSC 3.0 tuners get
+ * a debug capture of their locked PLPs plus the details sidecar.
+ * Returns true if the tuner should be captured.
+ */
+static bool build_capture_job(struct unified_tuner *tuner_info, struct capture_job *job) {
+    // Shared with the main loop; it sets its own tuner again on the next pass
+    struct hdhomerun_device_t *hd = device_pool_get(device_pool, tuner_info->device_id, tuner_info->ip_str);
+    if (!hd) return false;
+    hdhomerun_device_set_tuner(hd, tuner_info->tuner_index);
+    struct query_cache *qc = query_cache_create(QUERY_CACHE_DEFAULT_TTL_MS);
+
+    bool ok = false;
+    struct hdhomerun_tuner_status_t status;
+    char *raw_status_str;
+    if (query_cache_get_tuner_status(qc, hd, &raw_status_str, &status) > 0 && strstr(status.lock_str, "none") == NULL) {
+        unsigned int rf_channel = 0;
+        char *p = strchr(status.channel, ':');
+        if (!p) p = status.channel; else p++;
+        if (isdigit((unsigned char)*p)) rf_channel = strtoul(p, NULL, 10);
+
+        memset(job, 0, sizeof(*job));
+        job->device_id = tuner_info->device_id;
+        job->tuner_index = tuner_info->tuner_index;
+        snprintf(job->ip_str, sizeof(job->ip_str), "%s", tuner_info->ip_str);
+        strncpy(job->restore_channel, status.channel, sizeof(job->restore_channel) - 1);
+        job->duration_ms = capture_duration_ms;
+
+        char time_str[20];
+        time_t now = time(NULL);
+        strftime(time_str, sizeof(time_str), "%Y%m%d-%H%M%S", localtime(&now));
+
+        char *info;
+        if (strstr(status.lock_str, "atsc3") != NULL) {
+            long bsid = 0;
+            char plp_str[128] = {0};
+            if (query_cache_get_tuner_plpinfo(qc, hd, &info) > 0) {
+                long parsed = status_fields_lookup(info, STATUS_KEY_BSID);
+                if (parsed != -999) bsid = parsed;
+                const char *line = info;
+                while (line && *line) {
+                    const char *eol = strchr(line, '\n');
+                    const char *lock = strstr(line, "lock=1");
+                    int plp_id;
+                    if (lock && (!eol || lock < eol) && sscanf(line, "%d:", &plp_id) == 1 && strlen(plp_str) < sizeof(plp_str) - 8) {
+                        sprintf(plp_str + strlen(plp_str), "p%d", plp_id);
+                    }
+                    line = eol ? eol + 1 : NULL;
+                }
+            }
+            if (plp_str[0]) {
+                snprintf(job->filename, sizeof(job->filename), "rf%u-bsid%ld-%s-%s-%08X-%d.dbg",
+                         rf_channel, bsid, plp_str, time_str, job->device_id, job->tuner_index);
+                snprintf(job->url, sizeof(job->url), "http://%s:5004/tuner%d/ch%u%s?format=dbg",
+                         job->ip_str, job->tuner_index, rf_channel, plp_str);
+                save_atsc3_details_auto(hd, job->tuner_index, job->filename, qc, get_l1_tracker(tuner_info));
+                ok = true;
+            }
+        } else {
+            long tsid = 0;
+            if (query_cache_get_tuner_streaminfo(qc, hd, &info) > 0) {
+                long parsed = status_fields_lookup(info, STATUS_KEY_TSID);
+                if (parsed != -999) tsid = parsed;
+            }
+            snprintf(job->filename, sizeof(job->filename), "rf%u-tsid%ld-%s-%08X-%d.ts",
+                     rf_channel, tsid, time_str, job->device_id, job->tuner_index);
+            snprintf(job->url, sizeof(job->url), "http://%s:5004/tuner%d/ch%u",
+                     job->ip_str, job->tuner_index, rf_channel);
+            ok = true;
+        }
+    }
+
+    query_cache_destroy(qc);
+    return ok;
+}
+
+/*
+ * capture_locked_tuners
+ * Captures every locked tuner on the selected device (or on all devices)
+ * at the same time, showing one progress row per session.
+ * Returns a summary message for the status pane, or NULL if nothing ran.
+ */
+char* capture_locked_tuners(WINDOW *parent_win, struct unified_tuner tuners[], int total_tuners, int highlight, bool all_devices) {
+    struct capture_job *jobs = calloc(CAPTURE_ENGINE_MAX_JOBS, sizeof(struct capture_job));
+    if (!jobs) return NULL;
+
+    print_line_in_box(parent_win, LINES - 3, 2, "Preparing captures...");
+    wrefresh(parent_win);
+
+    int job_count = 0;
+    for (int i = 0; i < total_tuners && job_count < CAPTURE_ENGINE_MAX_JOBS; i++) {
+        if (!all_devices && tuners[i].device_id != tuners[highlight].device_id) continue;
+        if (build_capture_job(&tuners[i], &jobs[job_count])) {
+            log_debug("Capture engine: queued %08X-%d -> %s", jobs[job_count].device_id, jobs[job_count].tuner_index, jobs[job_count].filename);
+            job_count++;
+        }
+    }
+    if (job_count == 0) {
+        free(jobs);
+        return strdup("No locked tuners to capture.");
+    }
+
+    struct capture_engine *engine = capture_engine_start(jobs, job_count);
+    free(jobs);
+    if (!engine) return strdup("Failed to start capture engine.");
+
+    int parent_h, parent_w, parent_y, parent_x;
+    getmaxyx(parent_win, parent_h, parent_w);
+    getbegyx(parent_win, parent_y, parent_x);
+    WINDOW *progress_win = newwin(parent_h, parent_w, parent_y, parent_x);
+    keypad(progress_win, TRUE);
+    wtimeout(progress_win, 250);
+
+    static const char *state_names[] = { "pending", "running", "done", "FAILED", "cancelled" };
+    bool cancelled = false;
+    int scroll = 0;
+    while (capture_engine_active(engine)) {
+        werase(progress_win);
+        box(progress_win, 0, 0);
+        mvwprintw(progress_win, 0, 2, " Capturing %d tuner%s ", job_count, job_count == 1 ? "" : "s");
+        mvwprintw(progress_win, 1, 2, "%-11s %-9s %5s %9s %7s %5s %5s %5s  %s", "Tuner", "State", "Time", "MB", "Mbps", "TE", "NE", "SE", "File");
+
+        // One row is kept for "N more" when the jobs don't all fit
+        int max_rows = getmaxy(progress_win) - 4;
+        if (job_count > max_rows) max_rows--;
+        if (scroll > job_count - max_rows) scroll = job_count - max_rows;
+        if (scroll < 0) scroll = 0;
+        for (int row = 0; row < max_rows && scroll + row < job_count; row++) {
+            int i = scroll + row;
+            const struct capture_job *job = capture_engine_get_job(engine, i);
+            struct capture_progress prog;
+            capture_engine_get_progress(engine, i, &prog);
+            double mbps = prog.elapsed_ms > 0 ? prog.bytes * 8.0 / (prog.elapsed_ms * 1000.0) : 0.0;
+
+            if (prog.state == CAPTURE_JOB_FAILED) wattron(progress_win, COLOR_PAIR(1));
+            else if (prog.te || prog.ne || prog.se) wattron(progress_win, COLOR_PAIR(2));
+            mvwprintw(progress_win, row + 2, 2, "%08X-%-2d %-9s %4lds %9.2f %7.2f %5ld %5ld %5ld  %.*s",
+                      job->device_id, job->tuner_index, state_names[prog.state], prog.elapsed_ms / 1000,
+                      prog.bytes / (1024.0 * 1024.0), mbps, prog.te, prog.ne, prog.se,
+                      getmaxx(progress_win) - 72 > 0 ? getmaxx(progress_win) - 72 : 0,
+                      prog.state == CAPTURE_JOB_FAILED ? prog.message : job->filename);
+            wattroff(progress_win, COLOR_PAIR(1) | COLOR_PAIR(2));
+        }
+        if (job_count > max_rows) {
+            mvwprintw(progress_win, max_rows + 2, 2, "(%d above, %d more below)", scroll, job_count - scroll - max_rows);
+        }
+
+        if (cancelled) mvwprintw(progress_win, getmaxy(progress_win) - 2, 2, "Stopping...");
+        else if (job_count > max_rows) mvwprintw(progress_win, getmaxy(progress_win) - 2, 2, "Backspace: Stop all captures | Up/Dn/PgUp/PgDn: Scroll");
+        else mvwprintw(progress_win, getmaxy(progress_win) - 2, 2, "Backspace: Stop all captures");
+        wrefresh(progress_win);
+
+        int ch = wgetch(progress_win);
+        if (ch == KEY_UP) scroll--;
+        else if (ch == KEY_DOWN) scroll++;
+        else if (ch == KEY_PPAGE) scroll -= max_rows;
+        else if (ch == KEY_NPAGE) scroll += max_rows;
+        else if (ch == KEY_BACKSPACE && !cancelled) {
+            capture_engine_cancel(engine);
+            cancelled = true;
+        }
+    }
+
+    int succeeded = 0;
+    uint64_t total_bytes = 0;
+    long total_errors = 0;
+    for (int i = 0; i < job_count; i++) {
+        struct capture_progress prog;
+        capture_engine_get_progress(engine, i, &prog);
+        if (prog.state == CAPTURE_JOB_DONE) succeeded++;
+        total_bytes += prog.bytes;
+        total_errors += prog.te + prog.ne + prog.se;
+    }
+    capture_engine_destroy(engine);
+    delwin(progress_win);
+    touchwin(parent_win);
+
+    char *result_str = (char*)malloc(512);
+    snprintf(result_str, 512, "%s %d/%d captures, %.2f MB total\nErrors across all tuners: %ld",
+             cancelled ? "Stopped" : "Completed", succeeded, job_count, total_bytes / (1024.0 * 1024.0), total_errors);
+    return result_str;
+}
+
+/*
+ * load_device_channel_list
+ * Reads a device's own channel map through the pool. A device that doesn't
+ * answer gets the broadcast range 2-69 with no map name.
+ */
+static void load_device_channel_list(const struct unified_tuner *tuner, struct channel_list *list) {
+    // Shared with the main loop; it sets its own tuner again on the next pass
+    struct hdhomerun_device_t *hd = device_pool_get(device_pool, tuner->device_id, tuner->ip_str);
+    list->count = 0;
+    list->map[0] = '\0';
+    if (hd) {
+        hdhomerun_device_set_tuner(hd, tuner->tuner_index);
+        if (!populate_channel_list(hd, list)) device_pool_report_failure(device_pool, tuner->device_id);
+    }
+}
+
+/*
+ * scan_band
+ * Scans each device's channel list on every idle tuner of the selected
+ * device (or of all devices) at once, showing a single merged table.
+ * Devices on the same channel map share the work of scanning it.
+ * Returns a summary message for the status pane.
+ */
+char* scan_band(WINDOW *parent_win, struct unified_tuner tuners[], int total_tuners, int highlight,
+                const struct channel_list *list, bool all_devices) {
+    struct band_scan_channel channels[BAND_SCAN_MAX_CHANNELS];
+    int channel_count = 0;
+    struct channel_list dev_list;
+    int map_count = 0;
+
+    struct band_scan_tuner scan_tuners[BAND_SCAN_MAX_TUNERS];
+    int tuner_count = 0;
+    for (int i = 0; i < total_tuners && tuner_count < BAND_SCAN_MAX_TUNERS; i++) {
+        if (!all_devices && tuners[i].device_id != tuners[highlight].device_id) continue;
+
+        // Tuners of a device already seen take its map; the first tuner of
+        // any other device reads the map from the device itself
+        const char *map = NULL;
+        for (int t = 0; t < tuner_count && !map; t++) {
+            if (scan_tuners[t].device_id == tuners[i].device_id) map = scan_tuners[t].channelmap;
+        }
+        if (!map) {
+            const struct channel_list *src = list;
+            if (tuners[i].device_id != tuners[highlight].device_id) {
+                load_device_channel_list(&tuners[i], &dev_list);
+                src = &dev_list;
+            }
+            map = src->map;
+
+            bool map_known = false;
+            for (int c = 0; c < channel_count && !map_known; c++) map_known = strcmp(channels[c].channelmap, map) == 0;
+            if (!map_known) {
+                map_count++;
+                int added = 0;
+                for (int c = 0; c < src->count && channel_count < BAND_SCAN_MAX_CHANNELS; c++, added++) {
+                    channels[channel_count].channel = src->channels[c];
+                    snprintf(channels[channel_count++].channelmap, sizeof(channels[0].channelmap), "%s", map);
+                }
+                for (unsigned int ch = 2; added == 0 && ch <= 69 && channel_count < BAND_SCAN_MAX_CHANNELS; ch++) {
+                    channels[channel_count].channel = ch;
+                    snprintf(channels[channel_count++].channelmap, sizeof(channels[0].channelmap), "%s", map);
+                }
+            }
+        }
+
+        scan_tuners[tuner_count].device_id = tuners[i].device_id;
+        snprintf(scan_tuners[tuner_count].ip_str, sizeof(scan_tuners[tuner_count].ip_str), "%s", tuners[i].ip_str);
+        scan_tuners[tuner_count].tuner_index = tuners[i].tuner_index;
+        snprintf(scan_tuners[tuner_count].channelmap, sizeof(scan_tuners[tuner_count].channelmap), "%s", map);
+        tuner_count++;
+    }
+
+    // A channel is live if it locked on any of the devices on its map last
+    // time, and only skipped if it was recently dead on all of them
+    enum scan_db_verdict verdicts[BAND_SCAN_MAX_CHANNELS];
+    int skipped = 0;
+    time_t now = time(NULL);
+    for (int c = 0; c < channel_count; c++) {
+        bool any_live = false, all_dead = true;
+        int matched = 0;
+        for (int t = 0; t < tuner_count; t++) {
+            if (strcmp(scan_tuners[t].channelmap, channels[c].channelmap) != 0) continue;
+            enum scan_db_verdict verdict = scan_db_verdict(scan_db, scan_tuners[t].device_id, channels[c].channelmap,
+                                                           channels[c].channel, now);
+            matched++;
+            if (verdict == SCAN_DB_LIVE) any_live = true;
+            if (verdict != SCAN_DB_DEAD) all_dead = false;
+        }
+        if (matched == 0) all_dead = false;
+        verdicts[c] = any_live ? SCAN_DB_LIVE : all_dead ? SCAN_DB_DEAD : SCAN_DB_UNKNOWN;
+        if (all_dead) skipped++;
+    }
+
+    struct timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    struct band_scan *scan = band_scan_start(scan_tuners, tuner_count, channels, channel_count, verdicts);
+    if (!scan) return strdup("Failed to start band scan.");
+    log_debug("Band scan: %d channels on %d map%s (%d known dead) across %d candidate tuners",
+              channel_count, map_count, map_count == 1 ? "" : "s", skipped, tuner_count);
+
+    int parent_h, parent_w, parent_y, parent_x;
+    getmaxyx(parent_win, parent_h, parent_w);
+    getbegyx(parent_win, parent_y, parent_x);
+    WINDOW *scan_win = newwin(parent_h, parent_w, parent_y, parent_x);
+    keypad(scan_win, TRUE);
+    wtimeout(scan_win, 250);
+
+    bool cancelled = false;
+    bool finished = false;
+    double elapsed_s = 0.0;
+    int scroll = 0;
+    int ch_width = map_count > 1 ? 14 : 4;
+    for (;;) {
+        bool active = band_scan_active(scan);
+        if (!active && !finished) {
+            finished = true;
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            elapsed_s = (now.tv_sec - start_time.tv_sec) + (now.tv_nsec - start_time.tv_nsec) / 1e9;
+            wtimeout(scan_win, -1);
+        }
+
+        int used = band_scan_tuners_used(scan);
+        int done = band_scan_done_count(scan);
+        werase(scan_win);
+        box(scan_win, 0, 0);
+        mvwprintw(scan_win, 0, 2, " Band scan: %d/%d channels, %d tuner%s ", done, channel_count - skipped, used, used == 1 ? "" : "s");
+        mvwprintw(scan_win, 1, 2, "%*s  %-11s %-12s %4s %4s %4s %6s %5s %-14s %5s",
+                  ch_width, "Ch", "Tuner", "Lock", "SS", "SNQ", "SEQ", "dBm", "dB", "TSID/BSID", "Time");
+
+        int max_rows = getmaxy(scan_win) - 4;
+        if (scroll > channel_count - max_rows) scroll = channel_count - max_rows;
+        if (scroll < 0) scroll = 0;
+        for (int row = 0; row < max_rows && scroll + row < channel_count; row++) {
+            struct band_scan_result res;
+            band_scan_get_result(scan, scroll + row, &res);
+            int y = row + 2;
+
+            // With more than one map, say which map the channel is on
+            char ch_str[24];
+            if (map_count > 1) snprintf(ch_str, sizeof(ch_str), "%.10s %3u", res.channelmap[0] ? res.channelmap : "-", res.channel);
+            else snprintf(ch_str, sizeof(ch_str), "%u", res.channel);
+            if (res.state == BAND_SCAN_PENDING) {
+                mvwprintw(scan_win, y, 2, "%*s  %s", ch_width, ch_str, finished ? "not scanned" : "");
+                continue;
+            }
+            if (res.state == BAND_SCAN_SKIPPED) {
+                mvwprintw(scan_win, y, 2, "%*s  %-11s %s", ch_width, ch_str, "", "no signal (cached)");
+                continue;
+            }
+            if (res.state == BAND_SCAN_FAILED) {
+                mvwprintw(scan_win, y, 2, "%*s  %08X-%-2d %s", ch_width, ch_str, res.device_id, res.tuner_index,
+                          "tuner did not answer");
+                continue;
+            }
+            if (res.state == BAND_SCAN_SCANNING) {
+                wattron(scan_win, COLOR_PAIR(2));
+                mvwprintw(scan_win, y, 2, "%*s  %08X-%-2d scanning...", ch_width, ch_str, res.device_id, res.tuner_index);
+                wattroff(scan_win, COLOR_PAIR(2));
+                continue;
+            }
+
+            char dbm[16] = "", db[16] = "", id[24] = "";
+            if (res.ss_dbm != STATUS_VALUE_NONE) snprintf(dbm, sizeof(dbm), "%ld", res.ss_dbm);
+            if (res.snq_db != STATUS_VALUE_NONE) snprintf(db, sizeof(db), "%ld", res.snq_db);
+            if (res.bsid != STATUS_VALUE_NONE) snprintf(id, sizeof(id), "BSID %ld", res.bsid);
+            else if (res.tsid != STATUS_VALUE_NONE) snprintf(id, sizeof(id), "TSID 0x%04lX", res.tsid);
+
+            if (res.locked) wattron(scan_win, COLOR_PAIR(3));
+            mvwprintw(scan_win, y, 2, "%*s  %08X-%-2d %-12.12s %3u%% %3u%% %3u%% %6s %5s %-14s %4.1fs",
+                      ch_width, ch_str, res.device_id, res.tuner_index, res.signal_present ? res.lock_str : "no signal",
+                      res.ss, res.snq, res.seq, dbm, db, id, res.scan_ms / 1000.0);
+            wattroff(scan_win, COLOR_PAIR(3));
+        }
+
+        if (finished) {
+            mvwprintw(scan_win, getmaxy(scan_win) - 2, 2, "%s in %.1f s. Up/Dn/PgUp/PgDn: Scroll | Any other key: Close",
+                      cancelled ? "Stopped" : "Done", elapsed_s);
+        } else {
+            mvwprintw(scan_win, getmaxy(scan_win) - 2, 2, cancelled ? "Stopping..." : "Backspace: Stop scan | Up/Dn/PgUp/PgDn: Scroll");
+        }
+        wrefresh(scan_win);
+
+        int ch = wgetch(scan_win);
+        if (ch == KEY_UP) scroll--;
+        else if (ch == KEY_DOWN) scroll++;
+        else if (ch == KEY_PPAGE) scroll -= max_rows;
+        else if (ch == KEY_NPAGE) scroll += max_rows;
+        else if (ch == KEY_BACKSPACE && !finished && !cancelled) {
+            band_scan_cancel(scan);
+            cancelled = true;
+        } else if (finished && ch != ERR && ch != KEY_RESIZE) {
+            break;
+        }
+    }
+
+    // Only measured channels go in the scan db; one that failed on a
+    // control timeout must not be cached as dead
+    int locked = 0;
+    int failed = 0;
+    for (int i = 0; i < channel_count; i++) {
+        struct band_scan_result res;
+        band_scan_get_result(scan, i, &res);
+        if (res.state == BAND_SCAN_FAILED) failed++;
+        if (res.state != BAND_SCAN_DONE) continue;
+        if (res.locked) {
+            locked++;
+            log_debug("Band scan: ch %u (%s) %s ss=%u snq=%u seq=%u tsid=%ld bsid=%ld plps=%llx (%08X-%d)", res.channel, res.channelmap,
+                      res.lock_str, res.ss, res.snq, res.seq, res.tsid, res.bsid, (unsigned long long)res.plp_mask,
+                      res.device_id, res.tuner_index);
+        }
+
+        struct scan_db_entry entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.device_id = res.device_id;
+        snprintf(entry.channelmap, sizeof(entry.channelmap), "%s", res.channelmap);
+        entry.channel = res.channel;
+        entry.last_scan = time(NULL);
+        entry.locked = res.locked;
+        entry.ss = res.ss;
+        entry.snq = res.snq;
+        entry.seq = res.seq;
+        entry.tsid = res.tsid;
+        entry.bsid = res.bsid;
+        entry.plp_mask = res.plp_mask;
+        scan_db_record(scan_db, &entry);
+    }
+    scan_db_save(scan_db);
+    int used = band_scan_tuners_used(scan);
+    int done = band_scan_done_count(scan);
+    band_scan_destroy(scan);
+    delwin(scan_win);
+    touchwin(parent_win);
+
+    char *result_str = (char*)malloc(512);
+    if (used == 0) {
+        snprintf(result_str, 512, "Band scan: no idle tuners to scan with.");
+    } else {
+        snprintf(result_str, 512, "Band scan %s: %d/%d channels scanned, %d locked, %d skipped as dead, %d failed\nUsed %d tuner%s, %.1f s",
+                 cancelled ? "stopped" : "complete", done - failed, channel_count, locked, skipped, failed,
+                 used, used == 1 ? "" : "s", elapsed_s);
+    }
+    return result_str;
+}
+
+#define RING_SEGMENT_ALIGN_TS 188 // TS packet size
+
+/*
+ * ring_capture_stream
+ * Continuous capture into a ring of segment files. Runs until Backspace;
+ * when the tuner's te/ne/se counters rise or symbol quality drops below
+ * 100, the segment in progress is finished at once and the last few
+ * segments are kept as an event instead of being overwritten. Errors that
+ * keep coming within the holdoff belong to the same event, and at most
+ * ring_max_events are kept, so disk use stays bounded on a bad channel.
+ */
+char* ring_capture_stream(WINDOW *win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info) {
+    struct capture_job job;
+    if (!build_capture_job(tuner_info, &job)) {
+        return strdup("No signal lock. Cannot start continuous capture.");
+    }
+
+    char base[256];
+    const char *ext = strrchr(job.filename, '.');
+    snprintf(base, sizeof(base), "%.*s", (int)(ext - job.filename), job.filename);
+
+    // TS segments are cut on packet boundaries. ATSC 3.0 .dbg captures
+    // have no fixed-size framing, so their segments are cut wherever the
+    // cut falls and a tool reading one has to resync.
+    int segment_align = strcmp(ext, ".ts") == 0 ? RING_SEGMENT_ALIGN_TS : 1;
+
+    struct capture_ring *ring = capture_ring_open(base, ext, ring_segment_count, ring_segment_seconds * 1000);
+    if (!ring) return strdup("Failed to open ring segment for writing.");
+
+    char err[128];
+    struct capture_session *session = capture_session_open_to(job.ip_str, job.url, capture_ring_file(ring), err, sizeof(err));
+    if (!session) {
+        capture_ring_close(ring);
+        char *result_str = (char*)malloc(512);
+        snprintf(result_str, 512, "Error: %s", err);
+        return result_str;
+    }
+    log_debug("Ring capture: %s, %d x %d s segments, keeping %d on error", job.url, ring_segment_count, ring_segment_seconds, ring_keep_segments);
+
+    char debug_path[64];
+    sprintf(debug_path, "/tuner%d/debug", tuner_info->tuner_index);
+    struct status_fields debug_fields;
+    read_debug_fields(hd, debug_path, &debug_fields);
+    long last_te = debug_fields.value[STATUS_KEY_TE];
+    long last_ne = debug_fields.value[STATUS_KEY_NE];
+    long last_se = debug_fields.value[STATUS_KEY_SE];
+
+    struct timespec start_time, current_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    long elapsed_ms = 0;
+    long next_ui_ms = 0;
+    long next_check_ms = CAPTURE_CHECK_DELAY_MS;
+    bool freeze_pending = false;
+    bool stream_ended = false;
+    int saved_segments = 0;
+
+    // A new event needs this long without errors since the last one, i.e.
+    // until the segments it kept would have left the ring anyway
+    long long holdoff_ms = (long long)ring_keep_segments * ring_segment_seconds * 1000;
+    long long holdoff_until_ms = -1;
+    int ignored_errors = 0;
+
+    while (!stream_ended) {
+        clock_gettime(CLOCK_MONOTONIC, &current_time);
+        elapsed_ms = (current_time.tv_sec - start_time.tv_sec) * 1000 + (current_time.tv_nsec - start_time.tv_nsec) / 1000000;
+
+        // The session is asked to stop at the next segment_align boundary
+        // and the ring rotates once it has. An error ends the segment
+        // straight away so it can be kept.
+        if (freeze_pending || capture_ring_rotate_due(ring)) capture_session_request_cut(session, segment_align);
+        if (capture_session_cut_ready(session)) {
+            FILE *next = capture_ring_rotate(ring);
+            if (freeze_pending) {
+                int saved = capture_ring_freeze(ring, ring_keep_segments);
+                saved_segments += saved;
+                log_debug("Ring capture: error event %d, kept %d segments", capture_ring_event_count(ring), saved);
+                freeze_pending = false;
+            }
+            if (!next) break;
+            capture_session_set_output(session, next);
+        }
+
+        if (elapsed_ms >= next_ui_ms) {
+            next_ui_ms = elapsed_ms + CAPTURE_UI_INTERVAL_MS;
+            draw_status_pane(win, active_poller, tuner_info, 0);
+            mvwhline(win, LINES - 4, 1, ' ', getmaxx(win) - 2);
+            mvwhline(win, LINES - 3, 1, ' ', getmaxx(win) - 2);
+            print_line_in_box(win, LINES - 4, 2, "Ring capture %s.ringNN%s: %lds, %.1f MB, %d event%s%s", base, ext,
+                              elapsed_ms / 1000, capture_session_bytes(session) / (1024.0 * 1024.0),
+                              capture_ring_event_count(ring), capture_ring_event_count(ring) == 1 ? "" : "s",
+                              freeze_pending ? " (saving...)" : "");
+            print_line_in_box(win, LINES - 3, 2, "Press Backspace to stop.");
+            wrefresh(win);
+        }
+
+        // Error trigger: counters rising or symbol quality dropping
+        if (elapsed_ms >= next_check_ms) {
+            next_check_ms = elapsed_ms + CAPTURE_CHECK_INTERVAL_MS;
+            bool triggered = false;
+            if (read_debug_fields(hd, debug_path, &debug_fields)) {
+                long te = debug_fields.value[STATUS_KEY_TE];
+                long ne = debug_fields.value[STATUS_KEY_NE];
+                long se = debug_fields.value[STATUS_KEY_SE];
+                if ((last_te != -999 && te > last_te) || (last_ne != -999 && ne > last_ne) || (last_se != -999 && se > last_se)) {
+                    triggered = true;
+                }
+                last_te = te; last_ne = ne; last_se = se;
+            }
+            struct hdhomerun_tuner_status_t current_status;
+            char *current_raw_status;
+            if (hdhomerun_device_get_tuner_status(hd, &current_raw_status, &current_status) > 0 &&
+                current_status.symbol_error_quality < 100) {
+                triggered = true;
+            }
+            if (triggered && !freeze_pending) {
+                bool same_event = holdoff_until_ms >= 0 && elapsed_ms < holdoff_until_ms;
+                if (same_event || capture_ring_event_count(ring) >= ring_max_events) {
+                    ignored_errors++;
+                    log_debug("Ring capture: error at %ld ms not saved (%s)", elapsed_ms,
+                              same_event ? "same event" : "event limit reached");
+                } else {
+                    log_debug("Ring capture: error detected at %ld ms", elapsed_ms);
+                    freeze_pending = true;
+                }
+                holdoff_until_ms = elapsed_ms + holdoff_ms;
+            }
+        }
+
+        struct pollfd fds[2] = {
+            { capture_session_fd(session), POLLIN, 0 },
+            { STDIN_FILENO, POLLIN, 0 },
+        };
+        int ready = poll(fds, 2, CAPTURE_UI_INTERVAL_MS);
+        if (ready < 0 && errno != EINTR) break;
+
+        if (ready > 0 && (fds[1].revents & POLLIN)) {
+            if (getch() == KEY_BACKSPACE) break;
+        }
+        if (ready > 0 && (fds[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+            if (capture_session_pump(session) <= 0) stream_ended = true;
+        }
+    }
+
+    // An error in the last, unfinished segment still gets kept
+    if (freeze_pending) {
+        capture_ring_rotate(ring);
+        saved_segments += capture_ring_freeze(ring, ring_keep_segments);
+    }
+    int events = capture_ring_event_count(ring);
+    capture_session_close(session);
+    capture_ring_close(ring);
+
+    // The HTTP request retuned the tuner; put it back where it was
+    napms(500);
+    hdhomerun_device_set_tuner_channel(hd, job.restore_channel);
+    struct hdhomerun_tuner_status_t lock_status;
+    hdhomerun_device_wait_for_lock(hd, &lock_status);
+
+    char *result_str = (char*)malloc(1024);
+    snprintf(result_str, 1024, "%s after %lds. %d error event%s, %d segments kept as %s-eventNNN-MM%s, %d later error check%s not saved\nRing segments remain as %s.ringNN%s",
+             stream_ended ? "Stream ended" : "Continuous capture stopped", elapsed_ms / 1000,
+             events, events == 1 ? "" : "s", saved_segments, base, ext, ignored_errors, ignored_errors == 1 ? "" : "s", base, ext);
+    return result_str;
+}
+
 /*
  * get_udp_port
  * Finds a free ephemeral UDP port for streaming.
@@ -1479,48 +2582,67 @@ int main_loop() {
     static bool mouse_scroll_enabled = false;
     // State for debug mode
     static bool debug_mode_enabled = false;
+    // State for the all-tuners dashboard
+    static bool dashboard_mode = false;
 
     WINDOW *tuner_win = newwin(LINES, LEFT_PANE_WIDTH, 0, 0);
     WINDOW *status_win = newwin(LINES, COLS - LEFT_PANE_WIDTH, 0, LEFT_PANE_WIDTH);
     keypad(stdscr, TRUE);
     nodelay(stdscr, TRUE);
 
-    total_tuners = discover_and_build_tuner_list(tuners);
+    // On startup, show the last known devices at once and discover behind them
+    static bool startup = true;
+    if (startup) total_tuners = load_cached_tuner_list(tuners);
+    if (total_tuners > 0) start_background_discovery(tuners, total_tuners);
+    else total_tuners = discover_and_build_tuner_list(tuners);
+    startup = false;
     if (total_tuners == 0) {
         delwin(tuner_win); delwin(status_win);
         return 1;
     }
 
     while (1) {
+        struct inventory_device discovered[DEVICE_INVENTORY_MAX_DEVICES];
+        int discovered_count = finish_background_discovery(discovered, false);
+        if (discovered_count > 0) {
+            log_debug("Background discovery found %d devices", discovered_count);
+            if (merge_discovered_devices(tuners, &total_tuners, &highlight, discovered, discovered_count)) {
+                // Reconnect to whatever is selected now
+                hd = NULL;
+                current_device_id = 0;
+                chan_list.count = 0;
+            }
+        } else if (discovered_count == -1) {
+            log_debug("Background discovery found no devices, keeping the cached list");
+        }
+
         bool tuner_changed = false;
         struct unified_tuner *selected_tuner = (total_tuners > 0) ? &tuners[highlight] : NULL;
 
         if (selected_tuner) {
-            if (hd == NULL || current_device_id != selected_tuner->device_id) {
-                if (hd) hdhomerun_device_destroy(hd);
-                char device_id_str[16];
-                sprintf(device_id_str, "%08X", selected_tuner->device_id);
-                log_debug("Creating device connection: ID=%s, IP=%s", 
-                          device_id_str, selected_tuner->ip_str);
-                // Use IP address for connection to support remote/Layer 3 connections
-                // The library can work with either device ID or IP, but IP is required
-                // when the device is not on the same broadcast domain
-                hd = hdhomerun_device_create_from_str(selected_tuner->ip_str, NULL);
-                if (hd) {
-                    log_debug("Device connection created successfully using IP: %s", selected_tuner->ip_str);
-                } else {
-                    log_debug("ERROR: Failed to create device connection with IP: %s", selected_tuner->ip_str);
-                }
+            if (current_device_id != selected_tuner->device_id) {
+                log_debug("Switching to device: ID=%08X, IP=%s", selected_tuner->device_id, selected_tuner->ip_str);
                 current_device_id = selected_tuner->device_id;
                 status_scroll_offset = 0;
                 tuner_changed = true;
             }
+            // The pool keeps each device's connection open, so switching back
+            // and forth costs nothing; a device that stops answering is retried
+            // with backoff rather than on every pass
+            device_pool_expire(device_pool);
+            hd = device_pool_get(device_pool, selected_tuner->device_id, selected_tuner->ip_str);
+            active_poller = get_device_poller(selected_tuner);
+            update_poller_watch_masks(tuners, total_tuners, highlight, dashboard_mode);
             if (hd) {
                 log_debug("main_loop: Setting tuner to index %d", selected_tuner->tuner_index);
                 int set_result = hdhomerun_device_set_tuner(hd, selected_tuner->tuner_index);
                 log_debug("main_loop: set_tuner returned %d", set_result);
                 if (chan_list.count == 0 || tuner_changed) {
-                    populate_channel_list(hd, &chan_list);
+                    if (!populate_channel_list(hd, &chan_list)) {
+                        log_debug("main_loop: %08X did not answer, backing off", selected_tuner->device_id);
+                        device_pool_report_failure(device_pool, selected_tuner->device_id);
+                        hd = NULL;
+                    }
                     status_scroll_offset = 0;
                 }
             } else {
@@ -1531,7 +2653,7 @@ int main_loop() {
         // If tuner changed while VLC was running, stop it.
         if (tuner_changed && vlc_pid > 0) {
             kill(vlc_pid, SIGTERM); waitpid(vlc_pid, NULL, 0); vlc_pid = 0;
-            hdhomerun_device_set_tuner_target(hd, "none");
+            if (hd) hdhomerun_device_set_tuner_target(hd, "none");
             if (persistent_message) free(persistent_message);
             persistent_message = strdup("VLC stopped due to tuner change.");
         }
@@ -1539,23 +2661,28 @@ int main_loop() {
 
         werase(tuner_win);
         box(tuner_win, 0, 0);
-        for (int i = 0; i < total_tuners; i++) {
-            if (i + 2 >= LINES) break;
+        int visible_tuners = LINES - 3;
+        int list_top = (highlight >= visible_tuners) ? highlight - visible_tuners + 1 : 0;
+        for (int i = list_top; i < total_tuners; i++) {
+            if (i - list_top + 2 >= LINES - 1) break;
             if (i == highlight) wattron(tuner_win, A_REVERSE);
-            mvwprintw(tuner_win, i + 1, 2, "%08X-%d", tuners[i].device_id, tuners[i].tuner_index);
+            mvwprintw(tuner_win, i - list_top + 1, 2, "%08X-%d", tuners[i].device_id, tuners[i].tuner_index);
             if (i == highlight) wattroff(tuner_win, A_REVERSE);
         }
-        mvwprintw(tuner_win, LINES - 2, 2, "r: Refresh");
+        mvwprintw(tuner_win, LINES - 2, 2, background_discovery ? "Discovering..." : "r: Refresh");
         
-        total_content_lines = draw_status_pane(status_win, hd, selected_tuner, status_scroll_offset);
+        if (dashboard_mode) {
+            total_content_lines = draw_dashboard_pane(status_win, tuners, total_tuners, highlight, status_scroll_offset);
+        } else {
+            total_content_lines = draw_status_pane(status_win, active_poller, selected_tuner, status_scroll_offset);
+        }
         
         // Check if current tuner is ATSC3 to adjust hint text
         bool is_atsc3 = false;
-        if(hd) {
-            struct hdhomerun_tuner_status_t current_status;
-            char *raw_status;
-            if(hdhomerun_device_get_tuner_status(hd, &raw_status, &current_status) > 0) {
-                if(strstr(current_status.lock_str, "atsc3")) {
+        if (hd && selected_tuner) {
+            struct tuner_status_snapshot snap;
+            if (status_poller_get_snapshot(active_poller, selected_tuner->tuner_index, &snap) > 0 && snap.valid) {
+                if (strstr(snap.status.lock_str, "atsc3")) {
                     is_atsc3 = true;
                 }
             }
@@ -1579,6 +2706,8 @@ int main_loop() {
         } else {
             if (vlc_pid > 0) {
                  mvwprintw(status_win, LINES - 2, 2, "v: Stop VLC | h: Help | q: Quit");
+            } else if (dashboard_mode) {
+                 mvwprintw(status_win, LINES - 2, 2, "Up/Dn: Select | PgUp/PgDn: Scroll | o: Single tuner | q: Quit");
             } else if (total_content_lines > LINES - 4) {
                  mvwprintw(status_win, LINES - 2, 2, "PgUp/PgDn: Scroll | v: View | h: Help | q: Quit");
             } else {
@@ -1624,9 +2753,9 @@ int main_loop() {
                 if (vlc_pid > 0) { 
                     kill(vlc_pid, SIGTERM); 
                     waitpid(vlc_pid, NULL, 0); 
-                    hdhomerun_device_set_tuner_target(hd, "none");
+                    if (hd) hdhomerun_device_set_tuner_target(hd, "none");
                 }
-                if (hd) hdhomerun_device_destroy(hd);
+                destroy_device_pollers();
                 delwin(tuner_win); delwin(status_win);
                 return 0;
 
@@ -1636,9 +2765,12 @@ int main_loop() {
                     kill(vlc_pid, SIGTERM); 
                     waitpid(vlc_pid, NULL, 0); 
                     vlc_pid = 0; 
-                    hdhomerun_device_set_tuner_target(hd, "none");
+                    if (hd) hdhomerun_device_set_tuner_target(hd, "none");
                 }
-                if (hd) { hdhomerun_device_destroy(hd); hd = NULL; current_device_id = 0; }
+                // Pooled connections stay; an address change is picked up by device_pool_get
+                hd = NULL; current_device_id = 0;
+                destroy_device_pollers();
+                finish_background_discovery(NULL, true);
                 chan_list.count = 0; status_scroll_offset = 0;
                 total_tuners = discover_and_build_tuner_list(tuners);
                 log_debug("Refresh: Discovered %d tuners", total_tuners);
@@ -1658,7 +2790,7 @@ int main_loop() {
             case 'd':
                 if(hd && is_atsc3) {
                     if (show_plp_details_screen(status_win, hd, selected_tuner) == 1) { // Quit requested
-                         if (hd) hdhomerun_device_destroy(hd);
+                         destroy_device_pollers();
                          delwin(tuner_win); delwin(status_win);
                          return 0;
                     }
@@ -1708,7 +2840,12 @@ int main_loop() {
                     }
                     
                     const unsigned int start_channel = current_channel;
-                    bool first_iteration = true;
+                    // One lap over the channels the scan db doesn't know to be
+                    // dead, then, if nothing locked, one over the dead ones
+                    const int lap_len = (chan_list.count > 0) ? chan_list.count : 68;
+                    const time_t seek_start = time(NULL);
+                    int steps = 0;
+                    bool probe_dead = false, skipped_dead = false;
 
                     while(1) {
                         unsigned int new_channel;
@@ -1725,36 +2862,51 @@ int main_loop() {
                             new_channel = current_channel;
                         }
 
-                        if (!first_iteration && new_channel == start_channel) {
-                            break;
+                        if (++steps > lap_len) {
+                            if (probe_dead || !skipped_dead) break;
+                            probe_dead = true;
+                            steps = 1;
+                        }
+                        if (new_channel == start_channel) continue;
+
+                        enum scan_db_verdict verdict = scan_db_verdict(scan_db, selected_tuner->device_id, chan_list.map,
+                                                                       new_channel, seek_start);
+                        if ((verdict == SCAN_DB_DEAD) != probe_dead) {
+                            if (verdict == SCAN_DB_DEAD) {
+                                log_debug("Seek: Skipping ch %u, no signal there on the last scan", new_channel);
+                                skipped_dead = true;
+                            }
+                            continue;
                         }
-                        first_iteration = false;
 
                         char tune_str[64];
                         sprintf(tune_str, "auto:%u", new_channel);
                         log_debug("Seek: Tuning to channel %u", new_channel);
                         hdhomerun_device_set_tuner_channel(hd, tune_str);
+                        status_poller_kick(active_poller);
                         status_scroll_offset = 0;
                         
                         wmove(status_win, LINES - 3, 2); wclrtoeol(status_win);
                         box(status_win, 0, 0);
                         print_line_in_box(status_win, LINES - 3, 2, "Seeking %s on ch %u...", (seek_direction == 1) ? "Up" : "Down", new_channel);
-                        draw_status_pane(status_win, hd, selected_tuner, status_scroll_offset);
+                        draw_status_pane(status_win, active_poller, selected_tuner, status_scroll_offset);
                         mvwprintw(status_win, LINES - 2, 2, "<-/->: Ch | +/-: Seek | h: Help | q: Quit");
                         wrefresh(status_win);
 
                         bool lock_found = false;
+                        bool have_status = false;
+                        struct hdhomerun_tuner_status_t seek_status;
                         for (int i = 0; i < 25; i++) {
-                            struct hdhomerun_tuner_status_t seek_status;
                             char *raw_status;
                             if (hdhomerun_device_get_tuner_status(hd, &raw_status, &seek_status) > 0) {
+                                have_status = true;
                                 if (seek_status.signal_to_noise_quality > 0) {
                                     lock_found = true;
                                     break;
                                 }
                             }
                             
-                            draw_status_pane(status_win, hd, selected_tuner, status_scroll_offset);
+                            draw_status_pane(status_win, active_poller, selected_tuner, status_scroll_offset);
                             print_line_in_box(status_win, LINES - 3, 2, "Seeking %s on ch %u... (%2.1fs)", (seek_direction == 1) ? "Up" : "Down", new_channel, (25-i)/10.0);
                             mvwprintw(status_win, LINES - 2, 2, "<-/->: Ch | +/-: Seek | h: Help | q: Quit");
                             wrefresh(status_win);
@@ -1768,14 +2920,18 @@ int main_loop() {
                             }
                         }
 
+                        if (have_status) {
+                            record_scan_result(selected_tuner->device_id, chan_list.map, new_channel, lock_found, &seek_status);
+                        }
                         if (lock_found) {
                             break;
                         }
                     }
                 end_seek:
+                    scan_db_save(scan_db);
                     wmove(status_win, LINES - 3, 2); wclrtoeol(status_win);
                     box(status_win, 0, 0);
-                    draw_status_pane(status_win, hd, selected_tuner, status_scroll_offset);
+                    draw_status_pane(status_win, active_poller, selected_tuner, status_scroll_offset);
                     mvwprintw(status_win, LINES - 2, 2, "<-/->: Ch | +/-: Seek | h: Help | q: Quit");
                     wrefresh(status_win);
                 }
@@ -1818,6 +2974,7 @@ int main_loop() {
                     log_debug("main_loop: Tuning to channel %u (tune_str: %s)", new_channel, tune_str);
                     int tune_result = hdhomerun_device_set_tuner_channel(hd, tune_str);
                     log_debug("main_loop: set_tuner_channel returned %d", tune_result);
+                    status_poller_kick(active_poller);
                     status_scroll_offset = 0;
                 }
                 break;
@@ -1850,6 +3007,28 @@ int main_loop() {
                 }
                 break;
 
+            case 'l': // Continuous ring capture
+                if (!hd || vlc_pid > 0) break;
+                persistent_message = ring_capture_stream(status_win, hd, &tuners[highlight]);
+                status_poller_kick(active_poller);
+                break;
+
+            case 'b': // Band scan on every idle tuner of this device
+            case 'B': // ...or of every device
+                if (vlc_pid > 0 || total_tuners == 0) break;
+                if (persistent_message) free(persistent_message);
+                persistent_message = scan_band(status_win, tuners, total_tuners, highlight, &chan_list, ch == 'B');
+                if (active_poller) status_poller_kick(active_poller);
+                break;
+
+            case 'e': // Capture every locked tuner on this device at once
+            case 'E': // ...or on every device
+                if (vlc_pid > 0) break;
+                if (persistent_message) free(persistent_message);
+                persistent_message = capture_locked_tuners(status_win, tuners, total_tuners, highlight, ch == 'E');
+                if (active_poller) status_poller_kick(active_poller);
+                break;
+
             case 'c':
                  if (!hd) break;
                  {
@@ -1868,6 +3047,7 @@ int main_loop() {
                         log_debug("Manual tune: set_tuner_channel returned %d", tune_result);
                         struct hdhomerun_tuner_status_t lock_status;
                         hdhomerun_device_wait_for_lock(hd, &lock_status);
+                        status_poller_kick(active_poller);
                         status_scroll_offset = 0;
                     }
                  }
@@ -1875,12 +3055,18 @@ int main_loop() {
 
             case 'h':
                 if (show_help_screen(status_win) == 1) {
-                    if (hd) hdhomerun_device_destroy(hd);
+                    destroy_device_pollers();
                     delwin(tuner_win); delwin(status_win);
                     return 0;
                 }
                 break;
             
+            case 'o': // Toggle the all-tuners dashboard
+                dashboard_mode = !dashboard_mode;
+                status_scroll_offset = 0;
+                log_debug("Dashboard: %s", dashboard_mode ? "enabled" : "disabled");
+                break;
+
             case 'w': // Hidden toggle for mouse scroll
                 mouse_scroll_enabled = !mouse_scroll_enabled;
                 break;
@@ -2011,6 +3197,7 @@ int main_loop() {
                                 hdhomerun_device_set_tuner_channel(hd, full_tune_str);
                                 struct hdhomerun_tuner_status_t lock_status;
                                 hdhomerun_device_wait_for_lock(hd, &lock_status);
+                                status_poller_kick(active_poller);
                                 status_scroll_offset = 0;
                             }
                         }
@@ -2046,6 +3233,227 @@ int main_loop() {
 }
 
 
+/*
+ * handle_headless_signal
+ * Asks run_headless to stop after the current sample.
+ */
+static void handle_headless_signal(int sig) {
+    (void)sig;
+    headless_stop = 1;
+}
+
+// One device's share of a headless L1 detail sample
+struct headless_l1_job {
+    pthread_t thread;
+    bool started;
+    struct hdhomerun_device_t *hd;
+    int count;
+    int tuner_index[MAX_TUNERS_TOTAL];
+    struct l1_detail_info *details[MAX_TUNERS_TOTAL];
+    struct l1_tracker *trackers[MAX_TUNERS_TOTAL];
+    bool ok[MAX_TUNERS_TOTAL];
+};
+
+/*
+ * headless_l1_worker
+ * Collects L1 details for each queued tuner of one device. Every job has
+ * its own device connection and query cache, so devices decode in parallel.
+ */
+static void* headless_l1_worker(void *arg) {
+    struct headless_l1_job *job = (struct headless_l1_job *)arg;
+    struct query_cache *cache = query_cache_create(QUERY_CACHE_DEFAULT_TTL_MS);
+    for (int k = 0; k < job->count; k++) {
+        job->ok[k] = collect_atsc3_details(job->hd, job->tuner_index[k], job->details[k], cache, job->trackers[k]) == 0;
+    }
+    query_cache_destroy(cache);
+    return NULL;
+}
+
+/*
+ * run_headless
+ * Daemon mode: polls every tuner in the background and periodically writes
+ * their metrics to the configured sink. Runs until SIGINT/SIGTERM.
+ */
+int run_headless(void) {
+    struct unified_tuner tuners[MAX_TUNERS_TOTAL];
+    int total_tuners = discover_and_build_tuner_list(tuners);
+    if (total_tuners == 0) {
+        if (target_device) fprintf(stderr, "HDHomeRun device '%s' not found.\n", target_device);
+        else fprintf(stderr, "No HDHomeRun devices found.\n");
+        return 1;
+    }
+
+    struct metrics_sink *sink = metrics_sink_open(metrics_target, metrics_fmt);
+    if (!sink) {
+        fprintf(stderr, "Unable to open metrics output '%s': %s\n", metrics_target, strerror(errno));
+        return 1;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handle_headless_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    // Pollers poll once on start, then only need to be as fresh as the
+    // samples taken from them; the UI rate would just load the devices
+    int first_poll_ms = poll_interval_ms;
+    if (metrics_interval_sec * 1000 > poll_interval_ms) poll_interval_ms = metrics_interval_sec * 1000;
+
+    update_poller_watch_masks(tuners, total_tuners, 0, true);
+    log_debug("Headless mode: %d tuners, polling every %d ms, publishing every %d s to %s",
+              total_tuners, poll_interval_ms, metrics_interval_sec, metrics_target);
+
+    struct tuner_status_snapshot *snaps = calloc(total_tuners, sizeof(struct tuner_status_snapshot));
+    struct metrics_tuner_info *infos = calloc(total_tuners, sizeof(struct metrics_tuner_info));
+    struct l1_detail_info **details = calloc(total_tuners, sizeof(struct l1_detail_info *));
+    struct hdhomerun_device_t *detail_hd[MAX_DEVICES] = {0};
+    struct headless_l1_job *l1_jobs = metrics_l1_details ? calloc(MAX_DEVICES, sizeof(struct headless_l1_job)) : NULL;
+    int l1_job_device[MAX_TUNERS_TOTAL], l1_job_slot[MAX_TUNERS_TOTAL];
+
+    // Give the pollers one cycle before the first sample
+    metrics_sink_wait(sink, first_poll_ms * 2);
+
+    while (!headless_stop && snaps && infos && details && (l1_jobs || !metrics_l1_details)) {
+        for (int d = 0; l1_jobs && d < MAX_DEVICES; d++) l1_jobs[d].count = 0;
+
+        for (int i = 0; i < total_tuners; i++) {
+            struct status_poller *poller = get_device_poller(&tuners[i]);
+            status_poller_get_snapshot(poller, tuners[i].tuner_index, &snaps[i]);
+
+            infos[i].device_id = tuners[i].device_id;
+            infos[i].tuner_index = tuners[i].tuner_index;
+            infos[i].ip_str = tuners[i].ip_str;
+            infos[i].snap = &snaps[i];
+            infos[i].details = NULL;
+            infos[i].l1 = NULL;
+            l1_job_device[i] = -1;
+
+            if (!metrics_l1_details || !snaps[i].valid || !strstr(snaps[i].status.lock_str, "atsc3")) continue;
+
+            // L1 details need their own connection; one per device, reused across samples
+            int d;
+            for (d = 0; d < device_poller_count && device_pollers[d] != poller; d++);
+            if (d >= device_poller_count) continue;
+            if (!detail_hd[d]) detail_hd[d] = hdhomerun_device_create_from_str(tuners[i].ip_str, NULL);
+            if (!detail_hd[d]) continue;
+
+            // Reused every sample; collect_atsc3_details resets its line arena
+            if (!details[i]) details[i] = create_l1_detail_info(MAX_DISPLAY_LINES);
+            if (!details[i]) continue;
+
+            struct headless_l1_job *job = &l1_jobs[d];
+            job->hd = detail_hd[d];
+            job->tuner_index[job->count] = tuners[i].tuner_index;
+            job->details[job->count] = details[i];
+            job->trackers[job->count] = get_l1_tracker(&tuners[i]);
+            l1_job_device[i] = d;
+            l1_job_slot[i] = job->count++;
+        }
+
+        // Decode L1 details for all devices at once, then attach the results
+        for (int d = 0; l1_jobs && d < MAX_DEVICES; d++) {
+            struct headless_l1_job *job = &l1_jobs[d];
+            job->started = job->count > 0 && pthread_create(&job->thread, NULL, headless_l1_worker, job) == 0;
+            if (job->count > 0 && !job->started) headless_l1_worker(job);
+        }
+        for (int d = 0; l1_jobs && d < MAX_DEVICES; d++) {
+            if (l1_jobs[d].started) pthread_join(l1_jobs[d].thread, NULL);
+            l1_jobs[d].started = false;
+        }
+        for (int i = 0; i < total_tuners; i++) {
+            if (l1_job_device[i] < 0) continue;
+            struct headless_l1_job *job = &l1_jobs[l1_job_device[i]];
+            if (job->ok[l1_job_slot[i]]) infos[i].details = details[i];
+            infos[i].l1 = job->trackers[l1_job_slot[i]];
+        }
+
+        if (metrics_sink_publish(sink, infos, total_tuners) != 0) {
+            log_debug("Headless mode: failed to publish metrics to %s", metrics_target);
+        }
+        metrics_sink_wait(sink, metrics_interval_sec * 1000);
+    }
+
+    log_debug("Headless mode stopping");
+    for (int i = 0; details && i < total_tuners; i++) {
+        if (details[i]) free_l1_detail_info(details[i]);
+    }
+    for (int d = 0; d < MAX_DEVICES; d++) {
+        if (detail_hd[d]) hdhomerun_device_destroy(detail_hd[d]);
+    }
+    free(l1_jobs);
+    free(details);
+    free(infos);
+    free(snaps);
+    destroy_device_pollers();
+    metrics_sink_close(sink);
+    return 0;
+}
+
+/*
+ * add_targets
+ * Adds the devices in a comma or whitespace separated list to target_list.
+ */
+static void add_targets(const char *list) {
+    char *copy = strdup(list);
+    if (!copy) return;
+    char *saveptr;
+    for (char *tok = strtok_r(copy, ", \t\r\n", &saveptr); tok && target_count < DIRECT_PROBE_MAX_TARGETS;
+         tok = strtok_r(NULL, ", \t\r\n", &saveptr)) {
+        target_list[target_count++] = strdup(tok);
+    }
+    free(copy);
+}
+
+/*
+ * load_hosts_file
+ * Adds every device listed in a hosts file; '#' starts a comment.
+ */
+static bool load_hosts_file(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        add_targets(line);
+    }
+    fclose(f);
+    return true;
+}
+
+/*
+ * parse_int_option
+ * Parses a whole-number option value in [min, max]. Prints an error and
+ * returns false on anything else, including trailing garbage.
+ */
+static bool parse_int_option(const char *what, const char *arg, long min, long max, int *out) {
+    char *end;
+    errno = 0;
+    long value = strtol(arg, &end, 10);
+    if (errno != 0 || end == arg || *end != '\0' || value < min || value > max) {
+        fprintf(stderr, "Invalid %s '%s' (expected %ld to %ld)\n", what, arg, min, max);
+        return false;
+    }
+    *out = (int)value;
+    return true;
+}
+
+/*
+ * join_targets
+ * Builds target_device from target_list for messages and logs.
+ */
+static void join_targets(void) {
+    static char joined[1024];
+    joined[0] = '\0';
+    for (int t = 0; t < target_count; t++) {
+        size_t len = strlen(joined);
+        snprintf(joined + len, sizeof(joined) - len, "%s%s", t ? "," : "", target_list[t]);
+    }
+    target_device = joined;
+}
+
 /*
  * main
  * Entry point of the application.
@@ -2054,27 +3462,136 @@ void print_usage(const char *program_name) {
     printf("HDHomeRun TUI v%s\n", TUI_VERSION);
     printf("Usage: %s [options]\n", program_name);
     printf("\nOptions:\n");
-    printf("  -d, --device <id|ip>    Specify HDHomeRun device by ID or IP address\n");
-    printf("                          Example: -d 12345678 or -d 192.168.1.100\n");
+    printf("  -d, --device <id|ip>    Specify HDHomeRun device(s) by ID or IP address\n");
+    printf("                          Example: -d 12345678 or -d 192.168.1.100,10.0.5.20\n");
+    printf("      --hosts <file>      Read devices to use from a file, one ID or IP per line\n");
+    printf("  -i, --interval <ms>     Tuner status poll interval in milliseconds (default %d)\n", STATUS_POLLER_DEFAULT_INTERVAL_MS);
+    printf("  -t, --capture-seconds <s>   Length of timed captures (default 30)\n");
+    printf("      --ring-segments <n>     Continuous capture: segment files in the ring (default %d)\n", ring_segment_count);
+    printf("      --ring-seconds <s>      Continuous capture: seconds per segment (default %d)\n", ring_segment_seconds);
+    printf("      --ring-keep <k>         Continuous capture: segments kept per error (default %d)\n", ring_keep_segments);
+    printf("      --ring-max-events <n>   Continuous capture: error events kept, later ones only logged (default %d)\n", ring_max_events);
+    printf("      --pretrigger-seconds <s>  Autorestart saves: seconds kept as a clip on error, 0 = off (default %d)\n", pretrigger_seconds);
+    printf("      --posttrigger-seconds <s> Autorestart saves: seconds recorded into the clip after the error (default %d)\n", posttrigger_seconds);
+    printf("      --scan-db <file>        Seek/scan results cache, 'none' to disable (default %s)\n", SCAN_DB_DEFAULT_PATH);
+    printf("      --scan-ttl <min>        Minutes a channel with no signal is skipped, 0 = never (default %d)\n", SCAN_DB_DEFAULT_TTL_SEC / 60);
+    printf("  -H, --headless          Run without the TUI, exporting tuner metrics\n");
+    printf("  -o, --metrics-out <dst> Metrics destination: '-' (stdout), a file, or unix:<path>\n");
+    printf("  -f, --metrics-format <fmt>  json (line-delimited, default) or prom\n");
+    printf("  -m, --metrics-interval <s>  Seconds between metric samples (default %d)\n", metrics_interval_sec);
+    printf("  -l, --l1                Include ATSC 3.0 L1 details in JSON metrics\n");
     printf("  -v, --verbose           Enable verbose debug logging to hdhomerun_tui.log\n");
     printf("  -h, --help              Show this help message\n");
     printf("\nIf no device is specified, all available devices will be discovered.\n");
 }
 
+// Long-only options
+enum {
+    OPT_RING_SEGMENTS = 256,
+    OPT_RING_SECONDS,
+    OPT_RING_KEEP,
+    OPT_RING_MAX_EVENTS,
+    OPT_PRETRIGGER_SECONDS,
+    OPT_POSTTRIGGER_SECONDS,
+    OPT_SCAN_DB,
+    OPT_SCAN_TTL,
+    OPT_HOSTS,
+};
+
 int main(int argc, char *argv[]) {
     // Parse command line arguments
     int opt;
     static struct option long_options[] = {
         {"device", required_argument, 0, 'd'},
+        {"hosts", required_argument, 0, OPT_HOSTS},
+        {"interval", required_argument, 0, 'i'},
+        {"capture-seconds", required_argument, 0, 't'},
+        {"ring-segments", required_argument, 0, OPT_RING_SEGMENTS},
+        {"ring-seconds", required_argument, 0, OPT_RING_SECONDS},
+        {"ring-keep", required_argument, 0, OPT_RING_KEEP},
+        {"ring-max-events", required_argument, 0, OPT_RING_MAX_EVENTS},
+        {"pretrigger-seconds", required_argument, 0, OPT_PRETRIGGER_SECONDS},
+        {"posttrigger-seconds", required_argument, 0, OPT_POSTTRIGGER_SECONDS},
+        {"scan-db", required_argument, 0, OPT_SCAN_DB},
+        {"scan-ttl", required_argument, 0, OPT_SCAN_TTL},
+        {"headless", no_argument, 0, 'H'},
+        {"metrics-out", required_argument, 0, 'o'},
+        {"metrics-format", required_argument, 0, 'f'},
+        {"metrics-interval", required_argument, 0, 'm'},
+        {"l1", no_argument, 0, 'l'},
         {"verbose", no_argument, 0, 'v'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
 
-    while ((opt = getopt_long(argc, argv, "d:vh", long_options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "d:i:t:Ho:f:m:lvh", long_options, NULL)) != -1) {
         switch (opt) {
             case 'd':
-                target_device = optarg;
+                add_targets(optarg);
+                break;
+            case OPT_HOSTS:
+                if (!load_hosts_file(optarg)) {
+                    fprintf(stderr, "Unable to read hosts file '%s': %s\n", optarg, strerror(errno));
+                    return 1;
+                }
+                break;
+            case 'i':
+                poll_interval_ms = atoi(optarg);
+                if (poll_interval_ms < 50) poll_interval_ms = 50;
+                break;
+            case 't': {
+                int seconds;
+                if (!parse_int_option("capture length", optarg, 1, MAX_CAPTURE_SECONDS, &seconds)) return 1;
+                capture_duration_ms = seconds * 1000;
+                break;
+            }
+            case OPT_RING_SEGMENTS:
+                if (!parse_int_option("ring segment count", optarg, 2, CAPTURE_RING_MAX_SEGMENTS, &ring_segment_count)) return 1;
+                break;
+            case OPT_RING_SECONDS:
+                // Same ceiling as -t, so seconds * 1000 fits an int
+                if (!parse_int_option("ring segment length", optarg, 1, MAX_CAPTURE_SECONDS, &ring_segment_seconds)) return 1;
+                break;
+            case OPT_RING_KEEP:
+                if (!parse_int_option("ring keep count", optarg, 1, CAPTURE_RING_MAX_SEGMENTS - 1, &ring_keep_segments)) return 1;
+                break;
+            case OPT_RING_MAX_EVENTS:
+                // Event numbers are three digits in the file name
+                if (!parse_int_option("ring event limit", optarg, 1, 999, &ring_max_events)) return 1;
+                break;
+            case OPT_PRETRIGGER_SECONDS:
+                pretrigger_seconds = atoi(optarg);
+                if (pretrigger_seconds < 0) pretrigger_seconds = 0;
+                break;
+            case OPT_POSTTRIGGER_SECONDS:
+                posttrigger_seconds = atoi(optarg);
+                if (posttrigger_seconds < 0) posttrigger_seconds = 0;
+                break;
+            case OPT_SCAN_DB:
+                scan_db_path = optarg;
+                break;
+            case OPT_SCAN_TTL:
+                scan_db_ttl_sec = atoi(optarg) * 60;
+                if (scan_db_ttl_sec < 0) scan_db_ttl_sec = 0;
+                break;
+            case 'H':
+                headless_mode = true;
+                break;
+            case 'o':
+                metrics_target = optarg;
+                break;
+            case 'f':
+                if (!metrics_parse_format(optarg, &metrics_fmt)) {
+                    fprintf(stderr, "Unknown metrics format '%s' (expected json or prom)\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'm':
+                metrics_interval_sec = atoi(optarg);
+                if (metrics_interval_sec < 1) metrics_interval_sec = 1;
+                break;
+            case 'l':
+                metrics_l1_details = true;
                 break;
             case 'v':
                 verbose_mode = true;
@@ -2082,9 +3599,6 @@ int main(int argc, char *argv[]) {
                 if (debug_log_file) {
                     log_debug("=== HDHomeRun TUI Debug Log Started ===");
                     log_debug("Version: %s", TUI_VERSION);
-                    if (target_device) {
-                        log_debug("Target device: %s", target_device);
-                    }
                 }
                 break;
             case 'h':
@@ -2096,6 +3610,21 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (target_count > 0) {
+        join_targets();
+        log_debug("Target device: %s", target_device);
+    }
+
+    if (headless_mode) {
+        int result = run_headless();
+        log_debug("=== HDHomeRun TUI Exiting ===");
+        if (debug_log_file) {
+            fclose(debug_log_file);
+            debug_log_file = NULL;
+        }
+        return result;
+    }
+
     initscr();
     clear();
     noecho();
@@ -2116,6 +3645,9 @@ int main(int argc, char *argv[]) {
     init_pair(2, COLOR_YELLOW, COLOR_BLACK);
     init_pair(3, COLOR_GREEN, COLOR_BLACK);
 
+    if (strcmp(scan_db_path, "none") != 0) scan_db = scan_db_open(scan_db_path, scan_db_ttl_sec);
+    device_pool = device_pool_create(DEVICE_POOL_DEFAULT_IDLE_MS);
+
     while (1) {
         int result = main_loop();
         if (result == 0) { // Quit
@@ -2137,6 +3669,9 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    finish_background_discovery(NULL, true);
+    device_pool_destroy(device_pool);
+    scan_db_close(scan_db);
     log_debug("=== HDHomeRun TUI Exiting ===");
     if (debug_log_file) {
         fclose(debug_log_file);
@@ -2150,13 +3685,15 @@ int main(int argc, char *argv[]) {
  * Modified show_plp_details_screen function - much simpler now
  */
 int show_plp_details_screen(WINDOW *parent_win, struct hdhomerun_device_t *hd, struct unified_tuner *tuner_info) {
-    // Create detail info structure
-    struct l1_detail_info* detail_info = create_l1_detail_info(MAX_DISPLAY_LINES);
+    // Kept between openings so the line arena is reused; collect resets it
+    static struct l1_detail_info *detail_info = NULL;
+    if (!detail_info) detail_info = create_l1_detail_info(MAX_DISPLAY_LINES);
     if (!detail_info) return 0;
+    struct query_cache *qc = query_cache_create(QUERY_CACHE_DEFAULT_TTL_MS);
     
     // Collect the details using the abstracted function
-    if (collect_atsc3_details(hd, tuner_info->tuner_index, detail_info) != 0) {
-        free_l1_detail_info(detail_info);
+    if (collect_atsc3_details(hd, tuner_info->tuner_index, detail_info, qc, get_l1_tracker(tuner_info)) != 0) {
+        query_cache_destroy(qc);
         return 0;
     }
 
@@ -2216,26 +3753,18 @@ int show_plp_details_screen(WINDOW *parent_win, struct hdhomerun_device_t *hd, s
                     char *status_str_s, *plpinfo_str_s, *streaminfo_str_s;
                     struct hdhomerun_tuner_status_t status_s;
                     
-                    if (hdhomerun_device_get_tuner_status(hd, &status_str_s, &status_s) > 0) {
+                    if (query_cache_get_tuner_status(qc, hd, &status_str_s, &status_s) > 0) {
                         char *p = strchr(status_s.channel, ':');
                         if (!p) p = status_s.channel; else p++;
                         if (isdigit((unsigned char)*p)) rf_channel = strtoul(p, NULL, 10);
                     }
                     
-                    if (hdhomerun_device_get_tuner_streaminfo(hd, &streaminfo_str_s) > 0) {
-                        char *si_copy = strdup(streaminfo_str_s);
-                        if (si_copy) {
-                            id_val = parse_status_value_l1(si_copy, "tsid=");
-                            free(si_copy);
-                        }
+                    if (query_cache_get_tuner_streaminfo(qc, hd, &streaminfo_str_s) > 0) {
+                        id_val = status_fields_lookup(streaminfo_str_s, STATUS_KEY_TSID);
                     }
-                    if (hdhomerun_device_get_tuner_plpinfo(hd, &plpinfo_str_s) > 0) {
-                        char *pi_copy = strdup(plpinfo_str_s);
-                        if(pi_copy) {
-                            long bsid_s = parse_status_value_l1(pi_copy, "bsid=");
-                            if (bsid_s != -999) id_val = bsid_s;
-                            free(pi_copy);
-                        }
+                    if (query_cache_get_tuner_plpinfo(qc, hd, &plpinfo_str_s) > 0) {
+                        long bsid_s = status_fields_lookup(plpinfo_str_s, STATUS_KEY_BSID);
+                        if (bsid_s != -999) id_val = bsid_s;
                     }
                     if (id_val == -999) id_val = 0;
 
@@ -2255,13 +3784,13 @@ int show_plp_details_screen(WINDOW *parent_win, struct hdhomerun_device_t *hd, s
                 break;
             case 'q':
                 delwin(detail_win);
-                free_l1_detail_info(detail_info);
+                query_cache_destroy(qc);
                 return 1; // Quit requested
             case 'd':
             case '\n':
             case '\r':
                 delwin(detail_win);
-                free_l1_detail_info(detail_info);
+                query_cache_destroy(qc);
                 nodelay(stdscr, TRUE);
                 return 0;
         }
@@ -17,115 +17,271 @@
 #include <string.h>
 #include <ctype.h>
 #include <time.h>
+#include <stdarg.h>
 #include "l1_detail_parser.h"
 #include "hdhomerun.h"
 #include "hdhomerun_device.h"
+#include "query_cache.h"
+#include "status_fields.h"
 
 // ATSC 3.0 SNR Lookup Table
-static const struct modcod_snr_complete {
-    char mod[16];
-    char cod[8];
-    float awgn_long;
-    float rayleigh_long;
-    float awgn_short;
-    float rayleigh_short;
-} snr_table_complete[] = {
-    // QPSK
-    {"QPSK", "2/15", -6.23, -5.72, -5.55, -5.06}, {"QPSK", "3/15", -4.32, -3.62, -3.73, -2.97},
-    {"QPSK", "4/15", -2.89, -1.97, -2.32, -1.36}, {"QPSK", "5/15", -1.70, -0.55, -1.30, -0.08},
-    {"QPSK", "6/15", -0.54, 0.86, -0.33, 1.15}, {"QPSK", "7/15", 0.30, 1.95, 0.56, 2.30},
-    {"QPSK", "8/15", 1.16, 3.16, 1.38, 3.44}, {"QPSK", "9/15", 1.97, 4.35, 2.20, 4.70},
-    {"QPSK", "10/15", 2.77, 5.62, 2.94, 5.97}, {"QPSK", "11/15", 3.60, 7.05, 3.82, 7.46},
-    {"QPSK", "12/15", 4.49, 8.76, 4.70, 9.15}, {"QPSK", "13/15", 5.53, 10.97, 5.76, 11.56},
-    
-    // 16QAM
-    {"16QAM", "2/15", -2.73, -1.84, -2.15, -1.14}, {"16QAM", "3/15", -0.25, 0.81, 0.35, 1.45},
-    {"16QAM", "4/15", 1.46, 2.69, 1.99, 3.41}, {"16QAM", "5/15", 2.82, 4.32, 3.16, 4.78},
-    {"16QAM", "6/15", 4.21, 5.98, 4.45, 6.27}, {"16QAM", "7/15", 5.21, 7.21, 5.51, 7.58},
-    {"16QAM", "8/15", 6.30, 8.63, 6.51, 8.96}, {"16QAM", "9/15", 7.32, 9.94, 7.58, 10.28},
-    {"16QAM", "10/15", 8.36, 11.40, 8.59, 11.73}, {"16QAM", "11/15", 9.50, 12.78, 9.74, 13.22},
-    {"16QAM", "12/15", 10.57, 14.60, 10.81, 14.97}, {"16QAM", "13/15", 11.83, 16.85, 12.09, 17.44},
-    
-    // 64QAM
-    {"64QAM", "2/15", -0.26, 0.86, 0.35, 1.60}, {"64QAM", "3/15", 2.27, 3.61, 2.85, 4.30},
-    {"64QAM", "4/15", 4.15, 5.88, 4.65, 6.55}, {"64QAM", "5/15", 5.96, 7.74, 6.30, 8.29},
-    {"64QAM", "6/15", 7.66, 9.72, 7.93, 10.05}, {"64QAM", "7/15", 8.92, 11.10, 9.29, 11.54},
-    {"64QAM", "8/15", 10.31, 12.75, 10.56, 13.09}, {"64QAM", "9/15", 11.55, 14.25, 11.83, 14.62},
-    {"64QAM", "10/15", 12.88, 15.81, 13.13, 16.20}, {"64QAM", "11/15", 14.28, 17.44, 14.52, 17.87},
-    {"64QAM", "12/15", 15.57, 19.39, 15.86, 19.82}, {"64QAM", "13/15", 17.03, 21.82, 17.33, 22.44},
-    
-    // 256QAM
-    {"256QAM", "2/15", 1.60, 2.89, 2.27, 3.60}, {"256QAM", "3/15", 4.30, 5.97, 4.78, 6.79},
-    {"256QAM", "4/15", 6.57, 8.46, 7.19, 9.32}, {"256QAM", "5/15", 8.53, 10.59, 8.93, 11.16},
-    {"256QAM", "6/15", 10.61, 12.92, 10.91, 13.29}, {"256QAM", "7/15", 12.10, 14.58, 12.57, 15.15},
-    {"256QAM", "8/15", 13.91, 16.54, 14.25, 16.95}, {"256QAM", "9/15", 15.55, 18.23, 15.80, 18.64},
-    {"256QAM", "10/15", 17.13, 20.06, 17.45, 20.50}, {"256QAM", "11/15", 18.76, 21.94, 19.08, 22.40},
-    {"256QAM", "12/15", 20.44, 24.01, 20.78, 24.54}, {"256QAM", "13/15", 22.22, 26.62, 22.55, 27.23},
-    
-    // 1024QAM
-    {"1024QAM", "2/15", 3.23, 4.65, 0.0, 0.0}, {"1024QAM", "3/15", 6.17, 8.04, 0.0, 0.0},
-    {"1024QAM", "4/15", 8.77, 10.85, 0.0, 0.0}, {"1024QAM", "5/15", 11.07, 13.25, 0.0, 0.0},
-    {"1024QAM", "6/15", 13.46, 15.91, 0.0, 0.0}, {"1024QAM", "7/15", 15.30, 17.84, 0.0, 0.0},
-    {"1024QAM", "8/15", 17.46, 20.13, 0.0, 0.0}, {"1024QAM", "9/15", 19.45, 22.34, 0.0, 0.0},
-    {"1024QAM", "10/15", 21.35, 24.47, 0.0, 0.0}, {"1024QAM", "11/15", 23.43, 26.61, 0.0, 0.0},
-    {"1024QAM", "12/15", 25.52, 28.82, 0.0, 0.0}, {"1024QAM", "13/15", 27.62, 31.59, 0.0, 0.0},
-    
-    // 4096QAM
-    {"4096QAM", "2/15", 4.58, 6.23, 0.0, 0.0}, {"4096QAM", "3/15", 7.85, 9.83, 0.0, 0.0},
-    {"4096QAM", "4/15", 10.73, 12.95, 0.0, 0.0}, {"4096QAM", "5/15", 13.45, 15.75, 0.0, 0.0},
-    {"4096QAM", "6/15", 16.04, 18.79, 0.0, 0.0}, {"4096QAM", "7/15", 18.22, 21.03, 0.0, 0.0},
-    {"4096QAM", "8/15", 20.69, 23.67, 0.0, 0.0}, {"4096QAM", "9/15", 23.05, 26.37, 0.0, 0.0},
-    {"4096QAM", "10/15", 25.55, 28.64, 0.0, 0.0}, {"4096QAM", "11/15", 28.11, 31.18, 0.0, 0.0},
-    {"4096QAM", "12/15", 30.34, 33.82, 0.0, 0.0}, {"4096QAM", "13/15", 32.83, 36.54, 0.0, 0.0},
-    
-    {{0}} // Sentinel
+// Indexed by constellation, code rate and LDPC length (0 = short 16200,
+// 1 = long 64800). Short LDPC is not defined for 1024QAM and 4096QAM; those
+// entries are 0.0.
+struct snr_requirement {
+    float awgn;
+    float rayleigh;
 };
 
-// Base64 decoding tables
-static int b64invs[] = { 62, -1, -1, -1, 63, 52, 53, 54, 55, 56, 57, 58,
-    59, 60, 61, -1, -1, -1, -1, -1, -1, -1, 0, 1, 2, 3, 4, 5,
-    6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
-    21, 22, 23, 24, 25, -1, -1, -1, -1, -1, -1, 26, 27, 28,
-    29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42,
-    43, 44, 45, 46, 47, 48, 49, 50, 51 };
+static const struct snr_requirement snr_table[MOD_4096QAM + 1][C13_15 + 1][2] = {
+    [MOD_QPSK] = {
+        [C2_15]  = { {  -5.55,  -5.06 }, {  -6.23,  -5.72 } },
+        [C3_15]  = { {  -3.73,  -2.97 }, {  -4.32,  -3.62 } },
+        [C4_15]  = { {  -2.32,  -1.36 }, {  -2.89,  -1.97 } },
+        [C5_15]  = { {  -1.30,  -0.08 }, {  -1.70,  -0.55 } },
+        [C6_15]  = { {  -0.33,   1.15 }, {  -0.54,   0.86 } },
+        [C7_15]  = { {   0.56,   2.30 }, {   0.30,   1.95 } },
+        [C8_15]  = { {   1.38,   3.44 }, {   1.16,   3.16 } },
+        [C9_15]  = { {   2.20,   4.70 }, {   1.97,   4.35 } },
+        [C10_15] = { {   2.94,   5.97 }, {   2.77,   5.62 } },
+        [C11_15] = { {   3.82,   7.46 }, {   3.60,   7.05 } },
+        [C12_15] = { {   4.70,   9.15 }, {   4.49,   8.76 } },
+        [C13_15] = { {   5.76,  11.56 }, {   5.53,  10.97 } },
+    },
+    [MOD_16QAM] = {
+        [C2_15]  = { {  -2.15,  -1.14 }, {  -2.73,  -1.84 } },
+        [C3_15]  = { {   0.35,   1.45 }, {  -0.25,   0.81 } },
+        [C4_15]  = { {   1.99,   3.41 }, {   1.46,   2.69 } },
+        [C5_15]  = { {   3.16,   4.78 }, {   2.82,   4.32 } },
+        [C6_15]  = { {   4.45,   6.27 }, {   4.21,   5.98 } },
+        [C7_15]  = { {   5.51,   7.58 }, {   5.21,   7.21 } },
+        [C8_15]  = { {   6.51,   8.96 }, {   6.30,   8.63 } },
+        [C9_15]  = { {   7.58,  10.28 }, {   7.32,   9.94 } },
+        [C10_15] = { {   8.59,  11.73 }, {   8.36,  11.40 } },
+        [C11_15] = { {   9.74,  13.22 }, {   9.50,  12.78 } },
+        [C12_15] = { {  10.81,  14.97 }, {  10.57,  14.60 } },
+        [C13_15] = { {  12.09,  17.44 }, {  11.83,  16.85 } },
+    },
+    [MOD_64QAM] = {
+        [C2_15]  = { {   0.35,   1.60 }, {  -0.26,   0.86 } },
+        [C3_15]  = { {   2.85,   4.30 }, {   2.27,   3.61 } },
+        [C4_15]  = { {   4.65,   6.55 }, {   4.15,   5.88 } },
+        [C5_15]  = { {   6.30,   8.29 }, {   5.96,   7.74 } },
+        [C6_15]  = { {   7.93,  10.05 }, {   7.66,   9.72 } },
+        [C7_15]  = { {   9.29,  11.54 }, {   8.92,  11.10 } },
+        [C8_15]  = { {  10.56,  13.09 }, {  10.31,  12.75 } },
+        [C9_15]  = { {  11.83,  14.62 }, {  11.55,  14.25 } },
+        [C10_15] = { {  13.13,  16.20 }, {  12.88,  15.81 } },
+        [C11_15] = { {  14.52,  17.87 }, {  14.28,  17.44 } },
+        [C12_15] = { {  15.86,  19.82 }, {  15.57,  19.39 } },
+        [C13_15] = { {  17.33,  22.44 }, {  17.03,  21.82 } },
+    },
+    [MOD_256QAM] = {
+        [C2_15]  = { {   2.27,   3.60 }, {   1.60,   2.89 } },
+        [C3_15]  = { {   4.78,   6.79 }, {   4.30,   5.97 } },
+        [C4_15]  = { {   7.19,   9.32 }, {   6.57,   8.46 } },
+        [C5_15]  = { {   8.93,  11.16 }, {   8.53,  10.59 } },
+        [C6_15]  = { {  10.91,  13.29 }, {  10.61,  12.92 } },
+        [C7_15]  = { {  12.57,  15.15 }, {  12.10,  14.58 } },
+        [C8_15]  = { {  14.25,  16.95 }, {  13.91,  16.54 } },
+        [C9_15]  = { {  15.80,  18.64 }, {  15.55,  18.23 } },
+        [C10_15] = { {  17.45,  20.50 }, {  17.13,  20.06 } },
+        [C11_15] = { {  19.08,  22.40 }, {  18.76,  21.94 } },
+        [C12_15] = { {  20.78,  24.54 }, {  20.44,  24.01 } },
+        [C13_15] = { {  22.55,  27.23 }, {  22.22,  26.62 } },
+    },
+    [MOD_1024QAM] = {
+        [C2_15]  = { {    0.0,    0.0 }, {   3.23,   4.65 } },
+        [C3_15]  = { {    0.0,    0.0 }, {   6.17,   8.04 } },
+        [C4_15]  = { {    0.0,    0.0 }, {   8.77,  10.85 } },
+        [C5_15]  = { {    0.0,    0.0 }, {  11.07,  13.25 } },
+        [C6_15]  = { {    0.0,    0.0 }, {  13.46,  15.91 } },
+        [C7_15]  = { {    0.0,    0.0 }, {  15.30,  17.84 } },
+        [C8_15]  = { {    0.0,    0.0 }, {  17.46,  20.13 } },
+        [C9_15]  = { {    0.0,    0.0 }, {  19.45,  22.34 } },
+        [C10_15] = { {    0.0,    0.0 }, {  21.35,  24.47 } },
+        [C11_15] = { {    0.0,    0.0 }, {  23.43,  26.61 } },
+        [C12_15] = { {    0.0,    0.0 }, {  25.52,  28.82 } },
+        [C13_15] = { {    0.0,    0.0 }, {  27.62,  31.59 } },
+    },
+    [MOD_4096QAM] = {
+        [C2_15]  = { {    0.0,    0.0 }, {   4.58,   6.23 } },
+        [C3_15]  = { {    0.0,    0.0 }, {   7.85,   9.83 } },
+        [C4_15]  = { {    0.0,    0.0 }, {  10.73,  12.95 } },
+        [C5_15]  = { {    0.0,    0.0 }, {  13.45,  15.75 } },
+        [C6_15]  = { {    0.0,    0.0 }, {  16.04,  18.79 } },
+        [C7_15]  = { {    0.0,    0.0 }, {  18.22,  21.03 } },
+        [C8_15]  = { {    0.0,    0.0 }, {  20.69,  23.67 } },
+        [C9_15]  = { {    0.0,    0.0 }, {  23.05,  26.37 } },
+        [C10_15] = { {    0.0,    0.0 }, {  25.55,  28.64 } },
+        [C11_15] = { {    0.0,    0.0 }, {  28.11,  31.18 } },
+        [C12_15] = { {    0.0,    0.0 }, {  30.34,  33.82 } },
+        [C13_15] = { {    0.0,    0.0 }, {  32.83,  36.54 } },
+    },
+};
 
-// Global variables for bit parser
+// Base64 decoding table, indexed by character
+// Values are 0-63 for the base64 alphabet and B64_INVALID for everything
+// else, including '=', which only the last group handles.
+#define B64_INVALID 0xFF
+static const uint8_t b64_lut[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+     52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+    255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+    255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+
+// Bit reader over the packed L1 bytes. Each parse keeps its own reader,
+// so the parser holds no global state between calls.
 #define L1_DUMP_BUFFER_SIZE 512
-static char bits[L1_DUMP_BUFFER_SIZE * 8];
-static int bits_index = 0;
+#define L1_MAX_FIELD_BITS 56
+
+struct l1_bit_reader {
+    const unsigned char *data;
+    size_t len;         // Bytes available
+    size_t pos;         // Next bit to read
+    size_t limit;       // Reads that would cross this return 0
+};
+
+// Display lines are bump-allocated from a chain of blocks owned by the
+// l1_detail_info. Resetting rewinds every block, so a refresh that produces
+// a similar amount of text allocates nothing.
+#define L1_LINE_BLOCK_SIZE (64 * 1024)
+
+struct l1_line_block {
+    struct l1_line_block *next;
+    size_t size;
+    size_t used;
+    char data[];
+};
+
+struct l1_line_arena {
+    struct l1_line_block *first;
+    struct l1_line_block *current;
+};
 
-// Helper to add a line to the display buffer safely
-#define add_line(info, ...) \
-    if ((info)->line_count < (info)->max_lines) { \
-        char line_buf[512]; \
-        snprintf(line_buf, sizeof(line_buf), __VA_ARGS__); \
-        (info)->display_lines[(info)->line_count++] = strdup(line_buf); \
+/*
+ * store_line
+ * Copies a line into the info's arena. An l1_detail_info without an arena
+ * (parse_l1_data_l1's caller-owned arrays) gets a plain strdup.
+ */
+static char* store_line(struct l1_detail_info *info, const char *text) {
+    struct l1_line_arena *arena = info->arena;
+    if (!arena) return strdup(text);
+
+    size_t len = strlen(text) + 1;
+    struct l1_line_block *block = arena->current;
+    while (block && block->size - block->used < len) {
+        block = block->next;
     }
+    if (!block) {
+        size_t size = len > L1_LINE_BLOCK_SIZE ? len : L1_LINE_BLOCK_SIZE;
+        block = malloc(sizeof(struct l1_line_block) + size);
+        if (!block) return NULL;
+        block->size = size;
+        block->used = 0;
+        block->next = NULL;
+        if (arena->current) {
+            // Splice in after the current block so later spares stay reachable
+            block->next = arena->current->next;
+            arena->current->next = block;
+        } else {
+            arena->first = block;
+        }
+    }
+    arena->current = block;
+
+    char *line = block->data + block->used;
+    memcpy(line, text, len);
+    block->used += len;
+    return line;
+}
+
+/*
+ * add_line
+ * Appends a formatted line to the detail output, dropping it once the
+ * buffer is full. All output goes through here so nothing writes past
+ * max_lines.
+ */
+static void add_line(struct l1_detail_info *info, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static void add_line(struct l1_detail_info *info, const char *fmt, ...) {
+    if (info->line_count >= info->max_lines) return;
+    char line_buf[512];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line_buf, sizeof(line_buf), fmt, args);
+    va_end(args);
+    char *line = store_line(info, line_buf);
+    if (line) info->display_lines[info->line_count++] = line;
+}
 
 // Function implementations
 struct l1_detail_info* create_l1_detail_info(int max_lines) {
-    struct l1_detail_info* info = malloc(sizeof(struct l1_detail_info));
+    struct l1_detail_info* info = calloc(1, sizeof(struct l1_detail_info));
     if (!info) return NULL;
     
     info->display_lines = malloc(max_lines * sizeof(char*));
-    if (!info->display_lines) {
+    info->arena = calloc(1, sizeof(struct l1_line_arena));
+    if (!info->display_lines || !info->arena) {
+        free(info->display_lines);
+        free(info->arena);
         free(info);
         return NULL;
     }
     
-    info->line_count = 0;
     info->max_lines = max_lines;
-    info->context.ldpc_info_available = false;
-    info->context.ldpc_length = -1;
+    l1_detail_info_reset(info);
     
     return info;
 }
 
+void l1_detail_info_reset(struct l1_detail_info *info) {
+    if (!info) return;
+
+    if (info->arena) {
+        for (struct l1_line_block *block = info->arena->first; block; block = block->next) {
+            block->used = 0;
+        }
+        info->arena->current = info->arena->first;
+    } else {
+        for (int i = 0; i < info->line_count; i++) {
+            free(info->display_lines[i]);
+        }
+    }
+    info->line_count = 0;
+    info->context.ldpc_info_available = false;
+    info->context.ldpc_length = -1;
+    if (info->decoded) {
+        l1_decoded_free(info->decoded);
+        free(info->decoded);
+        info->decoded = NULL;
+    }
+}
+
 void free_l1_detail_info(struct l1_detail_info* info) {
     if (!info) return;
     
-    for (int i = 0; i < info->line_count; i++) {
-        free(info->display_lines[i]);
+    l1_detail_info_reset(info);
+    if (info->arena) {
+        struct l1_line_block *block = info->arena->first;
+        while (block) {
+            struct l1_line_block *next = block->next;
+            free(block);
+            block = next;
+        }
+        free(info->arena);
     }
     free(info->display_lines);
     free(info);
@@ -160,61 +316,108 @@ void normalize_mod_str_l1(const char *in, char *out, size_t out_size) {
     }
 }
 
-struct snr_pair_result get_snr_pair_for_modcod_l1(const char* mod, const char* cod, int ldpc_length) {
-    struct snr_pair_result result = {false, false, 0.0, 0.0, 0.0, 0.0, ""};
-    
-    const struct modcod_snr_complete* entry = NULL;
-    for (int i = 0; snr_table_complete[i].mod[0] != 0; i++) {
-        if (strcmp(snr_table_complete[i].mod, mod) == 0 && strcmp(snr_table_complete[i].cod, cod) == 0) {
-            entry = &snr_table_complete[i];
-            break;
+/*
+ * mod_from_name_l1
+ * Maps a plpinfo or table modulation name ("qam256", "256QAM", "qpsk") to
+ * its constellation enum without copying it. Digits and letters are read
+ * separately, the way normalize_mod_str_l1 reorders them.
+ */
+int mod_from_name_l1(const char *name, size_t len) {
+    long value = 0;
+    int digits = 0;
+    char letters[5];
+    int letter_count = 0;
+
+    for (size_t i = 0; i < len && name[i] && name[i] != ' '; i++) {
+        unsigned char c = (unsigned char)name[i];
+        if (isdigit(c)) {
+            if (++digits > 4) return -1;
+            value = value * 10 + (c - '0');
+        } else {
+            if (letter_count == 4) return -1;
+            letters[letter_count++] = (char)toupper(c);
         }
     }
-    
-    if (!entry) return result;
-    
+    letters[letter_count] = '\0';
+
+    if (digits == 0) return strcmp(letters, "QPSK") == 0 ? MOD_QPSK : -1;
+    if (strcmp(letters, "QAM") != 0) return -1;
+    switch (value) {
+        case 16:   return digits == 2 ? MOD_16QAM : -1;
+        case 64:   return digits == 2 ? MOD_64QAM : -1;
+        case 256:  return digits == 3 ? MOD_256QAM : -1;
+        case 1024: return digits == 4 ? MOD_1024QAM : -1;
+        case 4096: return digits == 4 ? MOD_4096QAM : -1;
+        default:   return -1;
+    }
+}
+
+/*
+ * cod_from_name_l1
+ * Maps "2/15" through "13/15" to the code rate enum.
+ */
+int cod_from_name_l1(const char *name, size_t len) {
+    size_t i = 0;
+    int numerator = 0;
+
+    while (i < len && i < 2 && isdigit((unsigned char)name[i])) {
+        numerator = numerator * 10 + (name[i] - '0');
+        i++;
+    }
+    if (i == 0 || (name[0] == '0')) return -1;
+    if (len - i < 3 || name[i] != '/' || name[i + 1] != '1' || name[i + 2] != '5') return -1;
+    i += 3;
+    if (i < len && name[i] && name[i] != ' ') return -1;
+    if (numerator < 2 || numerator > 13) return -1;
+    return C2_15 + (numerator - 2);
+}
+
+struct snr_pair_result get_snr_pair_l1(int mod, int cod, int ldpc_length) {
+    struct snr_pair_result result = {false, false, 0.0, 0.0, 0.0, 0.0, ""};
+
+    if (mod < MOD_QPSK || mod > MOD_4096QAM || cod < C2_15 || cod > C13_15) return result;
+    const struct snr_requirement *shrt = &snr_table[mod][cod][0];
+    const struct snr_requirement *lng = &snr_table[mod][cod][1];
+    bool short_defined = shrt->awgn != 0.0 && shrt->rayleigh != 0.0;
+
     result.found = true;
-    
+
     if (ldpc_length == 0) {
-        if (entry->awgn_short != 0.0 && entry->rayleigh_short != 0.0) {
-            result.ldpc_length_known = true;
-            result.awgn_min = result.awgn_max = entry->awgn_short;
-            result.rayleigh_min = result.rayleigh_max = entry->rayleigh_short;
-            strcpy(result.description, "Short LDPC (16200)");
-        } else {
-            result.ldpc_length_known = true;
-            result.awgn_min = result.awgn_max = entry->awgn_long;
-            result.rayleigh_min = result.rayleigh_max = entry->rayleigh_long;
-            strcpy(result.description, "Long LDPC (64800) - Short unavailable");
-        }
+        result.ldpc_length_known = true;
+        const struct snr_requirement *entry = short_defined ? shrt : lng;
+        result.awgn_min = result.awgn_max = entry->awgn;
+        result.rayleigh_min = result.rayleigh_max = entry->rayleigh;
+        result.description = short_defined ? "Short LDPC (16200)" : "Long LDPC (64800) - Short unavailable";
     } else if (ldpc_length == 1) {
         result.ldpc_length_known = true;
-        result.awgn_min = result.awgn_max = entry->awgn_long;
-        result.rayleigh_min = result.rayleigh_max = entry->rayleigh_long;
-        strcpy(result.description, "Long LDPC (64800)");
+        result.awgn_min = result.awgn_max = lng->awgn;
+        result.rayleigh_min = result.rayleigh_max = lng->rayleigh;
+        result.description = "Long LDPC (64800)";
     } else {
         result.ldpc_length_known = false;
-        
-        result.awgn_min = entry->awgn_long;
-        result.awgn_max = entry->awgn_long;
-        if (entry->awgn_short != 0.0) {
-            if (entry->awgn_short < result.awgn_min) result.awgn_min = entry->awgn_short;
-            if (entry->awgn_short > result.awgn_max) result.awgn_max = entry->awgn_short;
+
+        result.awgn_min = result.awgn_max = lng->awgn;
+        if (shrt->awgn != 0.0) {
+            if (shrt->awgn < result.awgn_min) result.awgn_min = shrt->awgn;
+            if (shrt->awgn > result.awgn_max) result.awgn_max = shrt->awgn;
         }
-        
-        result.rayleigh_min = entry->rayleigh_long;
-        result.rayleigh_max = entry->rayleigh_long;
-        if (entry->rayleigh_short != 0.0) {
-            if (entry->rayleigh_short < result.rayleigh_min) result.rayleigh_min = entry->rayleigh_short;
-            if (entry->rayleigh_short > result.rayleigh_max) result.rayleigh_max = entry->rayleigh_short;
+
+        result.rayleigh_min = result.rayleigh_max = lng->rayleigh;
+        if (shrt->rayleigh != 0.0) {
+            if (shrt->rayleigh < result.rayleigh_min) result.rayleigh_min = shrt->rayleigh;
+            if (shrt->rayleigh > result.rayleigh_max) result.rayleigh_max = shrt->rayleigh;
         }
-        
-        strcpy(result.description, "LDPC length unknown");
+
+        result.description = "LDPC length unknown";
     }
-    
+
     return result;
 }
 
+struct snr_pair_result get_snr_pair_for_modcod_l1(const char* mod, const char* cod, int ldpc_length) {
+    return get_snr_pair_l1(mod_from_name_l1(mod, strlen(mod)), cod_from_name_l1(cod, strlen(cod)), ldpc_length);
+}
+
 size_t b64_decoded_size_l1(const char *in) {
     size_t len;
     size_t ret;
@@ -236,493 +439,764 @@ size_t b64_decoded_size_l1(const char *in) {
 }
 
 int b64_isvalidchar_l1(char c) {
-    if (c >= '0' && c <= '9') return 1;
-    if (c >= 'A' && c <= 'Z') return 1;
-    if (c >= 'a' && c <= 'z') return 1;
-    if (c == '+' || c == '/' || c == '=') return 1;
-    return 0;
+    return c == '=' || b64_lut[(unsigned char)c] != B64_INVALID;
 }
 
+/*
+ * b64_decode_l1
+ * Validates and decodes in one pass through b64_lut. '=' is only accepted as
+ * padding at the end of the final group.
+ */
 int b64_decode_l1(const char *in, unsigned char *out, size_t outlen) {
-    size_t len;
-    size_t i;
-    size_t j;
-    int v;
-
     if (in == NULL || out == NULL) return 0;
 
-    len = strlen(in);
-    if (outlen < b64_decoded_size_l1(in) || len % 4 != 0) return 0;
+    size_t len = strlen(in);
+    if (len == 0 || len % 4 != 0 || outlen < b64_decoded_size_l1(in)) return 0;
 
-    for (i = 0; i < len; i++) {
-        if (!b64_isvalidchar_l1(in[i])) {
-            return 0;
-        }
-    }
+    const unsigned char *src = (const unsigned char *)in;
+    const unsigned char *last = src + len - 4;
+    unsigned char *dst = out;
 
-    for (i = 0, j = 0; i < len; i += 4, j += 3) {
-        v = b64invs[in[i] - 43];
-        v = (v << 6) | b64invs[in[i + 1] - 43];
-        v = in[i + 2] == '=' ? v << 6 : (v << 6) | b64invs[in[i + 2] - 43];
-        v = in[i + 3] == '=' ? v << 6 : (v << 6) | b64invs[in[i + 3] - 43];
-
-        out[j] = (v >> 16) & 0xFF;
-        if (in[i + 2] != '=') out[j + 1] = (v >> 8) & 0xFF;
-        if (in[i + 3] != '=') out[j + 2] = v & 0xFF;
+    for (; src < last; src += 4, dst += 3) {
+        uint32_t a = b64_lut[src[0]], b = b64_lut[src[1]];
+        uint32_t c = b64_lut[src[2]], d = b64_lut[src[3]];
+        if ((a | b | c | d) & 0x80) return 0;
+        uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+        dst[0] = (unsigned char)(v >> 16);
+        dst[1] = (unsigned char)(v >> 8);
+        dst[2] = (unsigned char)v;
     }
 
+    // Final group, which may carry one or two '=' of padding
+    int pad = src[3] != '=' ? 0 : (src[2] != '=' ? 1 : 2);
+    uint32_t a = b64_lut[src[0]], b = b64_lut[src[1]];
+    uint32_t c = pad < 2 ? b64_lut[src[2]] : 0;
+    uint32_t d = pad < 1 ? b64_lut[src[3]] : 0;
+    if ((a | b | c | d) & 0x80) return 0;
+    uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+    dst[0] = (unsigned char)(v >> 16);
+    if (pad < 2) dst[1] = (unsigned char)(v >> 8);
+    if (pad < 1) dst[2] = (unsigned char)v;
+
     return 1;
 }
 
-// get_bits function from l1dump.c
-static int get_bits(int count) {
-    int i;
-    long value = 0;
-    
-    if (bits_index + count > sizeof(bits)) {
-        return 0;
-    }
-
-    for (i = count; i > 0; i--) {
-        value |= bits[bits_index++] << (i - 1);
-    }
-    return value;
+static void bit_reader_init(struct l1_bit_reader *br, const unsigned char *data, size_t len) {
+    br->data = data;
+    br->len = len < L1_DUMP_BUFFER_SIZE ? len : L1_DUMP_BUFFER_SIZE;
+    br->pos = 0;
+    br->limit = L1_DUMP_BUFFER_SIZE * 8;
 }
 
 /*
- * calculate_atsc3_bitrate_l1
- * Calculates the bitrate for a given PLP based on L1 signaling parameters.
- * Adapted from atsc3rate() in l1dump.c
+ * get_bits
+ * Reads the next count bits MSB-first, as get_bits(&br, ) in l1dump.c does.
+ * Fields are pulled out of a 64-bit big-endian window rather than a byte
+ * per bit; bits past the end of the data read as zero. Counts wider than
+ * L1_MAX_FIELD_BITS are only used to skip and return 0.
  */
-double calculate_atsc3_bitrate_l1(int fft_size_enum, int guardinterval, int numpayloadsyms, int numpreamblesyms, int rate, int constellation, int framesize, int pilotpattern, int firstsbs, int cred, int pilotboost, int paprmode, int ti_mode, int fec_blocks, int l1_detail_cells, int subframe, int num_subframes, struct subframe_info_t *subframe_info_arr, int frame_length_mode, int frame_length, int excess_samples, long plp_size_cells)
-{
-    int mod;
-    double kbch, fecsize, fecrate, bitrate;
-    double TF = 0.0, T, TS, TB;
-
-    // --- Determine FEC parameters ---
-    if (framesize == FECFRAME_NORMAL) { // 64K LDPC
-        fecsize = 64800.0;
-        switch (rate) {
-            case C2_15: kbch = 8448; break;
-            case C3_15: kbch = 12768; break;
-            case C4_15: kbch = 17088; break;
-            case C5_15: kbch = 21408; break;
-            case C6_15: kbch = 25728; break;
-            case C7_15: kbch = 30048; break;
-            case C8_15: kbch = 34368; break;
-            case C9_15: kbch = 38688; break;
-            case C10_15: kbch = 43008; break;
-            case C11_15: kbch = 47328; break;
-            case C12_15: kbch = 51648; break;
-            case C13_15: kbch = 55968; break;
-            default: kbch = 0; break;
-        }
-    } else { // 16K LDPC
-        fecsize = 16200.0;
-        switch (rate) {
-            case C2_15: kbch = 1992; break;
-            case C3_15: kbch = 3072; break;
-            case C4_15: kbch = 4152; break;
-            case C5_15: kbch = 5232; break;
-            case C6_15: kbch = 6312; break;
-            case C7_15: kbch = 7392; break;
-            case C8_15: kbch = 8472; break;
-            case C9_15: kbch = 9552; break;
-            case C10_15: kbch = 10632; break;
-            case C11_15: kbch = 11712; break;
-            case C12_15: kbch = 12792; break;
-            case C13_15: kbch = 13872; break;
-            default: kbch = 0; break;
+static long get_bits(struct l1_bit_reader *br, int count) {
+    if (count <= 0) return 0;
+    if (br->pos + count > br->limit) return 0;
+
+    size_t byte = br->pos >> 3;
+    int shift = br->pos & 7;
+    br->pos += count;
+    if (count > L1_MAX_FIELD_BITS) return 0;
+
+    uint64_t window = 0;
+    if (byte + 8 <= br->len) {
+        const unsigned char *p = br->data + byte;
+        window = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+                 ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+                 ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+                 ((uint64_t)p[6] << 8)  |  (uint64_t)p[7];
+    } else {
+        for (int n = 0; n < 8; n++) {
+            window <<= 8;
+            if (byte + n < br->len) window |= br->data[byte + n];
         }
     }
-    if (kbch == 0) return 0.0;
+    return (long)((window << shift) >> (64 - count));
+}
 
-    // --- Determine modulation ---
+/*
+ * ldpc_kbch
+ * BCH payload bits per FEC block, as in atsc3rate() in l1dump.c, or 0 for a
+ * reserved code rate.
+ */
+static double ldpc_kbch(int framesize, int rate) {
+    static const double kbch_long[] = {
+        8448, 12768, 17088, 21408, 25728, 30048, 34368, 38688, 43008, 47328, 51648, 55968,
+    };
+    static const double kbch_short[] = {
+        1992, 3072, 4152, 5232, 6312, 7392, 8472, 9552, 10632, 11712, 12792, 13872,
+    };
+    if (rate < C2_15 || rate > C13_15) return 0.0;
+    return framesize == FECFRAME_NORMAL ? kbch_long[rate] : kbch_short[rate];
+}
+
+static int constellation_bits(int constellation) {
     switch (constellation) {
-        case MOD_QPSK: mod = 2; break;
-        case MOD_16QAM: mod = 4; break;
-        case MOD_64QAM: mod = 6; break;
-        case MOD_256QAM: mod = 8; break;
-        case MOD_1024QAM: mod = 10; break;
-        case MOD_4096QAM: mod = 12; break;
-        default: return 0.0;
-    }
-
-    // --- Calculate Frame Time (TF) ---
-    T = 1.0 / (384000.0 * 18.0);
-    TB = 1.0 / 6144000.0;
-
-    if (frame_length_mode == 0) { // Time-aligned
-        TF = frame_length * 5.0;
-    } else { // Symbol-aligned
-        for (int n = 0; n < num_subframes; n++) {
-            int current_fft_size_enum = (n == 0) ? subframe_info_arr[0].fft_size : subframe_info_arr[n].fft_size;
-            int current_gi_enum = (n == 0) ? subframe_info_arr[0].guard_interval : subframe_info_arr[n].guard_interval;
-            int current_fft_val = (current_fft_size_enum == FFTSIZE_8K) ? 8192 : ((current_fft_size_enum == FFTSIZE_16K) ? 16384 : 32768);
-            
-            int guard_interval_val = 0;
-            switch(current_gi_enum) {
-                case GI_1_192: guard_interval_val = 192; break;
-                case GI_2_384: guard_interval_val = 384; break;
-                case GI_3_512: guard_interval_val = 512; break;
-                case GI_4_768: guard_interval_val = 768; break;
-                case GI_5_1024: guard_interval_val = 1024; break;
-                case GI_6_1536: guard_interval_val = 1536; break;
-                case GI_7_2048: guard_interval_val = 2048; break;
-                case GI_8_2432: guard_interval_val = 2432; break;
-                case GI_9_3072: guard_interval_val = 3072; break;
-                case GI_10_3648: guard_interval_val = 3648; break;
-                case GI_11_4096: guard_interval_val = 4096; break;
-                case GI_12_4864: guard_interval_val = 4864; break;
-            }
+        case MOD_QPSK: return 2;
+        case MOD_16QAM: return 4;
+        case MOD_64QAM: return 6;
+        case MOD_256QAM: return 8;
+        case MOD_1024QAM: return 10;
+        case MOD_4096QAM: return 12;
+        default: return 0;
+    }
+}
 
-            int symbols = (n == 0) ? subframe_info_arr[n].num_ofdm_symbols + subframe_info_arr[n].num_preamble_symbols : subframe_info_arr[n].num_ofdm_symbols;
-            TS = (T * (current_fft_val + guard_interval_val)) * 1000.0;
-            TF += (symbols * TS);
-            if (n == 0) {
-                TF += (3072.0 * 4 * TB * 1000.0);
-            }
+double atsc3_symbol_time_ms_l1(int fft_size, int guard_interval) {
+    static const int guard_samples[] = {
+        0, 192, 384, 512, 768, 1024, 1536, 2048, 2432, 3072, 3648, 4096, 4864,
+    };
+    int fft_samples = (fft_size == FFTSIZE_8K) ? 8192 : ((fft_size == FFTSIZE_16K) ? 16384 : 32768);
+    int gi_samples = (guard_interval >= GI_RESERVED && guard_interval <= GI_12_4864) ? guard_samples[guard_interval] : 0;
+    const double T = 1.0 / (384000.0 * 18.0);
+    return T * (fft_samples + gi_samples) * 1000.0;
+}
+
+/*
+ * atsc3_frame_time_ms_l1
+ * Frame time TF: signaled directly for time-aligned frames, otherwise the
+ * bootstrap plus every preamble and payload symbol of every subframe.
+ */
+double atsc3_frame_time_ms_l1(const struct subframe_info_t *subframe_info_arr, int num_subframes,
+                              int frame_length_mode, int frame_length) {
+    if (frame_length_mode == 0) return frame_length * 5.0;
+
+    const double TB = 1.0 / 6144000.0;
+    double TF = 0.0;
+    for (int n = 0; n < num_subframes; n++) {
+        const struct subframe_info_t *sf = &subframe_info_arr[n];
+        int symbols = (n == 0) ? sf->num_ofdm_symbols + sf->num_preamble_symbols : sf->num_ofdm_symbols;
+        TF += symbols * atsc3_symbol_time_ms_l1(sf->fft_size, sf->guard_interval);
+        if (n == 0) {
+            TF += (3072.0 * 4 * TB * 1000.0);
         }
     }
+    return TF;
+}
 
-    if (TF == 0.0) return 0.0;
+double atsc3_plp_bitrate_l1(double frame_time_ms, int rate, int constellation, int framesize, long plp_size_cells) {
+    double kbch = ldpc_kbch(framesize, rate);
+    int mod = constellation_bits(constellation);
+    if (kbch == 0.0 || mod == 0 || frame_time_ms <= 0.0) return 0.0;
 
-    fecrate = kbch / fecsize;
-    bitrate = (1000.0 / TF) * (plp_size_cells * mod * fecrate);
+    double fecsize = (framesize == FECFRAME_NORMAL) ? 64800.0 : 16200.0;
+    return (1000.0 / frame_time_ms) * (plp_size_cells * mod * (kbch / fecsize));
+}
 
-    return bitrate;
-} 
+double atsc3_plp_fec_blocks_l1(int constellation, int framesize, long plp_size_cells) {
+    int mod = constellation_bits(constellation);
+    if (mod == 0) return 0.0;
+    double fecsize = (framesize == FECFRAME_NORMAL) ? 64800.0 : 16200.0;
+    return plp_size_cells * mod / fecsize;
+}
 
+/*
+ * next_plp
+ * Returns a zeroed record for the next PLP, growing the array as needed.
+ */
+static struct l1d_plp* next_plp(struct l1_decoded *d, int *capacity) {
+    if (d->num_plps == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 8;
+        struct l1d_plp *plps = realloc(d->plps, new_capacity * sizeof(struct l1d_plp));
+        if (!plps) return NULL;
+        d->plps = plps;
+        *capacity = new_capacity;
+    }
+    struct l1d_plp *plp = &d->plps[d->num_plps++];
+    memset(plp, 0, sizeof(*plp));
+    return plp;
+}
 
-void parse_l1_data_l1(const unsigned char* data, size_t len, char** display_lines, int* line_count, int max_lines, struct l1_parse_context* context) {
-    long value;
+/*
+ * l1_decode
+ * Decodes an L1-Basic/L1-Detail blob into typed records. Field order and
+ * conditions follow l1dump.c.
+ */
+int l1_decode(const unsigned char *data, size_t len, struct l1_decoded *out) {
     int i, j, k;
-    
-    // L1B Parameters
-    int l1b_version, l1b_time_info_flag, l1b_papr_reduction, l1b_frame_length_mode;
-    int l1b_frame_length = 0, l1b_excess_samples_per_symbol = 0;
-    int l1b_num_subframes, l1b_l1_detail_size_bytes, l1b_l1_detail_total_cells;
-    int l1b_first_sub_mimo, l1b_first_sub_sbs_first, l1b_first_sub_sbs_last;
-    int l1b_first_sub_mimo_mixed = 0;
-
-    // L1D Parameters
-    int l1d_version, l1d_num_rf, l1d_mimo = 0, l1d_sbs_first = 0, l1d_sbs_last = 0;
-    int l1d_num_plp = 0, l1d_plp_layer, l1d_plp_mod = 0, l1d_plp_TI_mode;
-    int l1d_plp_num_channel_bonded, l1d_plp_HTI_inter_subframe, l1d_plp_HTI_num_ti_blocks;
-    int l1d_mimo_mixed;
-
-    // Structs for bitrate calculation
+    int plp_capacity = 0;
+
+    // L1D values that later fields depend on
+    int l1d_mimo = 0, l1d_sbs_first = 0, l1d_sbs_last = 0;
+    int l1d_num_plp = 0, l1d_plp_mod = 0, l1d_mimo_mixed = 0;
+
+    // Scratch for the frame time and PLP bitrate helpers (atsc3_frame_time_ms_l1
+    // and atsc3_plp_bitrate_l1)
     struct subframe_info_t subframe_info[257] = {0};
     struct plp_info_t plp_info[MAX_PLPS] = {0};
-    
-    struct l1_detail_info info_temp = {display_lines, *line_count, max_lines, *context};
-    
-    // Populate the bit buffer
-    bits_index = 0;
-    int bit_count = 0;
-    for (i = 0; i < len && bit_count < sizeof(bits); i++) {
-        for (int n = 7; n >= 0 && bit_count < sizeof(bits); n--) {
-            bits[bit_count++] = (data[i] & (1 << n)) ? 1 : 0;
-        }
-    }
-    
-    add_line(&info_temp, "--- L1-Basic Signaling ---");
 
-    value = get_bits(3); add_line(&info_temp, "L1B_version: %ld", value); l1b_version = value;
-    value = get_bits(1); add_line(&info_temp, "L1B_mimo_scattered_pilot_encoding: %s", value == 0 ? "Walsh-Hadamard" : "Null pilots");
-    value = get_bits(1); add_line(&info_temp, "L1B_lls_flag: %s", value == 0 ? "No LLS" : "LLS present");
-    value = get_bits(2); l1b_time_info_flag = value;
-    switch (value) {
-        case 0: add_line(&info_temp, "L1B_time_info_flag: Not included"); break;
-        case 1: add_line(&info_temp, "L1B_time_info_flag: ms precision"); break;
-        case 2: add_line(&info_temp, "L1B_time_info_flag: us precision"); break;
-        case 3: add_line(&info_temp, "L1B_time_info_flag: ns precision"); break;
-    }
-    value = get_bits(1); add_line(&info_temp, "L1B_return_channel_flag: %ld", value);
-    value = get_bits(2); l1b_papr_reduction = value & 1;
-    switch (value) {
-        case 0: add_line(&info_temp, "L1B_papr_reduction: None"); break;
-        case 1: add_line(&info_temp, "L1B_papr_reduction: Tone reservation only"); break;
-        case 2: add_line(&info_temp, "L1B_papr_reduction: ACE only"); break;
-        case 3: add_line(&info_temp, "L1B_papr_reduction: Both TR and ACE"); break;
-    }
-    value = get_bits(1); l1b_frame_length_mode = value;
-    if (value == 0) {
-        add_line(&info_temp, "L1B_frame_length_mode: Time-aligned");
-        value = get_bits(10); add_line(&info_temp, "  L1B_frame_length: %ld", value); l1b_frame_length = value;
-        value = get_bits(13); add_line(&info_temp, "  L1B_excess_samples_per_symbol: %ld", value); l1b_excess_samples_per_symbol = value;
+    if (!out) return -1;
+    memset(out, 0, sizeof(*out));
+    out->context.ldpc_length = -1;
+    struct l1_decoded *d = out;
+    struct l1b_info *l1b = &d->l1b;
+
+    struct l1_bit_reader br;
+    bit_reader_init(&br, data, len);
+
+    l1b->version = get_bits(&br, 3);
+    l1b->mimo_scattered_pilot_encoding = get_bits(&br, 1);
+    l1b->lls_flag = get_bits(&br, 1);
+    l1b->time_info_flag = get_bits(&br, 2);
+    l1b->return_channel_flag = get_bits(&br, 1);
+    l1b->papr_reduction = get_bits(&br, 2);
+    l1b->frame_length_mode = get_bits(&br, 1);
+    if (l1b->frame_length_mode == 0) {
+        l1b->frame_length = get_bits(&br, 10);
+        l1b->excess_samples_per_symbol = get_bits(&br, 13);
     } else {
-        add_line(&info_temp, "L1B_frame_length_mode: Symbol-aligned");
-        value = get_bits(16); add_line(&info_temp, "  L1B_time_offset: %ld", value);
-        value = get_bits(7); add_line(&info_temp, "  L1B_additional_samples: %ld", value);
-    }
-    value = get_bits(8); add_line(&info_temp, "L1B_num_subframes: %ld", value + 1); l1b_num_subframes = value;
-    value = get_bits(3); add_line(&info_temp, "L1B_preamble_num_symbols: %ld", value + 1); subframe_info[0].num_preamble_symbols = value + 1;
-    value = get_bits(3); add_line(&info_temp, "L1B_preamble_reduced_carriers: %ld", value);
-    value = get_bits(2); add_line(&info_temp, "L1B_L1_Detail_content_tag: %ld", value);
-    value = get_bits(13); add_line(&info_temp, "L1B_L1_Detail_size_bytes: %ld", value); l1b_l1_detail_size_bytes = value;
-    value = get_bits(3); add_line(&info_temp, "L1B_L1_Detail_fec_type: Mode %ld", value + 1);
-    value = get_bits(2); add_line(&info_temp, "L1B_L1_additional_parity_mode: K=%ld", value);
-    value = get_bits(19); add_line(&info_temp, "L1B_L1_Detail_total_cells: %ld", value); l1b_l1_detail_total_cells = value;
-    value = get_bits(1); add_line(&info_temp, "L1B_first_sub_mimo: %s", value == 0 ? "No MIMO" : "MIMO"); l1b_first_sub_mimo = value;
-    value = get_bits(2); add_line(&info_temp, "L1B_first_sub_miso: %ld", value);
-    value = get_bits(2); subframe_info[0].fft_size = value; add_line(&info_temp, "L1B_first_sub_fft_size: %s", (value < 3) ? (value==0?"8K":value==1?"16K":"32K") : "Reserved");
-    value = get_bits(3); subframe_info[0].reduced_carriers = value; add_line(&info_temp, "L1B_first_sub_reduced_carriers: %ld", value);
-    value = get_bits(4); subframe_info[0].guard_interval = value;
-    switch(value) {
-        case GI_1_192: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_1_192"); break;
-        case GI_2_384: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_2_384"); break;
-        case GI_3_512: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_3_512"); break;
-        case GI_4_768: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_4_768"); break;
-        case GI_5_1024: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_5_1024"); break;
-        case GI_6_1536: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_6_1536"); break;
-        case GI_7_2048: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_7_2048"); break;
-        case GI_8_2432: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_8_2432"); break;
-        case GI_9_3072: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_9_3072"); break;
-        case GI_10_3648: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_10_3648"); break;
-        case GI_11_4096: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_11_4096"); break;
-        case GI_12_4864: add_line(&info_temp, "L1B_first_sub_guard_interval: GI_12_4864"); break;
-        default: add_line(&info_temp, "L1B_first_sub_guard_interval: Reserved (%ld)", value); break;
-    }
-    value = get_bits(11); add_line(&info_temp, "L1B_first_sub_num_ofdm_symbols: %ld", value + 1); subframe_info[0].num_ofdm_symbols = value + 1;
-    value = get_bits(5); add_line(&info_temp, "L1B_first_sub_scattered_pilot_pattern: %ld", value); subframe_info[0].scattered_pilot_pattern = value;
-    value = get_bits(3); add_line(&info_temp, "L1B_first_sub_scattered_pilot_boost: %ld", value); subframe_info[0].scattered_pilot_boost = value;
-    value = get_bits(1); add_line(&info_temp, "L1B_first_sub_sbs_first: %ld", value); l1b_first_sub_sbs_first = value; subframe_info[0].sbs_first = value;
-    value = get_bits(1); add_line(&info_temp, "L1B_first_sub_sbs_last: %ld", value); l1b_first_sub_sbs_last = value; subframe_info[0].sbs_last = value;
-    if (l1b_version >= 1) {
-        value = get_bits(1); add_line(&info_temp, "L1B_first_sub_mimo_mixed: %ld", value); l1b_first_sub_mimo_mixed = value;
-        get_bits(47);
+        l1b->time_offset = get_bits(&br, 16);
+        l1b->additional_samples = get_bits(&br, 7);
+    }
+    l1b->num_subframes = get_bits(&br, 8) + 1;
+    subframe_info[0].num_preamble_symbols = get_bits(&br, 3) + 1;
+    l1b->preamble_reduced_carriers = get_bits(&br, 3);
+    l1b->l1_detail_content_tag = get_bits(&br, 2);
+    l1b->l1_detail_size_bytes = get_bits(&br, 13);
+    l1b->l1_detail_fec_type = get_bits(&br, 3);
+    l1b->l1_additional_parity_mode = get_bits(&br, 2);
+    l1b->l1_detail_total_cells = get_bits(&br, 19);
+    l1b->first_sub_mimo = get_bits(&br, 1);
+    l1b->first_sub_miso = get_bits(&br, 2);
+    subframe_info[0].fft_size = get_bits(&br, 2);
+    subframe_info[0].reduced_carriers = get_bits(&br, 3);
+    subframe_info[0].guard_interval = get_bits(&br, 4);
+    subframe_info[0].num_ofdm_symbols = get_bits(&br, 11) + 1;
+    subframe_info[0].scattered_pilot_pattern = get_bits(&br, 5);
+    subframe_info[0].scattered_pilot_boost = get_bits(&br, 3);
+    subframe_info[0].sbs_first = get_bits(&br, 1);
+    subframe_info[0].sbs_last = get_bits(&br, 1);
+    if (l1b->version >= 1) {
+        l1b->first_sub_mimo_mixed = get_bits(&br, 1);
+        get_bits(&br, 47);
     } else {
-        get_bits(48);
+        get_bits(&br, 48);
     }
-    value = get_bits(32); add_line(&info_temp, "L1B_crc: 0x%08lx", value);
-    
-    add_line(&info_temp, " ");
-    add_line(&info_temp, "--- L1-Detail Signaling ---");
-    
-    value = get_bits(4); add_line(&info_temp, "L1D_version: %ld", value); l1d_version = value;
-    value = get_bits(3); add_line(&info_temp, "L1D_num_rf: %ld", value); l1d_num_rf = value;
-    for (i = 1; i <= l1d_num_rf; i++) {
-        value = get_bits(16); add_line(&info_temp, "  L1D_bonded_bsid: 0x%04lx", value);
-        get_bits(3);
-    }
-    if (l1b_time_info_flag != 0) {
-        value = get_bits(32); add_line(&info_temp, "L1D_time_sec: %ld", value);
-        value = get_bits(10); add_line(&info_temp, "L1D_time_msec: %ld", value);
-        if (l1b_time_info_flag > 1) {
-            value = get_bits(10); add_line(&info_temp, "L1D_time_usec: %ld", value);
-            if (l1b_time_info_flag > 2) {
-                value = get_bits(10); add_line(&info_temp, "L1D_time_nsec: %ld", value);
+    l1b->crc = get_bits(&br, 32);
+
+    d->num_subframes = l1b->num_subframes;
+    d->subframes = calloc(d->num_subframes, sizeof(struct l1d_subframe));
+    if (!d->subframes) return -1;
+
+    d->l1d_version = get_bits(&br, 4);
+    d->num_rf = get_bits(&br, 3);
+    for (i = 1; i <= d->num_rf; i++) {
+        d->bonded_bsid[i - 1] = get_bits(&br, 16);
+        get_bits(&br, 3);
+    }
+    if (l1b->time_info_flag != 0) {
+        d->time_sec = get_bits(&br, 32);
+        d->time_msec = get_bits(&br, 10);
+        if (l1b->time_info_flag > 1) {
+            d->time_usec = get_bits(&br, 10);
+            if (l1b->time_info_flag > 2) {
+                d->time_nsec = get_bits(&br, 10);
             }
         }
     }
-    
-    // Continue with subframes parsing
-    for (i = 0; i <= l1b_num_subframes; i++) {
-        add_line(&info_temp, " "); 
-        add_line(&info_temp, "Subframe #%d:", i);
+
+    for (i = 0; i < d->num_subframes; i++) {
+        struct l1d_subframe *sf = &d->subframes[i];
         if (i > 0) {
-            value = get_bits(1); add_line(&info_temp, "  L1D_mimo: %s", value == 0 ? "No MIMO" : "MIMO"); l1d_mimo = value;
-            value = get_bits(2); add_line(&info_temp, "  L1D_miso: %ld", value);
-            value = get_bits(2); subframe_info[i].fft_size = value; add_line(&info_temp, "  L1D_fft_size: %s", (value < 3) ? (value==0?"8K":value==1?"16K":"32K") : "Reserved");
-            value = get_bits(3); subframe_info[i].reduced_carriers = value; add_line(&info_temp, "  L1D_reduced_carriers: %ld", value);
-            value = get_bits(4); subframe_info[i].guard_interval = value;
-            switch(value) {
-                case GI_1_192: add_line(&info_temp, "  L1D_guard_interval: GI_1_192"); break;
-                case GI_2_384: add_line(&info_temp, "  L1D_guard_interval: GI_2_384"); break;
-                case GI_3_512: add_line(&info_temp, "  L1D_guard_interval: GI_3_512"); break;
-                case GI_4_768: add_line(&info_temp, "  L1D_guard_interval: GI_4_768"); break;
-                case GI_5_1024: add_line(&info_temp, "  L1D_guard_interval: GI_5_1024"); break;
-                case GI_6_1536: add_line(&info_temp, "  L1D_guard_interval: GI_6_1536"); break;
-                case GI_7_2048: add_line(&info_temp, "  L1D_guard_interval: GI_7_2048"); break;
-                case GI_8_2432: add_line(&info_temp, "  L1D_guard_interval: GI_8_2432"); break;
-                case GI_9_3072: add_line(&info_temp, "  L1D_guard_interval: GI_9_3072"); break;
-                case GI_10_3648: add_line(&info_temp, "  L1D_guard_interval: GI_10_3648"); break;
-                case GI_11_4096: add_line(&info_temp, "  L1D_guard_interval: GI_11_4096"); break;
-                case GI_12_4864: add_line(&info_temp, "  L1D_guard_interval: GI_12_4864"); break;
-                default: add_line(&info_temp, "  L1D_guard_interval: Reserved (%ld)", value); break;
-            }
-            value = get_bits(11); add_line(&info_temp, "  L1D_num_ofdm_symbols: %ld", value + 1); subframe_info[i].num_ofdm_symbols = value + 1;
-            value = get_bits(5); add_line(&info_temp, "  L1D_scattered_pilot_pattern: %ld", value); subframe_info[i].scattered_pilot_pattern = value;
-            value = get_bits(3); add_line(&info_temp, "  L1D_scattered_pilot_boost: %ld", value); subframe_info[i].scattered_pilot_boost = value;
-            value = get_bits(1); add_line(&info_temp, "  L1D_sbs_first: %ld", value); l1d_sbs_first = value; subframe_info[i].sbs_first = value;
-            value = get_bits(1); add_line(&info_temp, "  L1D_sbs_last: %ld", value); l1d_sbs_last = value; subframe_info[i].sbs_last = value;
+            sf->mimo = get_bits(&br, 1); l1d_mimo = sf->mimo;
+            sf->miso = get_bits(&br, 2);
+            subframe_info[i].fft_size = get_bits(&br, 2);
+            subframe_info[i].reduced_carriers = get_bits(&br, 3);
+            subframe_info[i].guard_interval = get_bits(&br, 4);
+            subframe_info[i].num_ofdm_symbols = get_bits(&br, 11) + 1;
+            subframe_info[i].scattered_pilot_pattern = get_bits(&br, 5);
+            subframe_info[i].scattered_pilot_boost = get_bits(&br, 3);
+            subframe_info[i].sbs_first = l1d_sbs_first = get_bits(&br, 1);
+            subframe_info[i].sbs_last = l1d_sbs_last = get_bits(&br, 1);
         }
-        if (l1b_num_subframes > 0) {
-            value = get_bits(1); add_line(&info_temp, "  L1D_subframe_multiplex: %ld", value);
+        if (d->num_subframes > 1) {
+            sf->subframe_multiplex = get_bits(&br, 1);
         }
-        value = get_bits(1); add_line(&info_temp, "  L1D_frequency_interleaver: %s", value == 0 ? "Preamble Only" : "All Symbols");
-        if ((i == 0 && (l1b_first_sub_sbs_first == 1 || l1b_first_sub_sbs_last == 1)) || (i > 0 && (l1d_sbs_first == 1 || l1d_sbs_last == 1))) {
-            value = get_bits(13); add_line(&info_temp, "  L1D_sbs_null_cells: %ld", value);
+        sf->frequency_interleaver = get_bits(&br, 1);
+        if ((i == 0 && (subframe_info[0].sbs_first == 1 || subframe_info[0].sbs_last == 1)) || (i > 0 && (l1d_sbs_first == 1 || l1d_sbs_last == 1))) {
+            sf->has_sbs_null_cells = true;
+            sf->sbs_null_cells = get_bits(&br, 13);
         }
-        value = get_bits(6); add_line(&info_temp, "  L1D_num_plp: %ld", value + 1); l1d_num_plp = value;
-        
-        // Parse PLPs for this subframe
+        l1d_num_plp = get_bits(&br, 6);
+        sf->first_plp = d->num_plps;
+        sf->num_plp = l1d_num_plp + 1;
+
         for (j = 0; j <= l1d_num_plp; j++) {
-            add_line(&info_temp, "    PLP #%d:", j);
-            value = get_bits(6); add_line(&info_temp, "      L1D_plp_id: %ld", value); plp_info[j].plp_id = value;
-            value = get_bits(1); add_line(&info_temp, "      L1D_plp_lls_flag: %ld", value);
-            value = get_bits(2); add_line(&info_temp, "      L1D_plp_layer: %s", (value==0) ? "Core" : (value==1 ? "Enhanced" : "Reserved")); l1d_plp_layer = value;
-            value = get_bits(24); add_line(&info_temp, "      L1D_plp_start: %ld", value);
-            value = get_bits(24); add_line(&info_temp, "      L1D_plp_size: %ld", value); plp_info[j].size = value;
-            value = get_bits(2); add_line(&info_temp, "      L1D_plp_scrambler_type: %s", (value==0) ? "PRBS" : "Reserved");
-            value = get_bits(4); plp_info[j].fec_type = !(value & 1);
-            switch (value) {
-                case 0: add_line(&info_temp, "      L1D_plp_fec_type: BCH + 16K LDPC"); break;
-                case 1: add_line(&info_temp, "      L1D_plp_fec_type: BCH + 64K LDPC"); break;
-                case 2: add_line(&info_temp, "      L1D_plp_fec_type: CRC + 16K LDPC"); break;
-                case 3: add_line(&info_temp, "      L1D_plp_fec_type: CRC + 64K LDPC"); break;
-                case 4: add_line(&info_temp, "      L1D_plp_fec_type: 16K LDPC only"); break;
-                case 5: add_line(&info_temp, "      L1D_plp_fec_type: 64K LDPC only"); break;
-                default: add_line(&info_temp, "      L1D_plp_fec_type: Reserved"); break;
+            struct l1d_plp *plp = next_plp(d, &plp_capacity);
+            if (!plp) return -1;
+            plp->subframe = i;
+
+            plp_info[j].plp_id = get_bits(&br, 6);
+            plp->lls_flag = get_bits(&br, 1);
+            plp->layer = get_bits(&br, 2);
+            plp->start = get_bits(&br, 24);
+            plp_info[j].size = get_bits(&br, 24);
+            plp->scrambler_type = get_bits(&br, 2);
+            plp->fec_type = get_bits(&br, 4);
+            plp_info[j].fec_type = !(plp->fec_type & 1);
+            if (!d->context.ldpc_info_available) {
+                d->context.ldpc_info_available = true;
+                if (plp->fec_type == 0 || plp->fec_type == 2 || plp->fec_type == 4) {
+                    d->context.ldpc_length = 0;  // 16K LDPC (short)
+                } else if (plp->fec_type == 1 || plp->fec_type == 3 || plp->fec_type == 5) {
+                    d->context.ldpc_length = 1;  // 64K LDPC (long)
+                }
+            }
+            if (plp->fec_type <= 5) {
+                plp->has_modcod = true;
+                plp_info[j].mod = l1d_plp_mod = get_bits(&br, 4);
+                plp_info[j].cod = get_bits(&br, 4);
             }
-            if (context && !context->ldpc_info_available) {
-                context->ldpc_info_available = true;
-                if (value == 0 || value == 2 || value == 4) {
-                    context->ldpc_length = 0;  // 16K LDPC (short)
-                } else if (value == 1 || value == 3 || value == 5) {
-                    context->ldpc_length = 1;  // 64K LDPC (long)
+            plp_info[j].ti_mode = get_bits(&br, 2);
+            if (plp_info[j].ti_mode == 0) {
+                plp->fec_block_start = get_bits(&br, 15);
+            } else if (plp_info[j].ti_mode == 1) {
+                plp->fec_block_start = get_bits(&br, 22);
+            }
+            if (d->num_rf > 0) {
+                plp->num_channel_bonded = get_bits(&br, 3);
+                if (plp->num_channel_bonded > 0) {
+                    plp->channel_bonding_format = get_bits(&br, 2);
+                    for (k = 0; k < plp->num_channel_bonded; k++) {
+                        plp->bonded_rf_id[k] = get_bits(&br, 3);
+                    }
                 }
             }
-            if (value <= 5) {
-                value = get_bits(4); l1d_plp_mod = value; plp_info[j].mod = value;
-                switch (value) {
-                    case MOD_QPSK: add_line(&info_temp, "      L1D_plp_mod: QPSK"); break;
-                    case MOD_16QAM: add_line(&info_temp, "      L1D_plp_mod: 16QAM"); break;
-                    case MOD_64QAM: add_line(&info_temp, "      L1D_plp_mod: 64QAM"); break;
-                    case MOD_256QAM: add_line(&info_temp, "      L1D_plp_mod: 256QAM"); break;
-                    case MOD_1024QAM: add_line(&info_temp, "      L1D_plp_mod: 1024QAM"); break;
-                    case MOD_4096QAM: add_line(&info_temp, "      L1D_plp_mod: 4096QAM"); break;
-                    default: add_line(&info_temp, "      L1D_plp_mod: Reserved"); break;
+            if ((i == 0 && l1b->first_sub_mimo == 1) || (i > 0 && l1d_mimo)) {
+                plp->has_mimo = true;
+                plp->mimo_stream_combining = get_bits(&br, 1);
+                plp->mimo_iq_interleaving = get_bits(&br, 1);
+                plp->mimo_ph = get_bits(&br, 1);
+            }
+            if (plp->layer == 0) {
+                plp->dispersed = get_bits(&br, 1);
+                if (plp->dispersed) {
+                    plp->num_subslices = get_bits(&br, 14) + 1;
+                    plp->subslice_interval = get_bits(&br, 24);
+                }
+                if ((plp_info[j].ti_mode == 1 || plp_info[j].ti_mode == 2) && l1d_plp_mod == 0) {
+                    plp->has_ti_extended_interleaving = true;
+                    plp->ti_extended_interleaving = get_bits(&br, 1);
+                }
+                if (plp_info[j].ti_mode == 1) {
+                    plp->cti_depth = get_bits(&br, 3);
+                    plp->cti_start_row = get_bits(&br, 11);
+                } else if (plp_info[j].ti_mode == 2) {
+                    plp->hti_inter_subframe = get_bits(&br, 1);
+                    plp->hti_num_ti_blocks = get_bits(&br, 4) + 1;
+                    plp->hti_num_fec_blocks_max = get_bits(&br, 12) + 1;
+                    if (plp->hti_inter_subframe == 0) {
+                        plp_info[j].HTI_num_fec_blocks = get_bits(&br, 12) + 1;
+                        plp->hti_num_fec_blocks[0] = plp_info[j].HTI_num_fec_blocks;
+                    } else {
+                        for (k = 0; k < plp->hti_num_ti_blocks; k++) {
+                            plp->hti_num_fec_blocks[k] = get_bits(&br, 12) + 1;
+                        }
+                    }
+                    plp->hti_cell_interleaver = get_bits(&br, 1);
                 }
-                value = get_bits(4); plp_info[j].cod = value;
-                switch (value) {
-                    case C2_15: add_line(&info_temp, "      L1D_plp_cod: 2/15"); break;
-                    case C3_15: add_line(&info_temp, "      L1D_plp_cod: 3/15"); break;
-                    case C4_15: add_line(&info_temp, "      L1D_plp_cod: 4/15"); break;
-                    case C5_15: add_line(&info_temp, "      L1D_plp_cod: 5/15"); break;
-                    case C6_15: add_line(&info_temp, "      L1D_plp_cod: 6/15"); break;
-                    case C7_15: add_line(&info_temp, "      L1D_plp_cod: 7/15"); break;
-                    case C8_15: add_line(&info_temp, "      L1D_plp_cod: 8/15"); break;
-                    case C9_15: add_line(&info_temp, "      L1D_plp_cod: 9/15"); break;
-                    case C10_15: add_line(&info_temp, "      L1D_plp_cod: 10/15"); break;
-                    case C11_15: add_line(&info_temp, "      L1D_plp_cod: 11/15"); break;
-                    case C12_15: add_line(&info_temp, "      L1D_plp_cod: 12/15"); break;
-                    case C13_15: add_line(&info_temp, "      L1D_plp_cod: 13/15"); break;
-                    default: add_line(&info_temp, "      L1D_plp_cod: Reserved"); break;
+            } else {
+                plp->ldm_injection_level = get_bits(&br, 5);
+            }
+
+            plp->params = plp_info[j];
+        }
+        sf->params = subframe_info[i];
+    }
+
+    // TF needs every subframe, so rates are worked out once the whole frame is known
+    d->frame_time_ms = atsc3_frame_time_ms_l1(subframe_info, d->num_subframes,
+                                              l1b->frame_length_mode, l1b->frame_length);
+    for (i = 0; i < d->num_subframes; i++) {
+        d->subframes[i].symbol_time_ms = atsc3_symbol_time_ms_l1(subframe_info[i].fft_size, subframe_info[i].guard_interval);
+    }
+    for (j = 0; j < d->num_plps; j++) {
+        struct l1d_plp *plp = &d->plps[j];
+        int ldpc_length = plp_ldpc_length_l1(plp);
+        if (ldpc_length < 0) continue;
+        int framesize = ldpc_length == 1 ? FECFRAME_NORMAL : FECFRAME_SHORT;
+        plp->bitrate = atsc3_plp_bitrate_l1(d->frame_time_ms, plp->params.cod, plp->params.mod, framesize, plp->params.size);
+        plp->fec_blocks = atsc3_plp_fec_blocks_l1(plp->params.mod, framesize, plp->params.size);
+    }
+
+    if (d->l1d_version >= 1) {
+        d->bsid = get_bits(&br, 16);
+    }
+    if (d->l1d_version >= 2) {
+        for (i = 0; i < d->num_subframes; i++) {
+            struct l1d_subframe *sf = &d->subframes[i];
+            if (i > 0) {
+                sf->mimo_mixed = l1d_mimo_mixed = get_bits(&br, 1);
+            }
+            if ((i == 0 && l1b->first_sub_mimo_mixed == 1) || (i > 0 && l1d_mimo_mixed == 1)) {
+                // l1dump.c walks the PLP count of the last subframe here
+                sf->num_plp_mimo = l1d_num_plp + 1;
+                for (j = 0; j <= l1d_num_plp; j++) {
+                    struct l1d_plp_mimo *m = &sf->plp_mimo[j];
+                    m->plp_mimo = get_bits(&br, 1);
+                    if (m->plp_mimo == 1) {
+                        m->stream_combining = get_bits(&br, 1);
+                        m->iq_interleaving = get_bits(&br, 1);
+                        m->ph = get_bits(&br, 1);
+                    }
                 }
             }
-            value = get_bits(2); l1d_plp_TI_mode = value; plp_info[j].ti_mode = value;
-            switch (value) {
-                case 0: add_line(&info_temp, "      L1D_plp_TI_mode: No TI"); break;
-                case 1: add_line(&info_temp, "      L1D_plp_TI_mode: CTI"); break;
-                case 2: add_line(&info_temp, "      L1D_plp_TI_mode: HTI"); break;
-                default: add_line(&info_temp, "      L1D_plp_TI_mode: Reserved"); break;
+        }
+    }
+
+    // Skip any remaining bits before CRC
+    if ((((l1b->l1_detail_size_bytes * 8) - 32) - ((long)br.pos - 200)) > 0) {
+        get_bits(&br, ((l1b->l1_detail_size_bytes * 8) - 32) - ((long)br.pos - 200));
+    }
+    d->crc = get_bits(&br, 32);
+    return 0;
+}
+
+void l1_decoded_free(struct l1_decoded *decoded) {
+    if (!decoded) return;
+    free(decoded->subframes);
+    free(decoded->plps);
+    decoded->subframes = NULL;
+    decoded->plps = NULL;
+    decoded->num_subframes = decoded->num_plps = 0;
+}
+
+const char* mod_name_l1(int mod) {
+    static const char *names[] = { "QPSK", "16QAM", "64QAM", "256QAM", "1024QAM", "4096QAM" };
+    return (mod >= MOD_QPSK && mod <= MOD_4096QAM) ? names[mod] : "Reserved";
+}
+
+const char* cod_name_l1(int cod) {
+    static const char *names[] = {
+        "2/15", "3/15", "4/15", "5/15", "6/15", "7/15", "8/15", "9/15", "10/15", "11/15", "12/15", "13/15",
+    };
+    return (cod >= C2_15 && cod <= C13_15) ? names[cod] : "Reserved";
+}
+
+int plp_ldpc_length_l1(const struct l1d_plp *plp) {
+    if (!plp || plp->fec_type > 5) return -1;
+    return (plp->fec_type & 1) ? 1 : 0;
+}
+
+static const char* fft_size_name(int fft_size) {
+    switch (fft_size) {
+        case FFTSIZE_8K: return "8K";
+        case FFTSIZE_16K: return "16K";
+        case FFTSIZE_32K: return "32K";
+        default: return "Reserved";
+    }
+}
+
+/*
+ * add_guard_interval_line
+ * GI_1_192 .. GI_12_4864 are printed by name, anything else as Reserved.
+ */
+static void add_guard_interval_line(struct l1_detail_info *info, const char *label, int gi) {
+    static const char *names[] = {
+        NULL, "GI_1_192", "GI_2_384", "GI_3_512", "GI_4_768", "GI_5_1024", "GI_6_1536",
+        "GI_7_2048", "GI_8_2432", "GI_9_3072", "GI_10_3648", "GI_11_4096", "GI_12_4864",
+    };
+    if (gi >= GI_1_192 && gi <= GI_12_4864) {
+        add_line(info, "%s: %s", label, names[gi]);
+    } else {
+        add_line(info, "%s: Reserved (%d)", label, gi);
+    }
+}
+
+/*
+ * render_capacity_table
+ * One row per PLP with its share of the frame, so the multiplex capacity can
+ * be read without going through every L1D_plp field.
+ */
+static void render_capacity_table(const struct l1_decoded *d, struct l1_detail_info *info) {
+    if (d->num_plps == 0) return;
+
+    add_line(info, " ");
+    if (d->frame_time_ms > 0) {
+        add_line(info, "PLP Capacity (frame time %.3f ms):", d->frame_time_ms);
+    } else {
+        add_line(info, "PLP Capacity:");
+    }
+    add_line(info, "  SF PLP  ID Layer     Mod   Cod LDPC      Cells FEC blocks     Mbps");
+
+    double total = 0.0;
+    for (int p = 0; p < d->num_plps; p++) {
+        const struct l1d_plp *plp = &d->plps[p];
+        int ldpc = plp_ldpc_length_l1(plp);
+        add_line(info, "  %2d %3d %3d %-5s %7s %5s %4s %10ld %10.2f %8.3f",
+                 plp->subframe, p - d->subframes[plp->subframe].first_plp, plp->params.plp_id,
+                 plp->layer == 0 ? "core" : "enh",
+                 plp->has_modcod ? mod_name_l1(plp->params.mod) : "-",
+                 plp->has_modcod ? cod_name_l1(plp->params.cod) : "-",
+                 ldpc == 0 ? "16K" : ldpc == 1 ? "64K" : "-",
+                 plp->params.size, plp->fec_blocks, plp->bitrate / 1000000.0);
+        total += plp->bitrate;
+    }
+    add_line(info, "  Total %61.3f", total / 1000000.0);
+}
+
+void l1_render_lines(const struct l1_decoded *d, struct l1_detail_info *info) {
+    static const char *time_info_names[] = { "Not included", "ms precision", "us precision", "ns precision" };
+    static const char *papr_names[] = { "None", "Tone reservation only", "ACE only", "Both TR and ACE" };
+    static const char *fec_type_names[] = {
+        "BCH + 16K LDPC", "BCH + 64K LDPC", "CRC + 16K LDPC", "CRC + 64K LDPC", "16K LDPC only", "64K LDPC only",
+    };
+    static const char *ti_mode_names[] = { "No TI", "CTI", "HTI", "Reserved" };
+
+    if (!d || !info || !d->subframes) return;
+    const struct l1b_info *l1b = &d->l1b;
+    const struct subframe_info_t *first = &d->subframes[0].params;
+
+    add_line(info, "--- L1-Basic Signaling ---");
+    add_line(info, "L1B_version: %d", l1b->version);
+    add_line(info, "L1B_mimo_scattered_pilot_encoding: %s", l1b->mimo_scattered_pilot_encoding == 0 ? "Walsh-Hadamard" : "Null pilots");
+    add_line(info, "L1B_lls_flag: %s", l1b->lls_flag == 0 ? "No LLS" : "LLS present");
+    add_line(info, "L1B_time_info_flag: %s", time_info_names[l1b->time_info_flag & 3]);
+    add_line(info, "L1B_return_channel_flag: %d", l1b->return_channel_flag);
+    add_line(info, "L1B_papr_reduction: %s", papr_names[l1b->papr_reduction & 3]);
+    if (l1b->frame_length_mode == 0) {
+        add_line(info, "L1B_frame_length_mode: Time-aligned");
+        add_line(info, "  L1B_frame_length: %d", l1b->frame_length);
+        add_line(info, "  L1B_excess_samples_per_symbol: %d", l1b->excess_samples_per_symbol);
+    } else {
+        add_line(info, "L1B_frame_length_mode: Symbol-aligned");
+        add_line(info, "  L1B_time_offset: %d", l1b->time_offset);
+        add_line(info, "  L1B_additional_samples: %d", l1b->additional_samples);
+    }
+    add_line(info, "L1B_num_subframes: %d", l1b->num_subframes);
+    add_line(info, "L1B_preamble_num_symbols: %d", first->num_preamble_symbols);
+    add_line(info, "L1B_preamble_reduced_carriers: %d", l1b->preamble_reduced_carriers);
+    add_line(info, "L1B_L1_Detail_content_tag: %d", l1b->l1_detail_content_tag);
+    add_line(info, "L1B_L1_Detail_size_bytes: %d", l1b->l1_detail_size_bytes);
+    add_line(info, "L1B_L1_Detail_fec_type: Mode %d", l1b->l1_detail_fec_type + 1);
+    add_line(info, "L1B_L1_additional_parity_mode: K=%d", l1b->l1_additional_parity_mode);
+    add_line(info, "L1B_L1_Detail_total_cells: %d", l1b->l1_detail_total_cells);
+    add_line(info, "L1B_first_sub_mimo: %s", l1b->first_sub_mimo == 0 ? "No MIMO" : "MIMO");
+    add_line(info, "L1B_first_sub_miso: %d", l1b->first_sub_miso);
+    add_line(info, "L1B_first_sub_fft_size: %s", fft_size_name(first->fft_size));
+    add_line(info, "L1B_first_sub_reduced_carriers: %d", first->reduced_carriers);
+    add_guard_interval_line(info, "L1B_first_sub_guard_interval", first->guard_interval);
+    add_line(info, "L1B_first_sub_num_ofdm_symbols: %d", first->num_ofdm_symbols);
+    add_line(info, "L1B_first_sub_scattered_pilot_pattern: %d", first->scattered_pilot_pattern);
+    add_line(info, "L1B_first_sub_scattered_pilot_boost: %d", first->scattered_pilot_boost);
+    add_line(info, "L1B_first_sub_sbs_first: %d", first->sbs_first);
+    add_line(info, "L1B_first_sub_sbs_last: %d", first->sbs_last);
+    if (l1b->version >= 1) {
+        add_line(info, "L1B_first_sub_mimo_mixed: %d", l1b->first_sub_mimo_mixed);
+    }
+    add_line(info, "L1B_crc: 0x%08lx", l1b->crc);
+
+    add_line(info, " ");
+    add_line(info, "--- L1-Detail Signaling ---");
+    add_line(info, "L1D_version: %d", d->l1d_version);
+    add_line(info, "L1D_num_rf: %d", d->num_rf);
+    for (int i = 0; i < d->num_rf; i++) {
+        add_line(info, "  L1D_bonded_bsid: 0x%04x", d->bonded_bsid[i]);
+    }
+    if (l1b->time_info_flag != 0) {
+        add_line(info, "L1D_time_sec: %ld", d->time_sec);
+        add_line(info, "L1D_time_msec: %d", d->time_msec);
+        if (l1b->time_info_flag > 1) {
+            add_line(info, "L1D_time_usec: %d", d->time_usec);
+            if (l1b->time_info_flag > 2) {
+                add_line(info, "L1D_time_nsec: %d", d->time_nsec);
+            }
+        }
+    }
+
+    for (int i = 0; i < d->num_subframes; i++) {
+        const struct l1d_subframe *sf = &d->subframes[i];
+        add_line(info, " ");
+        add_line(info, "Subframe #%d:", i);
+        if (i > 0) {
+            add_line(info, "  L1D_mimo: %s", sf->mimo == 0 ? "No MIMO" : "MIMO");
+            add_line(info, "  L1D_miso: %d", sf->miso);
+            add_line(info, "  L1D_fft_size: %s", fft_size_name(sf->params.fft_size));
+            add_line(info, "  L1D_reduced_carriers: %d", sf->params.reduced_carriers);
+            add_guard_interval_line(info, "  L1D_guard_interval", sf->params.guard_interval);
+            add_line(info, "  L1D_num_ofdm_symbols: %d", sf->params.num_ofdm_symbols);
+            add_line(info, "  L1D_scattered_pilot_pattern: %d", sf->params.scattered_pilot_pattern);
+            add_line(info, "  L1D_scattered_pilot_boost: %d", sf->params.scattered_pilot_boost);
+            add_line(info, "  L1D_sbs_first: %d", sf->params.sbs_first);
+            add_line(info, "  L1D_sbs_last: %d", sf->params.sbs_last);
+        }
+        if (d->num_subframes > 1) {
+            add_line(info, "  L1D_subframe_multiplex: %d", sf->subframe_multiplex);
+        }
+        add_line(info, "  L1D_frequency_interleaver: %s", sf->frequency_interleaver == 0 ? "Preamble Only" : "All Symbols");
+        if (sf->has_sbs_null_cells) {
+            add_line(info, "  L1D_sbs_null_cells: %d", sf->sbs_null_cells);
+        }
+        add_line(info, "  L1D_num_plp: %d", sf->num_plp);
+
+        for (int j = 0; j < sf->num_plp; j++) {
+            const struct l1d_plp *plp = &d->plps[sf->first_plp + j];
+            add_line(info, "    PLP #%d:", j);
+            add_line(info, "      L1D_plp_id: %d", plp->params.plp_id);
+            add_line(info, "      L1D_plp_lls_flag: %d", plp->lls_flag);
+            add_line(info, "      L1D_plp_layer: %s", (plp->layer==0) ? "Core" : (plp->layer==1 ? "Enhanced" : "Reserved"));
+            add_line(info, "      L1D_plp_start: %ld", plp->start);
+            add_line(info, "      L1D_plp_size: %ld", plp->params.size);
+            add_line(info, "      L1D_plp_scrambler_type: %s", (plp->scrambler_type==0) ? "PRBS" : "Reserved");
+            add_line(info, "      L1D_plp_fec_type: %s", plp->fec_type <= 5 ? fec_type_names[plp->fec_type] : "Reserved");
+            if (plp->has_modcod) {
+                add_line(info, "      L1D_plp_mod: %s", mod_name_l1(plp->params.mod));
+                add_line(info, "      L1D_plp_cod: %s", cod_name_l1(plp->params.cod));
             }
-            if (l1d_plp_TI_mode == 0) { 
-                value = get_bits(15); add_line(&info_temp, "      L1D_plp_fec_block_start: %ld", value); 
-            } else if (l1d_plp_TI_mode == 1) { 
-                value = get_bits(22); add_line(&info_temp, "      L1D_plp_CTI_fec_block_start: %ld", value); 
+            add_line(info, "      L1D_plp_TI_mode: %s", ti_mode_names[plp->params.ti_mode & 3]);
+            if (plp->params.ti_mode == 0) {
+                add_line(info, "      L1D_plp_fec_block_start: %d", plp->fec_block_start);
+            } else if (plp->params.ti_mode == 1) {
+                add_line(info, "      L1D_plp_CTI_fec_block_start: %d", plp->fec_block_start);
             }
-            if (l1d_num_rf > 0) {
-                value = get_bits(3); add_line(&info_temp, "      L1D_plp_num_channel_bonded: %ld", value); l1d_plp_num_channel_bonded = value;
-                if (l1d_plp_num_channel_bonded > 0) {
-                    value = get_bits(2); add_line(&info_temp, "      L1D_plp_channel_bonding_format: %ld", value);
-                    for (k = 0; k < l1d_plp_num_channel_bonded; k++) {
-                        value = get_bits(3); add_line(&info_temp, "        L1D_plp_bonded_rf_id: %ld", value);
+            if (d->num_rf > 0) {
+                add_line(info, "      L1D_plp_num_channel_bonded: %d", plp->num_channel_bonded);
+                if (plp->num_channel_bonded > 0) {
+                    add_line(info, "      L1D_plp_channel_bonding_format: %d", plp->channel_bonding_format);
+                    for (int k = 0; k < plp->num_channel_bonded; k++) {
+                        add_line(info, "        L1D_plp_bonded_rf_id: %d", plp->bonded_rf_id[k]);
                     }
                 }
             }
-            if ((i == 0 && l1b_first_sub_mimo == 1) || (i > 0 && l1d_mimo)) {
-                value = get_bits(1); add_line(&info_temp, "      L1D_plp_mimo_stream_combining: %ld", value);
-                value = get_bits(1); add_line(&info_temp, "      L1D_plp_mimo_IQ_interleaving: %ld", value);
-                value = get_bits(1); add_line(&info_temp, "      L1D_plp_mimo_PH: %ld", value);
+            if (plp->has_mimo) {
+                add_line(info, "      L1D_plp_mimo_stream_combining: %d", plp->mimo_stream_combining);
+                add_line(info, "      L1D_plp_mimo_IQ_interleaving: %d", plp->mimo_iq_interleaving);
+                add_line(info, "      L1D_plp_mimo_PH: %d", plp->mimo_ph);
             }
-            if (l1d_plp_layer == 0) {
-                value = get_bits(1);
-                if (value == 0) { 
-                    add_line(&info_temp, "      L1D_plp_type: non-dispersed"); 
+            if (plp->layer == 0) {
+                if (!plp->dispersed) {
+                    add_line(info, "      L1D_plp_type: non-dispersed");
                 } else {
-                    add_line(&info_temp, "      L1D_plp_type: dispersed");
-                    value = get_bits(14); add_line(&info_temp, "      L1D_plp_num_subslices: %ld", value + 1);
-                    value = get_bits(24); add_line(&info_temp, "      L1D_plp_subslice_interval: %ld", value);
+                    add_line(info, "      L1D_plp_type: dispersed");
+                    add_line(info, "      L1D_plp_num_subslices: %d", plp->num_subslices);
+                    add_line(info, "      L1D_plp_subslice_interval: %ld", plp->subslice_interval);
                 }
-                if ((l1d_plp_TI_mode == 1 || l1d_plp_TI_mode == 2) && l1d_plp_mod == 0) {
-                    value = get_bits(1);
-                    add_line(&info_temp, "      L1D_plp_TI_extended_interleaving: %ld", value);
+                if (plp->has_ti_extended_interleaving) {
+                    add_line(info, "      L1D_plp_TI_extended_interleaving: %d", plp->ti_extended_interleaving);
                 }
-                if (l1d_plp_TI_mode == 1) {
-                    value = get_bits(3); add_line(&info_temp, "      L1D_plp_CTI_depth: %ld", value);
-                    value = get_bits(11); add_line(&info_temp, "      L1D_plp_CTI_start_row: %ld", value);
-                } else if (l1d_plp_TI_mode == 2) {
-                    value = get_bits(1); add_line(&info_temp, "      L1D_plp_HTI_inter_subframe: %ld", value); l1d_plp_HTI_inter_subframe = value;
-                    value = get_bits(4); add_line(&info_temp, "      L1D_plp_HTI_num_ti_blocks: %ld", value + 1); l1d_plp_HTI_num_ti_blocks = value;
-                    value = get_bits(12); add_line(&info_temp, "      L1D_plp_HTI_num_fec_blocks_max: %ld", value + 1);
-                    if (l1d_plp_HTI_inter_subframe == 0) {
-                        value = get_bits(12); add_line(&info_temp, "      L1D_plp_HTI_num_fec_blocks: %ld", value + 1); plp_info[j].HTI_num_fec_blocks = value + 1;
+                if (plp->params.ti_mode == 1) {
+                    add_line(info, "      L1D_plp_CTI_depth: %d", plp->cti_depth);
+                    add_line(info, "      L1D_plp_CTI_start_row: %d", plp->cti_start_row);
+                } else if (plp->params.ti_mode == 2) {
+                    add_line(info, "      L1D_plp_HTI_inter_subframe: %d", plp->hti_inter_subframe);
+                    add_line(info, "      L1D_plp_HTI_num_ti_blocks: %d", plp->hti_num_ti_blocks);
+                    add_line(info, "      L1D_plp_HTI_num_fec_blocks_max: %d", plp->hti_num_fec_blocks_max);
+                    if (plp->hti_inter_subframe == 0) {
+                        add_line(info, "      L1D_plp_HTI_num_fec_blocks: %d", plp->hti_num_fec_blocks[0]);
                     } else {
-                        for (k = 0; k <= l1d_plp_HTI_num_ti_blocks; k++) {
-                            value = get_bits(12); add_line(&info_temp, "        L1D_plp_HTI_num_fec_blocks: %ld", value + 1);
+                        for (int k = 0; k < plp->hti_num_ti_blocks; k++) {
+                            add_line(info, "        L1D_plp_HTI_num_fec_blocks: %d", plp->hti_num_fec_blocks[k]);
                         }
                     }
-                    value = get_bits(1); add_line(&info_temp, "      L1D_plp_HTI_cell_interleaver: %ld", value);
+                    add_line(info, "      L1D_plp_HTI_cell_interleaver: %d", plp->hti_cell_interleaver);
                 }
             } else {
-                value = get_bits(5); add_line(&info_temp, "      L1D_plp_ldm_injection_level: %ld", value);
+                add_line(info, "      L1D_plp_ldm_injection_level: %d", plp->ldm_injection_level);
             }
-            
-            // Calculate and add bitrate info
-            double bitrate = calculate_atsc3_bitrate_l1(
-                subframe_info[i].fft_size, subframe_info[i].guard_interval, subframe_info[i].num_ofdm_symbols,
-                (i==0 ? subframe_info[0].num_preamble_symbols : 0),
-                plp_info[j].cod, plp_info[j].mod, plp_info[j].fec_type,
-                subframe_info[i].scattered_pilot_pattern, subframe_info[i].sbs_first,
-                subframe_info[i].reduced_carriers, subframe_info[i].scattered_pilot_boost,
-                l1b_papr_reduction, plp_info[j].ti_mode, plp_info[j].HTI_num_fec_blocks,
-                l1b_l1_detail_total_cells, i, l1b_num_subframes + 1, subframe_info,
-                l1b_frame_length_mode, l1b_frame_length, l1b_excess_samples_per_symbol, plp_info[j].size
-            );
-            if (bitrate > 0) {
-                add_line(&info_temp, "      -> PLP Bitrate: %.3f Mbps", bitrate / 1000000.0);
+            if (plp->bitrate > 0) {
+                add_line(info, "      -> PLP Bitrate: %.3f Mbps", plp->bitrate / 1000000.0);
             }
         }
     }
-    
-    // Handle remaining L1D fields
-    if (l1d_version >= 1) {
-        value = get_bits(16); add_line(&info_temp, "L1D_bsid: 0x%04lx", value);
+
+    if (d->l1d_version >= 1) {
+        add_line(info, "L1D_bsid: 0x%04lx", d->bsid);
     }
-    if (l1d_version >= 2) {
-        for (i = 0; i <= l1b_num_subframes; i++) {
+    if (d->l1d_version >= 2) {
+        for (int i = 0; i < d->num_subframes; i++) {
+            const struct l1d_subframe *sf = &d->subframes[i];
             if (i > 0) {
-                value = get_bits(1); add_line(&info_temp, "  Subframe #%d L1D_mimo_mixed: %ld", i, value); l1d_mimo_mixed = value;
+                add_line(info, "  Subframe #%d L1D_mimo_mixed: %d", i, sf->mimo_mixed);
             }
-            if ((i == 0 && l1b_first_sub_mimo_mixed == 1) || (i > 0 && l1d_mimo_mixed == 1)) {
-                for (j = 0; j <= l1d_num_plp; j++) {
-                    value = get_bits(1); add_line(&info_temp, "    PLP #%d L1D_plp_mimo: %ld", j, value);
-                    if (value == 1) {
-                        value = get_bits(1); add_line(&info_temp, "      L1D_plp_mimo_stream_combining: %ld", value);
-                        value = get_bits(1); add_line(&info_temp, "      L1D_plp_mimo_IQ_interleaving: %ld", value);
-                        value = get_bits(1); add_line(&info_temp, "      L1D_plp_mimo_PH: %ld", value);
-                    }
+            for (int j = 0; j < sf->num_plp_mimo; j++) {
+                const struct l1d_plp_mimo *m = &sf->plp_mimo[j];
+                add_line(info, "    PLP #%d L1D_plp_mimo: %d", j, m->plp_mimo);
+                if (m->plp_mimo == 1) {
+                    add_line(info, "      L1D_plp_mimo_stream_combining: %d", m->stream_combining);
+                    add_line(info, "      L1D_plp_mimo_IQ_interleaving: %d", m->iq_interleaving);
+                    add_line(info, "      L1D_plp_mimo_PH: %d", m->ph);
                 }
             }
         }
     }
-    
-    // Skip any remaining bits before CRC
-    if ((((l1b_l1_detail_size_bytes * 8) - 32) - (bits_index - 200)) > 0) {
-        get_bits(((l1b_l1_detail_size_bytes * 8) - 32) - (bits_index - 200));
+    add_line(info, "L1D_crc: 0x%08lx", d->crc);
+
+    render_capacity_table(d, info);
+}
+
+/*
+ * parse_l1_into
+ * Decodes an L1-Basic/L1-Detail blob, appending the rendered fields to info,
+ * recording the LDPC frame length in info->context and keeping the decoded
+ * records in info->decoded.
+ */
+static int parse_l1_into(struct l1_detail_info *info, const unsigned char *data, size_t len) {
+    struct l1_decoded *decoded = malloc(sizeof(struct l1_decoded));
+    if (!decoded) return -1;
+    if (l1_decode(data, len, decoded) != 0) {
+        l1_decoded_free(decoded);
+        free(decoded);
+        return -1;
+    }
+
+    l1_render_lines(decoded, info);
+    if (decoded->context.ldpc_info_available && !info->context.ldpc_info_available) {
+        info->context = decoded->context;
+    }
+
+    // Keep the typed records for consumers that don't want the text
+    if (info->decoded) {
+        l1_decoded_free(info->decoded);
+        free(info->decoded);
+    }
+    info->decoded = decoded;
+    return 0;
+}
+
+void parse_l1_data_l1(const unsigned char* data, size_t len, char** display_lines, int* line_count, int max_lines, struct l1_parse_context* context) {
+    struct l1_detail_info info_temp = {display_lines, *line_count, max_lines, *context, NULL, NULL};
+    parse_l1_into(&info_temp, data, len);
+    if (info_temp.decoded) {
+        l1_decoded_free(info_temp.decoded);
+        free(info_temp.decoded);
     }
-    value = get_bits(32); add_line(&info_temp, "L1D_crc: 0x%08lx", value);
-    
-    // Update context and line count
     *context = info_temp.context;
     *line_count = info_temp.line_count;
 }
 
-void update_plp_snr_info_l1(char** display_lines, int line_count, int ldpc_length) {
+int l1_detail_parse(struct l1_detail_info *info, const unsigned char *data, size_t len) {
+    if (!info || !data || len == 0) return -1;
+    if (parse_l1_into(info, data, len) != 0) return -1;
+    if (info->context.ldpc_info_available) {
+        update_plp_snr_info_l1(info, info->context.ldpc_length);
+    }
+    return 0;
+}
+
+int l1_detail_parse_base64(struct l1_detail_info *info, const char *l1_detail_base64) {
+    if (!info || !l1_detail_base64) return -1;
+    size_t decoded_len = b64_decoded_size_l1(l1_detail_base64);
+    if (decoded_len == 0) return -1;
+    unsigned char *decoded_data = malloc(decoded_len);
+    if (!decoded_data) return -1;
+
+    int result = -1;
+    if (b64_decode_l1(l1_detail_base64, decoded_data, decoded_len)) {
+        result = l1_detail_parse(info, decoded_data, decoded_len);
+    }
+    free(decoded_data);
+    return result;
+}
+
+void update_plp_snr_info_l1(struct l1_detail_info *info, int ldpc_length) {
+    char **display_lines = info->display_lines;
+    int line_count = info->line_count;
     for (int i = 0; i < line_count; i++) {
         char* line = display_lines[i];
         if (strstr(line, "mod=") && strstr(line, "cod=")) {
@@ -730,30 +1204,11 @@ void update_plp_snr_info_l1(char** display_lines, int line_count, int ldpc_lengt
             char *cod_ptr = strstr(line, "cod=");
             
             if (mod_ptr && cod_ptr) {
-                char raw_mod_str[16] = {0}, normalized_mod_str[16] = {0}, cod_str[8] = {0};
-                
-                const char *mod_val_start = mod_ptr + 4;
-                const char *mod_val_end = strchr(mod_val_start, ' ');
-                size_t mod_len = mod_val_end ? (size_t)(mod_val_end - mod_val_start) : strlen(mod_val_start);
-                if (mod_len < sizeof(raw_mod_str)) {
-                    strncpy(raw_mod_str, mod_val_start, mod_len);
-                    raw_mod_str[mod_len] = '\0';
-                    normalize_mod_str_l1(raw_mod_str, normalized_mod_str, sizeof(normalized_mod_str));
-                }
-
-                const char *cod_val_start = cod_ptr + 4;
-                const char *cod_val_end = strchr(cod_val_start, ' ');
-                size_t cod_len = cod_val_end ? (size_t)(cod_val_end - cod_val_start) : strlen(cod_val_start);
-                if (cod_len < sizeof(cod_str)) {
-                    strncpy(cod_str, cod_val_start, cod_len);
-                    cod_str[cod_len] = '\0';
-                }
-                
                 if (i + 1 < line_count && strstr(display_lines[i + 1], "-> Required SNR:")) {
-                    struct snr_pair_result snr_result = get_snr_pair_for_modcod_l1(normalized_mod_str, cod_str, ldpc_length);
+                    int mod = mod_from_name_l1(mod_ptr + 4, strcspn(mod_ptr + 4, " "));
+                    int cod = cod_from_name_l1(cod_ptr + 4, strcspn(cod_ptr + 4, " "));
+                    struct snr_pair_result snr_result = get_snr_pair_l1(mod, cod, ldpc_length);
                     if (snr_result.found) {
-                        free(display_lines[i + 1]);
-                        
                         char snr_line[256] = {0};
                         if (snr_result.ldpc_length_known) {
                             sprintf(snr_line, "  -> Required SNR: AWGN %.2f dB, Rayleigh %.2f dB",
@@ -763,7 +1218,11 @@ void update_plp_snr_info_l1(char** display_lines, int line_count, int ldpc_lengt
                                     snr_result.awgn_min, snr_result.awgn_max, 
                                     snr_result.rayleigh_min, snr_result.rayleigh_max);
                         }
-                        display_lines[i + 1] = strdup(snr_line);
+                        char *replacement = store_line(info, snr_line);
+                        if (replacement) {
+                            if (!info->arena) free(display_lines[i + 1]);
+                            display_lines[i + 1] = replacement;
+                        }
                     }
                 }
             }
@@ -771,44 +1230,155 @@ void update_plp_snr_info_l1(char** display_lines, int line_count, int ldpc_lengt
     }
 }
 
-int collect_atsc3_details(struct hdhomerun_device_t *hd, int tuner_index, struct l1_detail_info* detail_info) {
+// Per-tuner L1 change tracker. Holds a hash of the last base64 L1 detail
+// and its rendered lines, so an unchanged L1 is never decoded twice.
+struct l1_tracker {
+    uint32_t device_id;
+    int tuner_index;
+    bool valid;                 // lines holds a decode of the current L1
+    bool seen;                  // A good L1 has been decoded; hash and crc are from it
+    uint64_t hash;
+    long crc;
+    unsigned int change_count;
+    time_t last_change;
+    struct l1_detail_info *lines;
+    l1_change_callback on_change;
+    void *opaque;
+};
+
+/*
+ * hash_l1_string
+ * 64-bit FNV-1a over the base64 text.
+ */
+static uint64_t hash_l1_string(const char *s) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (; *s; s++) {
+        hash ^= (unsigned char)*s;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+struct l1_tracker* l1_tracker_create(uint32_t device_id, int tuner_index, l1_change_callback on_change, void *opaque) {
+    struct l1_tracker *tracker = calloc(1, sizeof(struct l1_tracker));
+    if (!tracker) return NULL;
+    tracker->lines = create_l1_detail_info(MAX_DISPLAY_LINES);
+    if (!tracker->lines) {
+        free(tracker);
+        return NULL;
+    }
+    tracker->device_id = device_id;
+    tracker->tuner_index = tuner_index;
+    tracker->on_change = on_change;
+    tracker->opaque = opaque;
+    return tracker;
+}
+
+void l1_tracker_destroy(struct l1_tracker *tracker) {
+    if (!tracker) return;
+    free_l1_detail_info(tracker->lines);
+    free(tracker);
+}
+
+enum l1_tracker_result l1_tracker_update(struct l1_tracker *tracker, const char *l1_detail_base64) {
+    if (!tracker || !l1_detail_base64) return L1_TRACKER_INVALID;
+
+    uint64_t hash = hash_l1_string(l1_detail_base64);
+    if (tracker->valid && hash == tracker->hash) return L1_TRACKER_UNCHANGED;
+
+    l1_detail_info_reset(tracker->lines);
+    if (l1_detail_parse_base64(tracker->lines, l1_detail_base64) != 0) {
+        // The last good hash and CRC stay, so the next good L1 is still
+        // compared against them rather than taken as the first
+        tracker->valid = false;
+        return L1_TRACKER_INVALID;
+    }
+    tracker->valid = true;
+    long new_crc = tracker->lines->decoded ? tracker->lines->decoded->crc : -1;
+
+    enum l1_tracker_result result = !tracker->seen ? L1_TRACKER_FIRST
+                                  : (hash == tracker->hash ? L1_TRACKER_UNCHANGED : L1_TRACKER_CHANGED);
+    if (result == L1_TRACKER_UNCHANGED) return result; // Same L1 as before a failed decode
+
+    long old_crc = tracker->seen ? tracker->crc : -1;
+    tracker->seen = true;
+    tracker->hash = hash;
+    tracker->crc = new_crc;
+    tracker->last_change = time(NULL);
+    if (result == L1_TRACKER_CHANGED) {
+        tracker->change_count++;
+        if (tracker->on_change) {
+            struct l1_change_event event = {
+                tracker->device_id, tracker->tuner_index, tracker->last_change,
+                old_crc, new_crc, tracker->change_count,
+            };
+            tracker->on_change(tracker->opaque, &event);
+        }
+    }
+    return result;
+}
+
+const struct l1_decoded* l1_tracker_decoded(const struct l1_tracker *tracker) {
+    return (tracker && tracker->valid) ? tracker->lines->decoded : NULL;
+}
+
+unsigned int l1_tracker_change_count(const struct l1_tracker *tracker) {
+    return tracker ? tracker->change_count : 0;
+}
+
+time_t l1_tracker_last_change(const struct l1_tracker *tracker) {
+    return tracker ? tracker->last_change : 0;
+}
+
+/*
+ * append_l1_lines
+ * Copies the tracker's rendered L1 lines and LDPC context into info.
+ */
+static void append_l1_lines(struct l1_detail_info *info, const struct l1_tracker *tracker) {
+    const struct l1_detail_info *lines = tracker->lines;
+    for (int i = 0; i < lines->line_count; i++) {
+        add_line(info, "%s", lines->display_lines[i]);
+    }
+    if (lines->context.ldpc_info_available && !info->context.ldpc_info_available) {
+        info->context = lines->context;
+    }
+}
+
+int collect_atsc3_details(struct hdhomerun_device_t *hd, int tuner_index, struct l1_detail_info* detail_info, struct query_cache *cache,
+                          struct l1_tracker *tracker) {
     if (!hd || !detail_info) return -1;
+
+    // Repeated plpinfo/streaminfo/version reads below are served from this cache
+    struct query_cache *own_cache = NULL;
+    if (!cache) cache = own_cache = query_cache_create(QUERY_CACHE_DEFAULT_TTL_MS);
     
-    // Reset line count
-    detail_info->line_count = 0;
-    detail_info->context.ldpc_info_available = false;
-    detail_info->context.ldpc_length = -1;
+    // Start from an empty line store; arena blocks are kept for reuse
+    l1_detail_info_reset(detail_info);
     
     char *plpinfo_str_orig;
     char *streaminfo_str_orig;
     
     // Get PLP info
-    if (hdhomerun_device_get_tuner_plpinfo(hd, &plpinfo_str_orig) <= 0) {
+    if (query_cache_get_tuner_plpinfo(cache, hd, &plpinfo_str_orig) <= 0) {
+        query_cache_destroy(own_cache);
         return -1; // No PLP info available
     }
     char *plpinfo_copy = strdup(plpinfo_str_orig);
 
     // Get stream info
-    if (hdhomerun_device_get_tuner_streaminfo(hd, &streaminfo_str_orig) <= 0) {
+    if (query_cache_get_tuner_streaminfo(cache, hd, &streaminfo_str_orig) <= 0) {
         streaminfo_str_orig = "";
     }
     char *streaminfo_copy = strdup(streaminfo_str_orig);
 
     // Add initial spacing
-    if (detail_info->line_count < detail_info->max_lines) {
-        detail_info->display_lines[detail_info->line_count++] = strdup(" ");
-    }
+    add_line(detail_info, " ");
     
     // Add firmware version
     char *version_str;
-    if (hdhomerun_device_get_var(hd, "/sys/version", &version_str, NULL) > 0) {
-        char version_line[128];
-        sprintf(version_line, "Firmware Version: %s", version_str);
-        detail_info->display_lines[detail_info->line_count++] = strdup(version_line);
-        
-        if (detail_info->line_count < detail_info->max_lines) {
-            detail_info->display_lines[detail_info->line_count++] = strdup(" ");
-        }
+    if (query_cache_get_var(cache, hd, "/sys/version", &version_str) > 0) {
+        add_line(detail_info, "Firmware Version: %s", version_str);
+        add_line(detail_info, " ");
     }
 
     // Add BSID and TSID info
@@ -816,86 +1386,60 @@ int collect_atsc3_details(struct hdhomerun_device_t *hd, int tuner_index, struct
     long tsid = -999;
 
     char *fresh_plpinfo;
-    if (hdhomerun_device_get_tuner_plpinfo(hd, &fresh_plpinfo) > 0) {
-        bsid = parse_status_value_l1(fresh_plpinfo, "bsid=");
+    if (query_cache_get_tuner_plpinfo(cache, hd, &fresh_plpinfo) > 0) {
+        bsid = status_fields_lookup(fresh_plpinfo, STATUS_KEY_BSID);
     }
 
     char *fresh_streaminfo;
-    if (hdhomerun_device_get_tuner_streaminfo(hd, &fresh_streaminfo) > 0) {
-        tsid = parse_status_value_l1(fresh_streaminfo, "tsid=");
+    if (query_cache_get_tuner_streaminfo(cache, hd, &fresh_streaminfo) > 0) {
+        tsid = status_fields_lookup(fresh_streaminfo, STATUS_KEY_TSID);
     }
 
     if (bsid != -999) {
-        char bsid_line[64];
-        sprintf(bsid_line, "L1D BSID: %ld (0x%lX)", bsid, bsid);
-        detail_info->display_lines[detail_info->line_count++] = strdup(bsid_line);
+        add_line(detail_info, "L1D BSID: %ld (0x%lX)", bsid, bsid);
     } else {
-        detail_info->display_lines[detail_info->line_count++] = strdup("L1D BSID: Not set");
+        add_line(detail_info, "L1D BSID: Not set");
     }
 
     if (tsid != -999) {
-        char tsid_line[64];
-        sprintf(tsid_line, "SLT TSID: %ld (0x%lX)", tsid, tsid);
-        detail_info->display_lines[detail_info->line_count++] = strdup(tsid_line);
+        add_line(detail_info, "SLT TSID: %ld (0x%lX)", tsid, tsid);
     } else {
-        detail_info->display_lines[detail_info->line_count++] = strdup("SLT TSID: Not set");
+        add_line(detail_info, "SLT TSID: Not set");
     }
 
-    if (detail_info->line_count < detail_info->max_lines) {
-        detail_info->display_lines[detail_info->line_count++] = strdup(" ");
-    }
+    add_line(detail_info, " ");
 
     // Process PLP info
     if (plpinfo_copy) {
-        char *line = strtok(plpinfo_copy, "\n");
+        char *save_ptr = NULL;
+        char *line = strtok_r(plpinfo_copy, "\n", &save_ptr);
         while (line != NULL && detail_info->line_count < detail_info->max_lines) {
             if (strncmp(line, "bsid=", 5) != 0) {
-                detail_info->display_lines[detail_info->line_count++] = strdup(line);
+                add_line(detail_info, "%s", line);
                 
                 char *mod_ptr = strstr(line, "mod=");
                 char *cod_ptr = strstr(line, "cod=");
 
-                if (mod_ptr && cod_ptr && detail_info->line_count < detail_info->max_lines) {
-                    char raw_mod_str[16] = {0}, normalized_mod_str[16] = {0}, cod_str[8] = {0};
-                    
-                    const char *mod_val_start = mod_ptr + 4;
-                    const char *mod_val_end = strchr(mod_val_start, ' ');
-                    size_t mod_len = mod_val_end ? (size_t)(mod_val_end - mod_val_start) : strlen(mod_val_start);
-                    if (mod_len < sizeof(raw_mod_str)) {
-                        strncpy(raw_mod_str, mod_val_start, mod_len);
-                        raw_mod_str[mod_len] = '\0';
-                        normalize_mod_str_l1(raw_mod_str, normalized_mod_str, sizeof(normalized_mod_str));
-                    }
-
-                    const char *cod_val_start = cod_ptr + 4;
-                    const char *cod_val_end = strchr(cod_val_start, ' ');
-                    size_t cod_len = cod_val_end ? (size_t)(cod_val_end - cod_val_start) : strlen(cod_val_start);
-                    if (cod_len < sizeof(cod_str)) {
-                        strncpy(cod_str, cod_val_start, cod_len);
-                        cod_str[cod_len] = '\0';
-                    }
-                    
+                if (mod_ptr && cod_ptr) {
+                    int mod = mod_from_name_l1(mod_ptr + 4, strcspn(mod_ptr + 4, " "));
+                    int cod = cod_from_name_l1(cod_ptr + 4, strcspn(cod_ptr + 4, " "));
                     int ldpc_length = -1;  // Unknown by default
-                    struct snr_pair_result snr_result = get_snr_pair_for_modcod_l1(normalized_mod_str, cod_str, ldpc_length);
+                    struct snr_pair_result snr_result = get_snr_pair_l1(mod, cod, ldpc_length);
                     if (snr_result.found) {
-                        char snr_line[256] = {0};
                         if (snr_result.ldpc_length_known) {
-                            sprintf(snr_line, "  -> Required SNR: AWGN %.2f dB, Rayleigh %.2f dB (%s)", 
-                                    snr_result.awgn_min, snr_result.rayleigh_min, snr_result.description);
+                            add_line(detail_info, "  -> Required SNR: AWGN %.2f dB, Rayleigh %.2f dB (%s)", 
+                                     snr_result.awgn_min, snr_result.rayleigh_min, snr_result.description);
                         } else {
-                            sprintf(snr_line, "  -> Required SNR: AWGN %.2f to %.2f dB, Rayleigh %.2f to %.2f dB", 
-                            snr_result.awgn_min, snr_result.awgn_max, 
-                            snr_result.rayleigh_min, snr_result.rayleigh_max);
+                            add_line(detail_info, "  -> Required SNR: AWGN %.2f to %.2f dB, Rayleigh %.2f to %.2f dB", 
+                                     snr_result.awgn_min, snr_result.awgn_max, 
+                                     snr_result.rayleigh_min, snr_result.rayleigh_max);
                         }
-                        detail_info->display_lines[detail_info->line_count++] = strdup(snr_line);
                     }
                 }
 
-                if (detail_info->line_count < detail_info->max_lines) {
-                    detail_info->display_lines[detail_info->line_count++] = strdup(" ");
-                }
+                add_line(detail_info, " ");
             }
-            line = strtok(NULL, "\n");
+            line = strtok_r(NULL, "\n", &save_ptr);
         }
     }
 
@@ -903,13 +1447,13 @@ int collect_atsc3_details(struct hdhomerun_device_t *hd, int tuner_index, struct
     char *raw_status_str;
     struct hdhomerun_tuner_status_t status;
     bool has_db_values = false;
-    if (hdhomerun_device_get_tuner_status(hd, &raw_status_str, &status) > 0) {
-        if (parse_status_value_l1(raw_status_str, "ss=") != -999) has_db_values = true;
+    if (query_cache_get_tuner_status(cache, hd, &raw_status_str, &status) > 0) {
+        if (status_fields_lookup(raw_status_str, STATUS_KEY_SS) != STATUS_VALUE_NONE) has_db_values = true;
     }
 
     char *fresh_version_str;
     long version_num = 0;
-    if (hdhomerun_device_get_var(hd, "/sys/version", &fresh_version_str, NULL) > 0) {
+    if (query_cache_get_var(cache, hd, "/sys/version", &fresh_version_str) > 0) {
         char numeric_version_str[16] = {0};
         int i = 0;
         while(fresh_version_str[i] && isdigit((unsigned char)fresh_version_str[i]) && i < 15) {
@@ -924,33 +1468,39 @@ int collect_atsc3_details(struct hdhomerun_device_t *hd, int tuner_index, struct
         sprintf(l1_path, "/tuner%d/l1detail", tuner_index);
 
         char *l1_detail_str;
-        if (hdhomerun_device_get_var(hd, l1_path, &l1_detail_str, NULL) > 0) {
+        if (query_cache_get_var(cache, hd, l1_path, &l1_detail_str) > 0) {
             // Add separator before L1 detail info
             if (detail_info->line_count < detail_info->max_lines - 3) {
-                detail_info->display_lines[detail_info->line_count++] = strdup("__HLINE__");
-                detail_info->display_lines[detail_info->line_count++] = strdup(" ");
+                add_line(detail_info, "__HLINE__");
+                add_line(detail_info, " ");
             }
 
-            size_t decoded_len = b64_decoded_size_l1(l1_detail_str);
-            unsigned char *decoded_data = malloc(decoded_len);
-            if (decoded_data) {
-                if (b64_decode_l1(l1_detail_str, decoded_data, decoded_len)) {
-                    parse_l1_data_l1(decoded_data, decoded_len, detail_info->display_lines, 
-                                    &detail_info->line_count, detail_info->max_lines, &detail_info->context);
-                    
-                    // Update SNR info with LDPC-aware values
+            if (tracker) {
+                // Only decoded when the L1 detail differs from last time
+                if (l1_tracker_update(tracker, l1_detail_str) != L1_TRACKER_INVALID) {
+                    if (tracker->change_count > 0) {
+                        char time_str[32];
+                        struct tm tm_info;
+                        localtime_r(&tracker->last_change, &tm_info);
+                        strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &tm_info);
+                        add_line(detail_info, "L1 Detail changes seen: %u (last at %s)", tracker->change_count, time_str);
+                        add_line(detail_info, " ");
+                    }
+                    append_l1_lines(detail_info, tracker);
                     if (detail_info->context.ldpc_info_available) {
-                        update_plp_snr_info_l1(detail_info->display_lines, detail_info->line_count, 
-                                              detail_info->context.ldpc_length);
+                        update_plp_snr_info_l1(detail_info, detail_info->context.ldpc_length);
                     }
                 }
-                free(decoded_data);
+            } else {
+                // Also updates SNR info with LDPC-aware values
+                l1_detail_parse_base64(detail_info, l1_detail_str);
             }
         }
     }
 
     free(streaminfo_copy);
     free(plpinfo_copy);
+    query_cache_destroy(own_cache);
     return 0;
 }
 
@@ -980,26 +1530,32 @@ int save_atsc3_details_to_file(const char* filename, struct l1_detail_info* deta
     return 0;
 }
 
-int save_atsc3_details_auto(struct hdhomerun_device_t *hd, int tuner_index, const char* base_filename) {
+int save_atsc3_details_auto(struct hdhomerun_device_t *hd, int tuner_index, const char* base_filename, struct query_cache *cache,
+                            struct l1_tracker *tracker) {
     if (!hd || !base_filename) return -1;
     
     // Create detail info structure
     struct l1_detail_info* detail_info = create_l1_detail_info(MAX_DISPLAY_LINES);
     if (!detail_info) return -1;
+
+    // Share one cache with collect_atsc3_details so version/l1detail are read once
+    struct query_cache *own_cache = NULL;
+    if (!cache) cache = own_cache = query_cache_create(QUERY_CACHE_DEFAULT_TTL_MS);
     
     char *saved_l1_detail_str = NULL;
     
     // Collect the details
-    int result = collect_atsc3_details(hd, tuner_index, detail_info);
+    int result = collect_atsc3_details(hd, tuner_index, detail_info, cache, tracker);
     if (result != 0) {
         free_l1_detail_info(detail_info);
+        query_cache_destroy(own_cache);
         return result;
     }
     
     // Capture L1 detail base64 string for file output
     char *version_str;
     long version_num = 0;
-    if (hdhomerun_device_get_var(hd, "/sys/version", &version_str, NULL) > 0) {
+    if (query_cache_get_var(cache, hd, "/sys/version", &version_str) > 0) {
         char numeric_version_str[16] = {0};
         int i = 0;
         while(version_str[i] && isdigit((unsigned char)version_str[i]) && i < 15) {
@@ -1013,7 +1569,7 @@ int save_atsc3_details_auto(struct hdhomerun_device_t *hd, int tuner_index, cons
         char l1_path[64];
         sprintf(l1_path, "/tuner%d/l1detail", tuner_index);
         char *l1_detail_str;
-        if (hdhomerun_device_get_var(hd, l1_path, &l1_detail_str, NULL) > 0) {
+        if (query_cache_get_var(cache, hd, l1_path, &l1_detail_str) > 0) {
             saved_l1_detail_str = strdup(l1_detail_str);
         }
     }
@@ -1036,5 +1592,6 @@ int save_atsc3_details_auto(struct hdhomerun_device_t *hd, int tuner_index, cons
     }
     
     free_l1_detail_info(detail_info);
+    query_cache_destroy(own_cache);
     return result;
 }
@@ -18,9 +18,12 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <time.h>
 
 // Forward declarations to avoid duplicate includes
 struct hdhomerun_device_t;
+struct query_cache;
+struct l1_line_arena;
 
 #define MAX_DISPLAY_LINES (64 * 20 + 400) // Increased buffer for bitrate info
 #define MAX_PLPS 64
@@ -81,48 +84,206 @@ struct plp_info_t {
     long size;
 };
 
+// Decoded L1 signaling
+// Fields hold the signaled values, except counts and sizes, which include
+// the +1 that the standard encodes (e.g. num_subframes, num_ofdm_symbols).
+struct l1b_info {
+    int version;
+    int mimo_scattered_pilot_encoding;
+    int lls_flag;
+    int time_info_flag;
+    int return_channel_flag;
+    int papr_reduction;
+    int frame_length_mode;
+    int frame_length;               // frame_length_mode == 0
+    int excess_samples_per_symbol;  // frame_length_mode == 0
+    int time_offset;                // frame_length_mode == 1
+    int additional_samples;         // frame_length_mode == 1
+    int num_subframes;
+    int preamble_reduced_carriers;
+    int l1_detail_content_tag;
+    int l1_detail_size_bytes;
+    int l1_detail_fec_type;
+    int l1_additional_parity_mode;
+    int l1_detail_total_cells;
+    int first_sub_mimo;
+    int first_sub_miso;
+    int first_sub_mimo_mixed;       // version >= 1
+    long crc;
+};
+
+struct l1d_plp_mimo {
+    unsigned char plp_mimo;
+    unsigned char stream_combining;
+    unsigned char iq_interleaving;
+    unsigned char ph;
+};
+
+struct l1d_subframe {
+    struct subframe_info_t params;  // For subframe 0 these come from L1-Basic
+    int mimo, miso;                 // Subframes after the first
+    int subframe_multiplex;         // Only when there is more than one subframe
+    int frequency_interleaver;
+    bool has_sbs_null_cells;
+    int sbs_null_cells;
+    int first_plp;                  // Index into l1_decoded.plps
+    double symbol_time_ms;          // One OFDM symbol, guard interval included
+    int num_plp;
+
+    // L1D version 2 additions
+    int mimo_mixed;
+    int num_plp_mimo;
+    struct l1d_plp_mimo plp_mimo[MAX_PLPS];
+};
+
+struct l1d_plp {
+    struct plp_info_t params;
+    int subframe;
+    int lls_flag;
+    int layer;
+    long start;
+    int scrambler_type;
+    int fec_type;                   // Raw 4-bit L1D_plp_fec_type
+    bool has_modcod;                // mod/cod are only signaled for fec_type <= 5
+    int fec_block_start;            // ti_mode 0 (fec_block_start) or 1 (CTI_fec_block_start)
+    int num_channel_bonded;
+    int channel_bonding_format;
+    int bonded_rf_id[8];
+    bool has_mimo;
+    int mimo_stream_combining, mimo_iq_interleaving, mimo_ph;
+    int dispersed;
+    int num_subslices;
+    long subslice_interval;
+    bool has_ti_extended_interleaving;
+    int ti_extended_interleaving;
+    int cti_depth, cti_start_row;
+    int hti_inter_subframe;
+    int hti_num_ti_blocks;
+    int hti_num_fec_blocks_max;
+    int hti_num_fec_blocks[16];     // One per TI block when hti_inter_subframe
+    int hti_cell_interleaver;
+    int ldm_injection_level;        // Enhanced layer only
+    double bitrate;                 // bps, 0 if it could not be computed
+    double fec_blocks;              // FEC blocks per frame
+};
+
+struct l1_decoded {
+    struct l1b_info l1b;
+    int l1d_version;
+    int num_rf;
+    int bonded_bsid[8];
+    long time_sec;
+    int time_msec, time_usec, time_nsec;
+    int num_subframes;
+    struct l1d_subframe *subframes;
+    int num_plps;
+    struct l1d_plp *plps;
+    long bsid;                      // l1d_version >= 1
+    long crc;
+    double frame_time_ms;           // TF, 0 if it could not be computed
+    struct l1_parse_context context;
+};
+
 // SNR lookup result structure
 struct snr_pair_result {
     bool found;
     bool ldpc_length_known;
     float awgn_min, awgn_max;
     float rayleigh_min, rayleigh_max;
-    char description[64];
+    const char *description;   // Static string
 };
 
 // Structure to hold complete L1 detail information
+// This is the parser's whole state: the output lines plus the LDPC context
+// gathered while decoding. The parser keeps no globals, so separate
+// l1_detail_info objects can be filled concurrently from different threads.
 struct l1_detail_info {
     char **display_lines;
     int line_count;
     int max_lines;
     struct l1_parse_context context;
+    struct l1_decoded *decoded;     // Typed L1 records, NULL until an L1 blob is parsed
+    struct l1_line_arena *arena;    // Backing store for display_lines
 };
 
 // Function prototypes
 struct l1_detail_info* create_l1_detail_info(int max_lines);
 void free_l1_detail_info(struct l1_detail_info* info);
 
+// Empties the info for another refresh. Lines are arena-allocated and stay
+// valid only until the next reset or free; the arena itself is kept.
+void l1_detail_info_reset(struct l1_detail_info *info);
+
+// Per-tuner L1 change tracking
+// The tracker remembers a hash of the last /tunerN/l1detail string and its
+// decoded lines; an unchanged L1 is copied instead of decoded again, and a
+// changed one is reported to the callback.
+struct l1_tracker;
+
+enum l1_tracker_result {
+    L1_TRACKER_UNCHANGED,
+    L1_TRACKER_FIRST,       // First L1 seen by this tracker
+    L1_TRACKER_CHANGED,
+    L1_TRACKER_INVALID,     // Could not be decoded
+};
+
+struct l1_change_event {
+    uint32_t device_id;
+    int tuner_index;
+    time_t time;
+    long old_crc;           // L1D_crc before and after
+    long new_crc;
+    unsigned int change_count;
+};
+
+typedef void (*l1_change_callback)(void *opaque, const struct l1_change_event *event);
+
+struct l1_tracker* l1_tracker_create(uint32_t device_id, int tuner_index, l1_change_callback on_change, void *opaque);
+void l1_tracker_destroy(struct l1_tracker *tracker);
+enum l1_tracker_result l1_tracker_update(struct l1_tracker *tracker, const char *l1_detail_base64);
+const struct l1_decoded* l1_tracker_decoded(const struct l1_tracker *tracker);
+unsigned int l1_tracker_change_count(const struct l1_tracker *tracker);
+time_t l1_tracker_last_change(const struct l1_tracker *tracker);
+
+// cache and tracker may be NULL; without a cache a private one is used for
+// the call, without a tracker the L1 detail is always decoded.
+// hd, cache and tracker must not be shared with another thread during the call.
 int collect_atsc3_details(struct hdhomerun_device_t *hd, int tuner_index, 
-                         struct l1_detail_info* detail_info);
+                         struct l1_detail_info* detail_info, struct query_cache *cache,
+                         struct l1_tracker *tracker);
 
 int save_atsc3_details_to_file(const char* filename, 
                               struct l1_detail_info* detail_info,
                               const char* l1_detail_base64);
 
 int save_atsc3_details_auto(struct hdhomerun_device_t *hd, int tuner_index,
-                           const char* base_filename);
+                           const char* base_filename, struct query_cache *cache,
+                           struct l1_tracker *tracker);
 
 // Helper functions
 long parse_status_value_l1(const char *status_str, const char *key);
 void normalize_mod_str_l1(const char *in, char *out, size_t out_size);
 struct snr_pair_result get_snr_pair_for_modcod_l1(const char* mod, const char* cod, int ldpc_length);
-double calculate_atsc3_bitrate_l1(int fft_size_enum, int guardinterval, int numpayloadsyms, 
-                                 int numpreamblesyms, int rate, int constellation, int framesize, 
-                                 int pilotpattern, int firstsbs, int cred, int pilotboost, 
-                                 int paprmode, int ti_mode, int fec_blocks, int l1_detail_cells, 
-                                 int subframe, int num_subframes, struct subframe_info_t *subframe_info, 
-                                 int frame_length_mode, int frame_length, int excess_samples, 
-                                 long plp_size_cells);
+// Constant-time lookup by atsc3_constellation_t / atsc3_code_rate_t.
+// found is false for reserved values.
+struct snr_pair_result get_snr_pair_l1(int mod, int cod, int ldpc_length);
+// Parse a modulation ("qam256", "256QAM", "QPSK") or code rate ("10/15")
+// name of at most len characters, stopping at a space. Return -1 if unknown.
+int mod_from_name_l1(const char *name, size_t len);
+int cod_from_name_l1(const char *name, size_t len);
+// PLP bitrate, adapted from atsc3rate() in l1dump.c and split up so the
+// frame time TF is only worked out once per frame
+double atsc3_symbol_time_ms_l1(int fft_size, int guard_interval);
+double atsc3_frame_time_ms_l1(const struct subframe_info_t *subframe_info, int num_subframes,
+                              int frame_length_mode, int frame_length);
+double atsc3_plp_bitrate_l1(double frame_time_ms, int rate, int constellation, int framesize, long plp_size_cells);
+double atsc3_plp_fec_blocks_l1(int constellation, int framesize, long plp_size_cells);
+
+// Names as used in the SNR table ("256QAM", "10/15"), or "Reserved"
+const char* mod_name_l1(int mod);
+const char* cod_name_l1(int cod);
+// 0 = short (16200), 1 = long (64800), -1 if the PLP has no LDPC
+int plp_ldpc_length_l1(const struct l1d_plp *plp);
 
 // Base64 decoding functions
 size_t b64_decoded_size_l1(const char *in);
@@ -130,8 +291,21 @@ int b64_decode_l1(const char *in, unsigned char *out, size_t outlen);
 int b64_isvalidchar_l1(char c);
 
 // L1 parsing functions
+// Decode a raw L1 blob into typed records, without rendering any text.
+// l1_decoded_free releases the records; the struct itself is the caller's.
+int l1_decode(const unsigned char *data, size_t len, struct l1_decoded *out);
+void l1_decoded_free(struct l1_decoded *decoded);
+
+// Render decoded L1 signaling as display lines appended to info.
+void l1_render_lines(const struct l1_decoded *decoded, struct l1_detail_info *info);
+
+// Decode a raw (or base64 /tunerN/l1detail) blob and append its fields to
+// info, including LDPC-aware SNR requirements. Return 0 on success.
+int l1_detail_parse(struct l1_detail_info *info, const unsigned char *data, size_t len);
+int l1_detail_parse_base64(struct l1_detail_info *info, const char *l1_detail_base64);
+
 void parse_l1_data_l1(const unsigned char* data, size_t len, char** display_lines, 
                      int* line_count, int max_lines, struct l1_parse_context* context);
-void update_plp_snr_info_l1(char** display_lines, int line_count, int ldpc_length);
+void update_plp_snr_info_l1(struct l1_detail_info *info, int ldpc_length);
 
 #endif // L1_DETAIL_PARSER_H
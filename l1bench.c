@@ -0,0 +1,165 @@
+/*
+ * l1bench.c
+ *
+ * Micro-benchmark for the L1 detail parser
+ * Times the three stages every L1 refresh goes through - base64 decode,
+ * l1_decode and l1_render_lines - over a fixed corpus of generated L1
+ * blobs, so parser changes can be compared run to run. Built and run by
+ * "make bench".
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <getopt.h>
+#include "l1_detail_parser.h"
+
+#define BENCH_CORPUS_SIZE 256
+#define BENCH_BLOB_SIZE 600     // About the size of a real L1 detail with a few PLPs
+#define BENCH_MAX_SUBFRAMES 4
+#define BENCH_MAX_PLPS 16
+#define BENCH_CORPUS_TRIES 50000000L
+
+static const char b64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct corpus_entry {
+    unsigned char blob[BENCH_BLOB_SIZE];
+    char b64[(BENCH_BLOB_SIZE + 2) / 3 * 4 + 1];
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// xorshift32, so the corpus is the same on every platform
+static uint32_t next_random(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static void b64_encode(const unsigned char *in, size_t len, char *out) {
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < len) v |= in[i + 2];
+        out[o++] = b64_alphabet[(v >> 18) & 0x3f];
+        out[o++] = b64_alphabet[(v >> 12) & 0x3f];
+        out[o++] = i + 1 < len ? b64_alphabet[(v >> 6) & 0x3f] : '=';
+        out[o++] = i + 2 < len ? b64_alphabet[v & 0x3f] : '=';
+    }
+    out[o] = '\0';
+}
+
+/*
+ * build_corpus
+ * Random blobs, kept only if they decode to a broadcast-like shape (a few
+ * subframes and PLPs) so timings aren't dominated by pathological input.
+ * Returns false if too few candidates qualified.
+ */
+static bool build_corpus(struct corpus_entry corpus[], uint32_t seed) {
+    uint32_t state = seed ? seed : 1;
+    int c = 0;
+    for (long tries = 0; c < BENCH_CORPUS_SIZE && tries < BENCH_CORPUS_TRIES; tries++) {
+        unsigned char *blob = corpus[c].blob;
+        for (int i = 0; i < BENCH_BLOB_SIZE; i++) blob[i] = (unsigned char)next_random(&state);
+        blob[0] &= 0x1f;    // L1-Basic version 0
+
+        struct l1_decoded d;
+        bool keep = l1_decode(blob, BENCH_BLOB_SIZE, &d) == 0 &&
+                    d.num_subframes <= BENCH_MAX_SUBFRAMES && d.num_plps >= 1 && d.num_plps <= BENCH_MAX_PLPS;
+        l1_decoded_free(&d);
+        if (!keep) continue;
+        b64_encode(blob, BENCH_BLOB_SIZE, corpus[c].b64);
+        c++;
+    }
+    return c == BENCH_CORPUS_SIZE;
+}
+
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [-n iterations] [-s seed]\n", program_name);
+    printf("  -n <n>   Passes over the %d-blob corpus (default 100)\n", BENCH_CORPUS_SIZE);
+    printf("  -s <n>   Corpus seed (default 1)\n");
+}
+
+int main(int argc, char **argv) {
+    int iterations = 100;
+    uint32_t seed = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:h")) != -1) {
+        switch (opt) {
+            case 'n': iterations = atoi(optarg); if (iterations < 1) iterations = 1; break;
+            case 's': seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+            default: print_usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    struct corpus_entry *corpus = calloc(BENCH_CORPUS_SIZE, sizeof(struct corpus_entry));
+    struct l1_detail_info *info = create_l1_detail_info(MAX_DISPLAY_LINES);
+    if (!corpus || !info) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    if (!build_corpus(corpus, seed)) {
+        fprintf(stderr, "Could not generate a corpus from seed %u\n", seed);
+        return 1;
+    }
+
+    unsigned char decoded_blob[BENCH_BLOB_SIZE];
+    uint64_t b64_ns = 0, decode_ns = 0, render_ns = 0;
+    long decoded = 0, plps = 0, lines = 0;
+
+    for (int it = 0; it < iterations; it++) {
+        for (int c = 0; c < BENCH_CORPUS_SIZE; c++) {
+            uint64_t t0 = now_ns();
+            size_t len = b64_decoded_size_l1(corpus[c].b64);
+            int ok = len <= sizeof(decoded_blob) && b64_decode_l1(corpus[c].b64, decoded_blob, len);
+            uint64_t t1 = now_ns();
+            b64_ns += t1 - t0;
+            if (!ok) continue;
+
+            struct l1_decoded d;
+            int result = l1_decode(decoded_blob, len, &d);
+            uint64_t t2 = now_ns();
+            decode_ns += t2 - t1;
+
+            if (result == 0) {
+                l1_detail_info_reset(info);
+                l1_render_lines(&d, info);
+                render_ns += now_ns() - t2;
+                decoded++;
+                plps += d.num_plps;
+                lines += info->line_count;
+            }
+            l1_decoded_free(&d);
+        }
+    }
+
+    long runs = (long)iterations * BENCH_CORPUS_SIZE;
+    double b64_mb = runs * (double)strlen(corpus[0].b64) / 1e6;
+    printf("l1bench: %d x %d blobs of %d bytes, seed %u\n", iterations, BENCH_CORPUS_SIZE, BENCH_BLOB_SIZE, seed);
+    printf("  %ld decoded, %.1f PLPs and %.1f lines per blob\n", decoded,
+           decoded ? (double)plps / decoded : 0.0, decoded ? (double)lines / decoded : 0.0);
+    printf("  base64 decode   %9.0f ns/blob  (%.1f MB/s)\n", (double)b64_ns / runs, b64_ns ? b64_mb / (b64_ns / 1e9) : 0.0);
+    printf("  l1_decode       %9.0f ns/blob\n", (double)decode_ns / runs);
+    printf("  l1_render_lines %9.0f ns/blob\n", decoded ? (double)render_ns / decoded : 0.0);
+
+    free_l1_detail_info(info);
+    free(corpus);
+    return 0;
+}
@@ -0,0 +1,396 @@
+/*
+ * l1decode.c
+ *
+ * Offline ATSC 3.0 L1 detail decoder
+ * Bulk-decodes the "Raw L1 Detail (Base64)" block at the end of the .txt
+ * sidecars written by save_atsc3_details_auto, and prints per-PLP bitrate,
+ * modcod and required SNR as CSV or JSON lines. Files are decoded in
+ * parallel, one worker thread per core by default.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include "l1_detail_parser.h"
+
+#define L1_BASE64_MARKER "Raw L1 Detail (Base64):"
+#define L1DECODE_MAX_THREADS 256
+
+enum output_format {
+    FORMAT_CSV,
+    FORMAT_JSON,
+};
+
+struct decode_result {
+    char *text;                 // Formatted output for the file
+    size_t len;
+    bool ok;
+
+    // Per-stage time, for -t
+    size_t b64_chars;
+    uint64_t b64_ns, decode_ns, format_ns;
+};
+
+struct decode_batch {
+    char **files;
+    int count;
+    enum output_format format;
+    atomic_int next;            // Next file to hand to a worker
+    struct decode_result *results;
+};
+
+/*
+ * add_file
+ * Appends a path to a growable list.
+ */
+static int add_file(char ***files, int *count, int *capacity, const char *path) {
+    if (*count == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 256;
+        char **grown = realloc(*files, new_capacity * sizeof(char *));
+        if (!grown) return -1;
+        *files = grown;
+        *capacity = new_capacity;
+    }
+    (*files)[*count] = strdup(path);
+    if (!(*files)[*count]) return -1;
+    (*count)++;
+    return 0;
+}
+
+/*
+ * collect_files
+ * Adds path itself if it is a file, or every .txt file below it if it is
+ * a directory.
+ */
+static int collect_files(const char *path, char ***files, int *count, int *capacity) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "l1decode: cannot access %s\n", path);
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) return add_file(files, count, capacity, path);
+
+    DIR *dir = opendir(path);
+    if (!dir) {
+        fprintf(stderr, "l1decode: cannot open directory %s\n", path);
+        return -1;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        char child[4096];
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        if (stat(child, &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            collect_files(child, files, count, capacity);
+        } else {
+            size_t len = strlen(entry->d_name);
+            if (len > 4 && strcmp(entry->d_name + len - 4, ".txt") == 0) {
+                add_file(files, count, capacity, child);
+            }
+        }
+    }
+    closedir(dir);
+    return 0;
+}
+
+/*
+ * read_l1_base64
+ * Returns the base64 line that follows the marker in a sidecar, or NULL.
+ */
+static char* read_l1_base64(const char *filename) {
+    FILE *f = fopen(filename, "r");
+    if (!f) return NULL;
+
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    bool marker_seen = false;
+    char *result = NULL;
+    while ((n = getline(&line, &cap, f)) > 0) {
+        while (n > 0 && (line[n - 1] == '\n' || line[n - 1] == '\r')) line[--n] = '\0';
+        if (!marker_seen) {
+            marker_seen = strcmp(line, L1_BASE64_MARKER) == 0;
+        } else if (n > 0) {
+            result = strdup(line);
+            break;
+        }
+    }
+    free(line);
+    fclose(f);
+    return result;
+}
+
+static void print_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') fprintf(out, "\\%c", c);
+        else if (c < 0x20) fprintf(out, "\\u%04x", c);
+        else fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+static void print_csv_string(FILE *out, const char *s) {
+    if (!strpbrk(s, ",\"\n")) {
+        fputs(s, out);
+        return;
+    }
+    fputc('"', out);
+    for (; *s; s++) {
+        if (*s == '"') fputc('"', out);
+        fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+/*
+ * format_plps
+ * Writes one row (CSV) or one object (JSON) per PLP of a decoded blob.
+ */
+static void format_plps(FILE *out, const char *filename, const struct l1_decoded *d, enum output_format format) {
+    if (format == FORMAT_JSON) {
+        fprintf(out, "{\"file\":");
+        print_json_string(out, filename);
+        fprintf(out, ",\"l1b_version\":%d,\"l1d_version\":%d,\"num_subframes\":%d",
+                d->l1b.version, d->l1d_version, d->num_subframes);
+        if (d->l1d_version >= 1) fprintf(out, ",\"bsid\":%ld", d->bsid);
+        fprintf(out, ",\"frame_time_ms\":%.3f,\"plps\":[", d->frame_time_ms);
+    }
+
+    for (int p = 0; p < d->num_plps; p++) {
+        const struct l1d_plp *plp = &d->plps[p];
+        const struct l1d_subframe *sf = &d->subframes[plp->subframe];
+        const char *mod = plp->has_modcod ? mod_name_l1(plp->params.mod) : "";
+        const char *cod = plp->has_modcod ? cod_name_l1(plp->params.cod) : "";
+        int ldpc = plp_ldpc_length_l1(plp);
+        struct snr_pair_result snr = {0};
+        if (plp->has_modcod) snr = get_snr_pair_l1(plp->params.mod, plp->params.cod, ldpc);
+
+        if (format == FORMAT_CSV) {
+            print_csv_string(out, filename);
+            fprintf(out, ",%d,%d,%d,%s,%s,%s,%s,%d,%ld,%.2f,%.3f,",
+                    plp->subframe, p - sf->first_plp, plp->params.plp_id,
+                    plp->layer == 0 ? "core" : "enhanced", mod, cod,
+                    ldpc == 0 ? "16K" : ldpc == 1 ? "64K" : "",
+                    plp->params.ti_mode, plp->params.size, plp->fec_blocks, plp->bitrate / 1000000.0);
+            if (snr.found) fprintf(out, "%.2f,%.2f\n", snr.awgn_min, snr.rayleigh_min);
+            else fprintf(out, ",\n");
+        } else {
+            fprintf(out, "%s{\"subframe\":%d,\"plp_index\":%d,\"plp_id\":%d,\"layer\":\"%s\"",
+                    p > 0 ? "," : "", plp->subframe, p - sf->first_plp, plp->params.plp_id,
+                    plp->layer == 0 ? "core" : "enhanced");
+            if (plp->has_modcod) fprintf(out, ",\"mod\":\"%s\",\"cod\":\"%s\"", mod, cod);
+            if (ldpc >= 0) fprintf(out, ",\"ldpc\":\"%s\"", ldpc == 0 ? "16K" : "64K");
+            fprintf(out, ",\"ti_mode\":%d,\"size_cells\":%ld,\"fec_blocks\":%.2f,\"bitrate_mbps\":%.3f",
+                    plp->params.ti_mode, plp->params.size, plp->fec_blocks, plp->bitrate / 1000000.0);
+            if (snr.found) {
+                fprintf(out, ",\"snr_awgn_db\":%.2f,\"snr_rayleigh_db\":%.2f", snr.awgn_min, snr.rayleigh_min);
+            }
+            fprintf(out, "}");
+        }
+    }
+
+    if (format == FORMAT_JSON) fprintf(out, "]}\n");
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * decode_file
+ * Decodes one sidecar into result. Runs on a worker thread; everything it
+ * touches is private to the file being decoded.
+ */
+static void decode_file(const char *filename, enum output_format format, struct decode_result *result) {
+    char *b64 = read_l1_base64(filename);
+    if (!b64) {
+        fprintf(stderr, "l1decode: %s: no raw L1 detail found\n", filename);
+        return;
+    }
+
+    size_t decoded_len = b64_decoded_size_l1(b64);
+    unsigned char *data = decoded_len ? malloc(decoded_len) : NULL;
+    struct l1_decoded decoded = {0};
+
+    uint64_t t0 = now_ns();
+    bool valid = data && b64_decode_l1(b64, data, decoded_len);
+    uint64_t t1 = now_ns();
+    valid = valid && l1_decode(data, decoded_len, &decoded) == 0;
+    uint64_t t2 = now_ns();
+    result->b64_chars = strlen(b64);
+    result->b64_ns = t1 - t0;
+    result->decode_ns = t2 - t1;
+
+    if (valid) {
+        FILE *out = open_memstream(&result->text, &result->len);
+        if (out) {
+            format_plps(out, filename, &decoded, format);
+            fclose(out);
+            result->ok = true;
+        }
+        result->format_ns = now_ns() - t2;
+    } else {
+        fprintf(stderr, "l1decode: %s: invalid L1 detail\n", filename);
+    }
+    l1_decoded_free(&decoded);
+    free(data);
+    free(b64);
+}
+
+static void* decode_worker(void *arg) {
+    struct decode_batch *batch = (struct decode_batch *)arg;
+    int i;
+    while ((i = atomic_fetch_add(&batch->next, 1)) < batch->count) {
+        decode_file(batch->files[i], batch->format, &batch->results[i]);
+    }
+    return NULL;
+}
+
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options] <file|directory>...\n", program_name);
+    printf("\nDecodes the raw L1 detail saved in hdhomerun_tui .txt sidecars.\n");
+    printf("Directories are searched recursively for .txt files.\n");
+    printf("\nOptions:\n");
+    printf("  -f, --format <csv|json>  Output format (default csv; json is one object per file)\n");
+    printf("  -j, --jobs <n>           Worker threads (default: number of CPUs)\n");
+    printf("  -o, --output <file>      Write to file instead of stdout\n");
+    printf("  -t, --timing             Print time spent in each decode stage to stderr\n");
+    printf("  -h, --help               Show this help message\n");
+}
+
+int main(int argc, char *argv[]) {
+    enum output_format format = FORMAT_CSV;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *output = NULL;
+    bool timing = false;
+
+    static struct option long_options[] = {
+        {"format", required_argument, 0, 'f'},
+        {"jobs",   required_argument, 0, 'j'},
+        {"output", required_argument, 0, 'o'},
+        {"timing", no_argument,       0, 't'},
+        {"help",   no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "f:j:o:th", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'f':
+                if (strcmp(optarg, "csv") == 0) format = FORMAT_CSV;
+                else if (strcmp(optarg, "json") == 0) format = FORMAT_JSON;
+                else {
+                    fprintf(stderr, "Invalid format '%s'. Use csv or json.\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'j':
+                jobs = atol(optarg);
+                if (jobs < 1) {
+                    fprintf(stderr, "Invalid job count: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 't':
+                timing = true;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind >= argc) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (jobs < 1) jobs = 1;
+    if (jobs > L1DECODE_MAX_THREADS) jobs = L1DECODE_MAX_THREADS;
+
+    struct decode_batch batch = {0};
+    batch.format = format;
+    int capacity = 0;
+    for (int i = optind; i < argc; i++) {
+        collect_files(argv[i], &batch.files, &batch.count, &capacity);
+    }
+    if (batch.count == 0) {
+        fprintf(stderr, "l1decode: no input files\n");
+        return 1;
+    }
+    batch.results = calloc(batch.count, sizeof(struct decode_result));
+    if (!batch.results) return 1;
+    atomic_init(&batch.next, 0);
+
+    FILE *out = output ? fopen(output, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "l1decode: cannot open %s for writing\n", output);
+        return 1;
+    }
+
+    if (jobs > batch.count) jobs = batch.count;
+    pthread_t threads[L1DECODE_MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < jobs; t++) {
+        if (pthread_create(&threads[t], NULL, decode_worker, &batch) != 0) break;
+        started++;
+    }
+    if (started == 0) decode_worker(&batch);
+    for (int t = 0; t < started; t++) pthread_join(threads[t], NULL);
+
+    // Output keeps the input order regardless of which worker finished first
+    if (format == FORMAT_CSV) {
+        fprintf(out, "file,subframe,plp_index,plp_id,layer,mod,cod,ldpc,ti_mode,size_cells,fec_blocks,bitrate_mbps,snr_awgn_db,snr_rayleigh_db\n");
+    }
+    int failed = 0;
+    size_t b64_chars = 0;
+    uint64_t b64_ns = 0, decode_ns = 0, format_ns = 0;
+    for (int i = 0; i < batch.count; i++) {
+        if (batch.results[i].ok) fwrite(batch.results[i].text, 1, batch.results[i].len, out);
+        else failed++;
+        b64_chars += batch.results[i].b64_chars;
+        b64_ns += batch.results[i].b64_ns;
+        decode_ns += batch.results[i].decode_ns;
+        format_ns += batch.results[i].format_ns;
+        free(batch.results[i].text);
+        free(batch.files[i]);
+    }
+    if (out != stdout) fclose(out);
+
+    if (timing) {
+        // Stage times are summed over all workers
+        fprintf(stderr, "l1decode: %d files, %zu base64 chars\n", batch.count, b64_chars);
+        fprintf(stderr, "  base64:  %8.3f ms (%.1f MB/s)\n", b64_ns / 1e6,
+                b64_ns ? b64_chars / (b64_ns / 1e9) / 1e6 : 0.0);
+        fprintf(stderr, "  l1:      %8.3f ms\n", decode_ns / 1e6);
+        fprintf(stderr, "  format:  %8.3f ms\n", format_ns / 1e6);
+    }
+
+    free(batch.results);
+    free(batch.files);
+    return failed == batch.count ? 1 : 0;
+}
@@ -0,0 +1,420 @@
+/*
+ * metrics_export.c
+ *
+ * Tuner metrics export for headless operation
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include "metrics_export.h"
+
+#define METRICS_CLIENT_TIMEOUT_MS 1000  // A socket client slower than this is dropped
+
+struct metrics_buffer {
+    char *data;
+    size_t len;
+    size_t cap;
+};
+
+struct metrics_sink {
+    enum metrics_format format;
+    char path[256];
+    bool is_stdout;
+    int listen_fd;              // >= 0 when serving a UNIX socket
+    struct metrics_buffer buf;  // Latest formatted sample
+};
+
+static void buf_appendf(struct metrics_buffer *b, const char *fmt, ...) {
+    va_list args;
+    for (;;) {
+        size_t avail = b->cap - b->len;
+        va_start(args, fmt);
+        int n = vsnprintf(b->data ? b->data + b->len : NULL, avail, fmt, args);
+        va_end(args);
+        if (n < 0) return;
+        if ((size_t)n < avail) { b->len += n; return; }
+
+        size_t new_cap = b->cap ? b->cap * 2 : 4096;
+        while (new_cap - b->len <= (size_t)n) new_cap *= 2;
+        char *grown = realloc(b->data, new_cap);
+        if (!grown) return;
+        b->data = grown;
+        b->cap = new_cap;
+    }
+}
+
+static void buf_append_json_string(struct metrics_buffer *b, const char *s) {
+    buf_appendf(b, "\"");
+    for (; s && *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') buf_appendf(b, "\\%c", c);
+        else if (c == '\n') buf_appendf(b, "\\n");
+        else if (c < 0x20) buf_appendf(b, "\\u%04x", c);
+        else buf_appendf(b, "%c", c);
+    }
+    buf_appendf(b, "\"");
+}
+
+/*
+ * copy_line_token
+ * Copies the value of "key=" within one plpinfo line (up to the next space).
+ */
+static void copy_line_token(const char *line, const char *eol, const char *key, char *out, size_t out_size) {
+    out[0] = '\0';
+    const char *found = strstr(line, key);
+    if (!found || (eol && found > eol)) return;
+    found += strlen(key);
+    size_t n = 0;
+    while (found[n] && found[n] != ' ' && found[n] != '\n' && n < out_size - 1) n++;
+    memcpy(out, found, n);
+    out[n] = '\0';
+}
+
+struct plp_fields {
+    int id;
+    int lock;
+    char mod[16];
+    char cod[8];
+};
+
+/*
+ * parse_plps
+ * Walks the PLP lines of a plpinfo reply, skipping the "bsid=" header.
+ */
+static int parse_plps(const char *plpinfo, struct plp_fields *plps, int max_plps) {
+    int count = 0;
+    const char *line = plpinfo;
+    while (line && *line && count < max_plps) {
+        const char *eol = strchr(line, '\n');
+        if (isdigit((unsigned char)*line)) {
+            struct plp_fields *plp = &plps[count++];
+            char lock_str[8];
+            plp->id = atoi(line);
+            copy_line_token(line, eol, "lock=", lock_str, sizeof(lock_str));
+            plp->lock = lock_str[0] ? atoi(lock_str) : -1;
+            copy_line_token(line, eol, "mod=", plp->mod, sizeof(plp->mod));
+            copy_line_token(line, eol, "cod=", plp->cod, sizeof(plp->cod));
+        }
+        line = eol ? eol + 1 : NULL;
+    }
+    return count;
+}
+
+/*
+ * plp_snr
+ * Required SNR for a PLP, looked up by the decoded L1's modulation, code
+ * rate and LDPC length. Without decoded L1 (no -l) the plpinfo names are
+ * mapped to the same enums and the LDPC length is left unknown.
+ */
+static struct snr_pair_result plp_snr(const struct l1_decoded *d, const struct plp_fields *plp) {
+    for (int p = 0; d && p < d->num_plps; p++) {
+        const struct l1d_plp *l1 = &d->plps[p];
+        if (l1->params.plp_id == plp->id && l1->has_modcod) {
+            return get_snr_pair_l1(l1->params.mod, l1->params.cod, plp_ldpc_length_l1(l1));
+        }
+    }
+    return get_snr_pair_l1(mod_from_name_l1(plp->mod, strlen(plp->mod)), cod_from_name_l1(plp->cod, strlen(plp->cod)), -1);
+}
+
+static void format_json(struct metrics_buffer *b, const struct metrics_tuner_info *info, time_t now) {
+    const struct tuner_status_snapshot *snap = info->snap;
+
+    buf_appendf(b, "{\"time\":%ld,\"device\":\"%08X\",\"tuner\":%d,\"ip\":", (long)now, info->device_id, info->tuner_index);
+    buf_append_json_string(b, info->ip_str);
+    if (!snap || !snap->valid) {
+        buf_appendf(b, ",\"online\":false}\n");
+        return;
+    }
+
+    long bps = snap->fields.value[STATUS_KEY_BPS];
+    long pps = snap->fields.value[STATUS_KEY_PPS];
+    long ss_dbm = snap->fields.db[STATUS_KEY_SS];
+    long snq_db = snap->fields.db[STATUS_KEY_SNQ];
+    bool is_atsc3 = strstr(snap->status.lock_str, "atsc3") != NULL;
+
+    buf_appendf(b, ",\"online\":true,\"channel\":");
+    buf_append_json_string(b, snap->status.channel);
+    buf_appendf(b, ",\"lock\":");
+    buf_append_json_string(b, snap->status.lock_str);
+    buf_appendf(b, ",\"ss\":%u,\"snq\":%u,\"seq\":%u", snap->status.signal_strength,
+                snap->status.signal_to_noise_quality, snap->status.symbol_error_quality);
+    if (ss_dbm != -999) buf_appendf(b, ",\"ss_dbm\":%ld", ss_dbm);
+    if (snq_db != -999) buf_appendf(b, ",\"snq_db\":%ld", snq_db);
+    buf_appendf(b, ",\"bps\":%ld,\"pps\":%ld", bps != -999 ? bps : 0, pps != -999 ? pps : 0);
+
+    if (snap->has_streaminfo) {
+        long tsid = snap->fields.value[STATUS_KEY_TSID];
+        if (tsid != -999) buf_appendf(b, ",\"tsid\":%ld", tsid);
+    }
+    if (is_atsc3 && snap->has_plpinfo) {
+        long bsid = snap->fields.value[STATUS_KEY_BSID];
+        if (bsid != -999) buf_appendf(b, ",\"bsid\":%ld", bsid);
+
+        struct plp_fields plps[MAX_PLPS];
+        int plp_count = parse_plps(snap->plpinfo, plps, MAX_PLPS);
+        buf_appendf(b, ",\"plps\":[");
+        for (int i = 0; i < plp_count; i++) {
+            buf_appendf(b, "%s{\"id\":%d,\"lock\":%d,\"mod\":", i ? "," : "", plps[i].id, plps[i].lock);
+            buf_append_json_string(b, plps[i].mod);
+            buf_appendf(b, ",\"cod\":");
+            buf_append_json_string(b, plps[i].cod);
+
+            struct snr_pair_result snr = plp_snr(info->l1 ? l1_tracker_decoded(info->l1) : NULL, &plps[i]);
+            if (snr.found) {
+                buf_appendf(b, ",\"snr_awgn_db\":[%.2f,%.2f]", snr.awgn_min, snr.awgn_max);
+            }
+            buf_appendf(b, "}");
+        }
+        buf_appendf(b, "]");
+    }
+
+    if (info->l1) {
+        buf_appendf(b, ",\"l1_changes\":%u", l1_tracker_change_count(info->l1));
+        if (l1_tracker_change_count(info->l1) > 0) {
+            buf_appendf(b, ",\"l1_changed_at\":%ld", (long)l1_tracker_last_change(info->l1));
+        }
+
+        const struct l1_decoded *d = l1_tracker_decoded(info->l1);
+        if (d && d->num_plps > 0) {
+            buf_appendf(b, ",\"frame_time_ms\":%.3f,\"capacity\":[", d->frame_time_ms);
+            for (int p = 0; p < d->num_plps; p++) {
+                const struct l1d_plp *plp = &d->plps[p];
+                buf_appendf(b, "%s{\"subframe\":%d,\"plp_id\":%d,\"cells\":%ld,\"fec_blocks\":%.2f,\"mbps\":%.3f}",
+                            p ? "," : "", plp->subframe, plp->params.plp_id, plp->params.size,
+                            plp->fec_blocks, plp->bitrate / 1000000.0);
+            }
+            buf_appendf(b, "]");
+        }
+    }
+    if (info->details) {
+        buf_appendf(b, ",\"details\":[");
+        for (int i = 0; i < info->details->line_count; i++) {
+            if (i) buf_appendf(b, ",");
+            buf_append_json_string(b, info->details->display_lines[i]);
+        }
+        buf_appendf(b, "]");
+    }
+    buf_appendf(b, "}\n");
+}
+
+/*
+ * format_prometheus
+ * Emits one metric family at a time across all tuners, as the exposition
+ * format requires HELP/TYPE to appear once per family.
+ */
+static void format_prometheus(struct metrics_buffer *b, const struct metrics_tuner_info infos[], int count) {
+    static const struct {
+        const char *name;
+        const char *help;
+    } families[] = {
+        {"hdhomerun_tuner_up", "1 if the tuner answered the last status poll"},
+        {"hdhomerun_tuner_locked", "1 if the tuner reports a demodulator lock"},
+        {"hdhomerun_signal_strength_percent", "Signal strength (ss)"},
+        {"hdhomerun_signal_quality_percent", "Signal to noise quality (snq)"},
+        {"hdhomerun_symbol_quality_percent", "Symbol error quality (seq)"},
+        {"hdhomerun_signal_strength_dbm", "Signal strength in dBm, when reported"},
+        {"hdhomerun_signal_quality_db", "Signal to noise ratio in dB, when reported"},
+        {"hdhomerun_network_bits_per_second", "Network stream rate (bps)"},
+        {"hdhomerun_plp_locked", "1 if the ATSC 3.0 PLP is locked"},
+    };
+
+    for (size_t f = 0; f < sizeof(families) / sizeof(families[0]); f++) {
+        buf_appendf(b, "# HELP %s %s\n# TYPE %s gauge\n", families[f].name, families[f].help, families[f].name);
+
+        for (int i = 0; i < count; i++) {
+            const struct tuner_status_snapshot *snap = infos[i].snap;
+            bool up = snap && snap->valid;
+            char labels[64];
+            snprintf(labels, sizeof(labels), "device=\"%08X\",tuner=\"%d\"", infos[i].device_id, infos[i].tuner_index);
+
+            if (f == 0) { buf_appendf(b, "%s{%s} %d\n", families[f].name, labels, up ? 1 : 0); continue; }
+            if (!up) continue;
+
+            switch (f) {
+                case 1: buf_appendf(b, "%s{%s} %d\n", families[f].name, labels, strstr(snap->status.lock_str, "none") == NULL); break;
+                case 2: buf_appendf(b, "%s{%s} %u\n", families[f].name, labels, snap->status.signal_strength); break;
+                case 3: buf_appendf(b, "%s{%s} %u\n", families[f].name, labels, snap->status.signal_to_noise_quality); break;
+                case 4: buf_appendf(b, "%s{%s} %u\n", families[f].name, labels, snap->status.symbol_error_quality); break;
+                case 5: {
+                    long v = snap->fields.db[STATUS_KEY_SS];
+                    if (v != -999) buf_appendf(b, "%s{%s} %ld\n", families[f].name, labels, v);
+                    break;
+                }
+                case 6: {
+                    long v = snap->fields.db[STATUS_KEY_SNQ];
+                    if (v != -999) buf_appendf(b, "%s{%s} %ld\n", families[f].name, labels, v);
+                    break;
+                }
+                case 7: {
+                    long v = snap->fields.value[STATUS_KEY_BPS];
+                    buf_appendf(b, "%s{%s} %ld\n", families[f].name, labels, v != -999 ? v : 0);
+                    break;
+                }
+                case 8:
+                    if (snap->has_plpinfo) {
+                        struct plp_fields plps[MAX_PLPS];
+                        int plp_count = parse_plps(snap->plpinfo, plps, MAX_PLPS);
+                        for (int p = 0; p < plp_count; p++) {
+                            buf_appendf(b, "%s{%s,plp=\"%d\"} %d\n", families[f].name, labels, plps[p].id, plps[p].lock == 1);
+                        }
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+struct metrics_sink* metrics_sink_open(const char *target, enum metrics_format format) {
+    struct metrics_sink *sink = calloc(1, sizeof(struct metrics_sink));
+    if (!sink) return NULL;
+    sink->format = format;
+    sink->listen_fd = -1;
+
+    if (!target || strcmp(target, "-") == 0) {
+        sink->is_stdout = true;
+        return sink;
+    }
+
+    if (strncmp(target, "unix:", 5) == 0) {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, target + 5, sizeof(addr.sun_path) - 1);
+        strncpy(sink->path, addr.sun_path, sizeof(sink->path) - 1);
+
+        sink->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (sink->listen_fd < 0) { free(sink); return NULL; }
+        unlink(addr.sun_path);
+        if (bind(sink->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(sink->listen_fd, 8) < 0) {
+            close(sink->listen_fd);
+            free(sink);
+            return NULL;
+        }
+        return sink;
+    }
+
+    strncpy(sink->path, target, sizeof(sink->path) - 1);
+    return sink;
+}
+
+void metrics_sink_close(struct metrics_sink *sink) {
+    if (!sink) return;
+    if (sink->listen_fd >= 0) {
+        close(sink->listen_fd);
+        unlink(sink->path);
+    }
+    free(sink->buf.data);
+    free(sink);
+}
+
+static int write_file_atomically(const char *path, const char *data, size_t len) {
+    char tmp_path[300];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *f = fopen(tmp_path, "w");
+    if (!f) return -1;
+    size_t written = fwrite(data, 1, len, f);
+    if (fclose(f) != 0 || written != len) { remove(tmp_path); return -1; }
+    return rename(tmp_path, path);
+}
+
+int metrics_sink_publish(struct metrics_sink *sink, const struct metrics_tuner_info infos[], int count) {
+    if (!sink) return -1;
+
+    sink->buf.len = 0;
+    if (sink->format == METRICS_FORMAT_PROMETHEUS) {
+        format_prometheus(&sink->buf, infos, count);
+    } else {
+        time_t now = time(NULL);
+        for (int i = 0; i < count; i++) format_json(&sink->buf, &infos[i], now);
+    }
+    if (!sink->buf.data) return -1;
+
+    if (sink->is_stdout) {
+        fwrite(sink->buf.data, 1, sink->buf.len, stdout);
+        fflush(stdout);
+        return 0;
+    }
+    if (sink->listen_fd >= 0) {
+        return 0; // Served on demand from metrics_sink_wait
+    }
+    if (sink->format == METRICS_FORMAT_PROMETHEUS) {
+        return write_file_atomically(sink->path, sink->buf.data, sink->buf.len);
+    }
+
+    FILE *f = fopen(sink->path, "a");
+    if (!f) return -1;
+    fwrite(sink->buf.data, 1, sink->buf.len, f);
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/*
+ * send_to_client
+ * Writes a sample to a socket client, giving up if the client stops
+ * reading, so one stalled reader can't hold up the next sample.
+ */
+static void send_to_client(int client, const char *data, size_t len) {
+    struct timeval timeout = { METRICS_CLIENT_TIMEOUT_MS / 1000, (METRICS_CLIENT_TIMEOUT_MS % 1000) * 1000 };
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    size_t off = 0;
+    while (data && off < len) {
+        ssize_t n = send(client, data + off, len - off, MSG_NOSIGNAL);
+        if (n <= 0) return; // Timed out or gone
+        off += n;
+
+        // A client draining a byte at a time still has to finish in time
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long elapsed = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000;
+        if (elapsed >= METRICS_CLIENT_TIMEOUT_MS) return;
+    }
+}
+
+void metrics_sink_wait(struct metrics_sink *sink, int timeout_ms) {
+    if (!sink || sink->listen_fd < 0) {
+        // A signal (e.g. SIGINT) cuts the sleep short so shutdown is prompt
+        struct timespec ts = { timeout_ms / 1000, (timeout_ms % 1000) * 1000000L };
+        nanosleep(&ts, NULL);
+        return;
+    }
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long elapsed = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000;
+        if (elapsed >= timeout_ms) return;
+
+        struct pollfd pfd = { sink->listen_fd, POLLIN, 0 };
+        if (poll(&pfd, 1, timeout_ms - elapsed) <= 0) return; // Timeout or signal
+
+        int client = accept(sink->listen_fd, NULL, NULL);
+        if (client < 0) continue;
+        send_to_client(client, sink->buf.data, sink->buf.len);
+        close(client);
+    }
+}
+
+bool metrics_parse_format(const char *name, enum metrics_format *out) {
+    if (strcasecmp(name, "json") == 0) { *out = METRICS_FORMAT_JSON; return true; }
+    if (strcasecmp(name, "prom") == 0 || strcasecmp(name, "prometheus") == 0) { *out = METRICS_FORMAT_PROMETHEUS; return true; }
+    return false;
+}
@@ -0,0 +1,54 @@
+/*
+ * metrics_export.h
+ *
+ * Tuner metrics export for headless operation
+ * Formats status snapshots as line-delimited JSON or Prometheus text and
+ * publishes them to stdout, a file, or a local (UNIX domain) socket.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef METRICS_EXPORT_H
+#define METRICS_EXPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "status_poller.h"
+#include "l1_detail_parser.h"
+
+enum metrics_format {
+    METRICS_FORMAT_JSON,        // One JSON object per tuner per line
+    METRICS_FORMAT_PROMETHEUS,  // Prometheus text exposition format
+};
+
+struct metrics_tuner_info {
+    uint32_t device_id;
+    int tuner_index;
+    const char *ip_str;
+    const struct tuner_status_snapshot *snap;
+    const struct l1_detail_info *details;  // Optional, from collect_atsc3_details
+    const struct l1_tracker *l1;           // Optional, adds L1 change counts
+};
+
+struct metrics_sink;
+
+// target is "-" for stdout, "unix:/path" for a local socket, or a file path.
+// JSON is appended to files; Prometheus files are replaced atomically so a
+// node_exporter textfile collector never sees a partial write.
+struct metrics_sink* metrics_sink_open(const char *target, enum metrics_format format);
+void metrics_sink_close(struct metrics_sink *sink);
+
+// Formats and writes one sample of every tuner. Returns 0 on success.
+int metrics_sink_publish(struct metrics_sink *sink, const struct metrics_tuner_info infos[], int count);
+
+// Sleeps up to timeout_ms, answering socket clients with the latest sample.
+void metrics_sink_wait(struct metrics_sink *sink, int timeout_ms);
+
+bool metrics_parse_format(const char *name, enum metrics_format *out);
+
+#endif // METRICS_EXPORT_H
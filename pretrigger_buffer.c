@@ -0,0 +1,309 @@
+/*
+ * pretrigger_buffer.c
+ *
+ * In-memory pre-trigger buffer for autorestart captures
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include "pretrigger_buffer.h"
+
+#define PRETRIGGER_BLOCK_SIZE (256 * 1024)
+
+#define TS_PACKET_SIZE 188
+#define TS_SYNC_BYTE 0x47
+#define PCAP_GLOBAL_HEADER_SIZE 24
+#define PCAP_RECORD_HEADER_SIZE 16
+#define PCAP_MAX_RECORD (1024 * 1024)   // Anything larger means the framing was lost
+
+// Stream data is kept in fixed-size blocks stamped with the time of their
+// last write; whole blocks age out, and are recycled rather than freed.
+struct pretrigger_block {
+    struct pretrigger_block *next;
+    size_t used;
+    long last_ms;
+    uint64_t start;                 // Stream offset of data[0]
+    long first_record;              // PCAP: offset in data of the first record header, -1 if none
+    uint8_t data[PRETRIGGER_BLOCK_SIZE];
+};
+
+struct pretrigger_buffer {
+    long window_ms;
+    size_t total;
+    bool triggered;                 // Stop ageing out; the clip is being finished
+    enum pretrigger_format format;
+    uint64_t appended;              // Stream bytes since the last reset
+    struct pretrigger_block *head;  // Oldest
+    struct pretrigger_block *tail;  // Being filled
+    struct pretrigger_block *spare; // Recycled blocks
+
+    // PCAP framing, followed as data arrives
+    uint8_t pcap_header[PCAP_GLOBAL_HEADER_SIZE];
+    bool pcap_header_read;          // Global header has arrived and been checked
+    bool pcap_valid;                // Header seen and records still in step
+    bool pcap_swapped;              // Header written on an opposite-endian host
+    uint64_t pcap_record;           // Offset of the newest record header
+    uint64_t pcap_next;             // Offset where the record after it starts
+};
+
+static long monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+static void free_list(struct pretrigger_block *block) {
+    while (block) {
+        struct pretrigger_block *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+struct pretrigger_buffer* pretrigger_buffer_create(int seconds, enum pretrigger_format format) {
+    if (seconds <= 0) return NULL;
+    struct pretrigger_buffer *pb = calloc(1, sizeof(struct pretrigger_buffer));
+    if (!pb) return NULL;
+    pb->window_ms = seconds * 1000L;
+    pb->format = format;
+    return pb;
+}
+
+void pretrigger_buffer_destroy(struct pretrigger_buffer *pb) {
+    if (!pb) return;
+    free_list(pb->head);
+    free_list(pb->spare);
+    free(pb);
+}
+
+void pretrigger_buffer_reset(struct pretrigger_buffer *pb) {
+    if (!pb) return;
+    if (pb->tail) {
+        pb->tail->next = pb->spare;
+        pb->spare = pb->head;
+    }
+    pb->head = pb->tail = NULL;
+    pb->total = 0;
+    pb->appended = 0;
+    pb->triggered = false;
+    pb->pcap_header_read = false;
+    pb->pcap_valid = false;
+    pb->pcap_record = pb->pcap_next = 0;
+}
+
+void pretrigger_buffer_trigger(struct pretrigger_buffer *pb) {
+    if (pb) pb->triggered = true;
+}
+
+size_t pretrigger_buffer_size(struct pretrigger_buffer *pb) {
+    return pb ? pb->total : 0;
+}
+
+/*
+ * retire_head
+ * Moves the oldest block to the spare list.
+ */
+static void retire_head(struct pretrigger_buffer *pb) {
+    struct pretrigger_block *old = pb->head;
+    pb->head = old->next;
+    pb->total -= old->used;
+    old->next = pb->spare;
+    pb->spare = old;
+}
+
+static struct pretrigger_block* new_block(struct pretrigger_buffer *pb) {
+    struct pretrigger_block *block = pb->spare;
+    if (block) {
+        pb->spare = block->next;
+    } else {
+        block = malloc(sizeof(struct pretrigger_block));
+        if (!block) return NULL;
+    }
+    block->next = NULL;
+    block->used = 0;
+    block->start = pb->appended;
+    block->first_record = -1;
+    return block;
+}
+
+/*
+ * find_block
+ * Block holding stream offset pos, checking the one being filled first.
+ */
+static struct pretrigger_block* find_block(struct pretrigger_buffer *pb, uint64_t pos) {
+    struct pretrigger_block *tail = pb->tail;
+    if (tail && pos >= tail->start && pos < tail->start + tail->used) return tail;
+    for (struct pretrigger_block *block = pb->head; block; block = block->next) {
+        if (pos >= block->start && pos < block->start + block->used) return block;
+    }
+    return NULL;
+}
+
+// Copies stream bytes [pos, pos + len) out of the blocks
+static bool read_bytes(struct pretrigger_buffer *pb, uint64_t pos, uint8_t *out, size_t len) {
+    while (len > 0) {
+        struct pretrigger_block *block = find_block(pb, pos);
+        if (!block) return false;
+        size_t offset = (size_t)(pos - block->start);
+        size_t n = block->used - offset;
+        if (n > len) n = len;
+        memcpy(out, block->data + offset, n);
+        out += n;
+        pos += n;
+        len -= n;
+    }
+    return true;
+}
+
+static uint32_t pcap_u32(struct pretrigger_buffer *pb, const uint8_t *p) {
+    if (pb->pcap_swapped) return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+    return (uint32_t)p[3] << 24 | (uint32_t)p[2] << 16 | (uint32_t)p[1] << 8 | p[0];
+}
+
+/*
+ * track_pcap
+ * Walks the record headers that have arrived, noting in each block where
+ * its first record starts so a clip can begin on a record boundary.
+ */
+static void track_pcap(struct pretrigger_buffer *pb) {
+    if (!pb->pcap_header_read) {
+        // The header may have come in over several appends; read it whole
+        // once all of it is buffered
+        if (pb->appended < PCAP_GLOBAL_HEADER_SIZE) return;
+        pb->pcap_header_read = true;
+        if (!read_bytes(pb, 0, pb->pcap_header, PCAP_GLOBAL_HEADER_SIZE)) {
+            pb->pcap_valid = false;
+            return;
+        }
+
+        uint32_t magic = (uint32_t)pb->pcap_header[3] << 24 | (uint32_t)pb->pcap_header[2] << 16 |
+                         (uint32_t)pb->pcap_header[1] << 8 | pb->pcap_header[0];
+        pb->pcap_valid = true;
+        if (magic == 0xA1B2C3D4 || magic == 0xA1B23C4D) pb->pcap_swapped = false;
+        else if (magic == 0xD4C3B2A1 || magic == 0x4D3CB2A1) pb->pcap_swapped = true;
+        else pb->pcap_valid = false;
+        pb->pcap_record = pb->pcap_next = PCAP_GLOBAL_HEADER_SIZE;
+    }
+
+    while (pb->pcap_valid && pb->pcap_next + PCAP_RECORD_HEADER_SIZE <= pb->appended) {
+        uint8_t header[PCAP_RECORD_HEADER_SIZE];
+        struct pretrigger_block *block = find_block(pb, pb->pcap_next);
+        if (!block || !read_bytes(pb, pb->pcap_next, header, sizeof(header))) {
+            pb->pcap_valid = false;
+            break;
+        }
+        uint32_t incl_len = pcap_u32(pb, header + 8);
+        if (incl_len > PCAP_MAX_RECORD) {
+            pb->pcap_valid = false;
+            break;
+        }
+        if (block->first_record < 0) block->first_record = (long)(pb->pcap_next - block->start);
+        pb->pcap_record = pb->pcap_next;
+        pb->pcap_next += PCAP_RECORD_HEADER_SIZE + incl_len;
+    }
+}
+
+void pretrigger_buffer_append(struct pretrigger_buffer *pb, const void *data, size_t len) {
+    if (!pb || len == 0) return;
+    long now = monotonic_ms();
+    const uint8_t *src = (const uint8_t *)data;
+
+    while (len > 0) {
+        if (!pb->tail || pb->tail->used == PRETRIGGER_BLOCK_SIZE) {
+            struct pretrigger_block *block = new_block(pb);
+            if (!block) return;
+            if (pb->tail) pb->tail->next = block;
+            else pb->head = block;
+            pb->tail = block;
+        }
+        size_t n = PRETRIGGER_BLOCK_SIZE - pb->tail->used;
+        if (n > len) n = len;
+        memcpy(pb->tail->data + pb->tail->used, src, n);
+        pb->tail->used += n;
+        pb->tail->last_ms = now;
+        pb->total += n;
+        pb->appended += n;
+        src += n;
+        len -= n;
+    }
+
+    if (pb->format == PRETRIGGER_PCAP) track_pcap(pb);
+
+    // Age out whole blocks, always keeping the one being filled. Once
+    // triggered, only the size cap applies so the lead-up is kept.
+    while (pb->head != pb->tail &&
+           ((!pb->triggered && now - pb->head->last_ms > pb->window_ms) || pb->total > PRETRIGGER_MAX_BYTES)) {
+        retire_head(pb);
+    }
+}
+
+// Writes stream bytes [start, end) to f
+static long write_range(struct pretrigger_buffer *pb, FILE *f, uint64_t start, uint64_t end) {
+    long written = 0;
+    for (struct pretrigger_block *block = pb->head; block && start < end; block = block->next) {
+        uint64_t block_end = block->start + block->used;
+        if (block_end <= start) continue;
+        size_t offset = (size_t)(start - block->start);
+        size_t n = (size_t)((end < block_end ? end : block_end) - start);
+        written += fwrite(block->data + offset, 1, n, f);
+        start += n;
+    }
+    return written;
+}
+
+/*
+ * find_ts_start
+ * First offset holding a sync byte that the next packet's sync byte
+ * confirms (or that is the last packet buffered). Returns false if none.
+ */
+static bool find_ts_start(struct pretrigger_buffer *pb, uint64_t *start) {
+    uint64_t end = pb->appended;
+    for (uint64_t pos = pb->head->start; pos + TS_PACKET_SIZE <= end; pos++) {
+        uint8_t sync;
+        if (!read_bytes(pb, pos, &sync, 1) || sync != TS_SYNC_BYTE) continue;
+        if (pos + 2 * TS_PACKET_SIZE <= end) {
+            if (!read_bytes(pb, pos + TS_PACKET_SIZE, &sync, 1) || sync != TS_SYNC_BYTE) continue;
+        }
+        *start = pos;
+        return true;
+    }
+    return false;
+}
+
+long pretrigger_buffer_save(struct pretrigger_buffer *pb, const char *filename) {
+    if (!pb || pb->total == 0) return -1;
+
+    uint64_t start = pb->head->start;
+    uint64_t end = pb->appended;
+    if (pb->format == PRETRIGGER_TS) {
+        if (!find_ts_start(pb, &start)) return -1;
+        end = start + (end - start) / TS_PACKET_SIZE * TS_PACKET_SIZE;
+    } else if (pb->format == PRETRIGGER_PCAP) {
+        if (!pb->pcap_valid) return -1;
+        struct pretrigger_block *block = pb->head;
+        while (block && block->first_record < 0) block = block->next;
+        if (!block) return -1;
+        start = block->start + block->first_record;
+        // Leave off the newest record if it hasn't fully arrived
+        end = pb->pcap_next <= pb->appended ? pb->pcap_next : pb->pcap_record;
+        if (start >= end) return -1;
+    }
+
+    FILE *f = fopen(filename, "wb");
+    if (!f) return -1;
+    long written = 0;
+    if (pb->format == PRETRIGGER_PCAP) written += fwrite(pb->pcap_header, 1, PCAP_GLOBAL_HEADER_SIZE, f);
+    written += write_range(pb, f, start, end);
+    if (fclose(f) != 0) return -1;
+    return written;
+}
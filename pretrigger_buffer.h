@@ -0,0 +1,57 @@
+/*
+ * pretrigger_buffer.h
+ *
+ * In-memory pre-trigger buffer for autorestart captures
+ * Holds the most recent N seconds of stream so that, when an error makes
+ * an autorestart capture start over, the data leading up to the error can
+ * be written out as a short event clip instead of being discarded.
+ * Clips start on a packet (TS) or record (PCAP) boundary, so they open in
+ * the usual tools, and can run on for a few seconds past the trigger.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef PRETRIGGER_BUFFER_H
+#define PRETRIGGER_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PRETRIGGER_MAX_BYTES (256 * 1024 * 1024) // Hard cap regardless of bitrate
+
+// How the stream is framed, so a clip can start on a boundary
+enum pretrigger_format {
+    PRETRIGGER_RAW,             // e.g. ATSC 3.0 .dbg; saved as buffered
+    PRETRIGGER_TS,              // 188-byte packets starting with 0x47
+    PRETRIGGER_PCAP,            // pcap global header, then records
+};
+
+struct pretrigger_buffer;
+
+struct pretrigger_buffer* pretrigger_buffer_create(int seconds, enum pretrigger_format format);
+void pretrigger_buffer_destroy(struct pretrigger_buffer *pb);
+
+// Appends stream data, dropping whatever is older than the window.
+void pretrigger_buffer_append(struct pretrigger_buffer *pb, const void *data, size_t len);
+
+// Forgets everything buffered so far, e.g. when a capture restarts.
+// The next append is treated as the start of a new stream.
+void pretrigger_buffer_reset(struct pretrigger_buffer *pb);
+
+// Marks the trigger: the pre-trigger window stops ageing out, so data
+// appended afterwards (the post-trigger part) extends the clip.
+void pretrigger_buffer_trigger(struct pretrigger_buffer *pb);
+
+size_t pretrigger_buffer_size(struct pretrigger_buffer *pb);
+
+// Writes the buffered window to filename: TS from the first whole packet,
+// PCAP as the stream's global header plus every complete record still
+// buffered. Returns bytes written, or -1 if there was nothing usable.
+long pretrigger_buffer_save(struct pretrigger_buffer *pb, const char *filename);
+
+#endif // PRETRIGGER_BUFFER_H
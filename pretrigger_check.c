@@ -0,0 +1,128 @@
+/*
+ * pretrigger_check.c
+ *
+ * Checks for the pre-trigger buffer's clip framing
+ * Feeds small synthetic TS and PCAP streams through the buffer in awkward
+ * chunk sizes and checks that the saved clip starts on a boundary. Built
+ * and run by "make check".
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pretrigger_buffer.h"
+
+#define CHECK_FILE "pretrigger_check.tmp"
+#define PCAP_RECORDS 8
+#define PCAP_PAYLOAD 100
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    printf("  %-48s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) failures++;
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// Little-endian pcap: global header, then PCAP_RECORDS records
+static size_t build_pcap(uint8_t *out) {
+    memset(out, 0, 24);
+    put_u32(out, 0xA1B2C3D4);
+    out[4] = 2;
+    out[6] = 4;
+    put_u32(out + 16, 65535);
+    put_u32(out + 20, 1);
+    size_t len = 24;
+    for (int r = 0; r < PCAP_RECORDS; r++) {
+        memset(out + len, 0, 16);
+        put_u32(out + len, (uint32_t)r);
+        put_u32(out + len + 8, PCAP_PAYLOAD);
+        put_u32(out + len + 12, PCAP_PAYLOAD);
+        memset(out + len + 16, 0xA0 + r, PCAP_PAYLOAD);
+        len += 16 + PCAP_PAYLOAD;
+    }
+    return len;
+}
+
+static long read_clip(uint8_t *out, size_t size) {
+    FILE *f = fopen(CHECK_FILE, "rb");
+    if (!f) return -1;
+    long n = (long)fread(out, 1, size, f);
+    fclose(f);
+    return n;
+}
+
+/*
+ * check_pcap_split
+ * Appends the stream as first_chunk bytes and then the rest, and checks
+ * that the whole stream comes back as the clip.
+ */
+static void check_pcap_split(size_t first_chunk, const char *what) {
+    uint8_t stream[24 + PCAP_RECORDS * (16 + PCAP_PAYLOAD)];
+    uint8_t clip[sizeof(stream)];
+    size_t len = build_pcap(stream);
+
+    struct pretrigger_buffer *pb = pretrigger_buffer_create(10, PRETRIGGER_PCAP);
+    pretrigger_buffer_append(pb, stream, first_chunk);
+    pretrigger_buffer_append(pb, stream + first_chunk, len - first_chunk);
+    long written = pretrigger_buffer_save(pb, CHECK_FILE);
+    pretrigger_buffer_destroy(pb);
+
+    check(written == (long)len && read_clip(clip, sizeof(clip)) == (long)len && memcmp(clip, stream, len) == 0, what);
+}
+
+static void check_pcap_partial_record(void) {
+    uint8_t stream[24 + PCAP_RECORDS * (16 + PCAP_PAYLOAD)];
+    size_t len = build_pcap(stream);
+
+    struct pretrigger_buffer *pb = pretrigger_buffer_create(10, PRETRIGGER_PCAP);
+    pretrigger_buffer_append(pb, stream, len - 10);
+    long written = pretrigger_buffer_save(pb, CHECK_FILE);
+    pretrigger_buffer_destroy(pb);
+
+    check(written == (long)(len - 16 - PCAP_PAYLOAD), "pcap: unfinished last record left off");
+}
+
+static void check_ts_misaligned(void) {
+    uint8_t stream[7 + 10 * 188 + 50];
+    uint8_t clip[sizeof(stream)];
+    memset(stream, 0x11, sizeof(stream));
+    for (int p = 0; p < 10; p++) stream[7 + p * 188] = 0x47;
+
+    struct pretrigger_buffer *pb = pretrigger_buffer_create(10, PRETRIGGER_TS);
+    pretrigger_buffer_append(pb, stream, 3);
+    pretrigger_buffer_append(pb, stream + 3, sizeof(stream) - 3);
+    long written = pretrigger_buffer_save(pb, CHECK_FILE);
+    pretrigger_buffer_destroy(pb);
+
+    check(written == 10 * 188 && read_clip(clip, sizeof(clip)) == 10 * 188 && clip[0] == 0x47,
+          "ts: clip starts on a packet, whole packets only");
+}
+
+int main(void) {
+    printf("pretrigger_check:\n");
+    check_pcap_split(24 + 16 + PCAP_PAYLOAD, "pcap: header and first record in one append");
+    check_pcap_split(10, "pcap: header split across appends (10 + rest)");
+    check_pcap_split(1, "pcap: header split across appends (1 + rest)");
+    check_pcap_partial_record();
+    check_ts_misaligned();
+    remove(CHECK_FILE);
+
+    printf("%s\n", failures ? "FAILED" : "All checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * query_cache.c
+ *
+ * Short-lived cache for HDHomeRun control queries
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "query_cache.h"
+
+enum query_kind {
+    QUERY_VAR,
+    QUERY_STATUS,
+    QUERY_STREAMINFO,
+    QUERY_PLPINFO,
+};
+
+struct query_cache_entry {
+    bool used;
+    uint32_t device_id;
+    unsigned int tuner;
+    char name[64];
+    long fetched_ms;
+    int result;
+    char *value;
+    bool has_status;
+    struct hdhomerun_tuner_status_t status;
+};
+
+struct query_cache {
+    int ttl_ms;
+    struct query_cache_entry entries[QUERY_CACHE_MAX_ENTRIES];
+};
+
+static long monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+static void clear_entry(struct query_cache_entry *entry) {
+    free(entry->value);
+    memset(entry, 0, sizeof(*entry));
+}
+
+struct query_cache* query_cache_create(int ttl_ms) {
+    struct query_cache *cache = calloc(1, sizeof(struct query_cache));
+    if (!cache) return NULL;
+    cache->ttl_ms = (ttl_ms > 0) ? ttl_ms : QUERY_CACHE_DEFAULT_TTL_MS;
+    return cache;
+}
+
+void query_cache_destroy(struct query_cache *cache) {
+    if (!cache) return;
+    query_cache_invalidate(cache);
+    free(cache);
+}
+
+void query_cache_invalidate(struct query_cache *cache) {
+    if (!cache) return;
+    for (int i = 0; i < QUERY_CACHE_MAX_ENTRIES; i++) {
+        clear_entry(&cache->entries[i]);
+    }
+}
+
+/*
+ * fetch_uncached
+ * Issues the real control query for a given kind.
+ */
+static int fetch_uncached(struct hdhomerun_device_t *hd, enum query_kind kind, const char *name,
+                          char **pvalue, struct hdhomerun_tuner_status_t *status) {
+    switch (kind) {
+        case QUERY_STATUS: return hdhomerun_device_get_tuner_status(hd, pvalue, status);
+        case QUERY_STREAMINFO: return hdhomerun_device_get_tuner_streaminfo(hd, pvalue);
+        case QUERY_PLPINFO: return hdhomerun_device_get_tuner_plpinfo(hd, pvalue);
+        default: return hdhomerun_device_get_var(hd, name, pvalue, NULL);
+    }
+}
+
+/*
+ * cached_query
+ * Looks up (device, tuner, variable) and only goes to the device when the
+ * entry is missing or older than the TTL. Communication errors (< 0) are
+ * never cached so the next caller retries.
+ */
+static int cached_query(struct query_cache *cache, struct hdhomerun_device_t *hd, enum query_kind kind,
+                        const char *name, char **pvalue, struct hdhomerun_tuner_status_t *status) {
+    if (!cache) return fetch_uncached(hd, kind, name, pvalue, status);
+
+    uint32_t device_id = hdhomerun_device_get_device_id(hd);
+    unsigned int tuner = hdhomerun_device_get_tuner(hd);
+    long now = monotonic_ms();
+
+    struct query_cache_entry *slot = NULL;
+    struct query_cache_entry *oldest = &cache->entries[0];
+    for (int i = 0; i < QUERY_CACHE_MAX_ENTRIES; i++) {
+        struct query_cache_entry *entry = &cache->entries[i];
+        if (!entry->used) {
+            if (!slot) slot = entry;
+            continue;
+        }
+        if (entry->device_id == device_id && entry->tuner == tuner && strcmp(entry->name, name) == 0) {
+            bool fresh = (now - entry->fetched_ms) < cache->ttl_ms;
+            if (fresh && (kind != QUERY_STATUS || entry->has_status || entry->result <= 0)) {
+                *pvalue = entry->value;
+                if (status && entry->has_status) *status = entry->status;
+                return entry->result;
+            }
+            slot = entry;
+            break;
+        }
+        if (entry->fetched_ms < oldest->fetched_ms) oldest = entry;
+    }
+    if (!slot) slot = oldest;
+
+    char *reply = NULL;
+    struct hdhomerun_tuner_status_t reply_status;
+    memset(&reply_status, 0, sizeof(reply_status));
+    int result = fetch_uncached(hd, kind, name, &reply, &reply_status);
+
+    clear_entry(slot);
+    if (result < 0) {
+        *pvalue = reply;
+        if (status) *status = reply_status;
+        return result;
+    }
+
+    slot->used = true;
+    slot->device_id = device_id;
+    slot->tuner = tuner;
+    strncpy(slot->name, name, sizeof(slot->name) - 1);
+    slot->fetched_ms = now;
+    slot->result = result;
+    slot->value = strdup(reply ? reply : "");
+    slot->has_status = (kind == QUERY_STATUS && result > 0);
+    slot->status = reply_status;
+
+    *pvalue = slot->value;
+    if (status) *status = reply_status;
+    return result;
+}
+
+int query_cache_get_var(struct query_cache *cache, struct hdhomerun_device_t *hd, const char *name, char **pvalue) {
+    return cached_query(cache, hd, QUERY_VAR, name, pvalue, NULL);
+}
+
+int query_cache_get_tuner_status(struct query_cache *cache, struct hdhomerun_device_t *hd, char **pstatus_str, struct hdhomerun_tuner_status_t *status) {
+    char name[32];
+    snprintf(name, sizeof(name), "/tuner%u/status", hdhomerun_device_get_tuner(hd));
+    return cached_query(cache, hd, QUERY_STATUS, name, pstatus_str, status);
+}
+
+int query_cache_get_tuner_streaminfo(struct query_cache *cache, struct hdhomerun_device_t *hd, char **pstreaminfo) {
+    char name[32];
+    snprintf(name, sizeof(name), "/tuner%u/streaminfo", hdhomerun_device_get_tuner(hd));
+    return cached_query(cache, hd, QUERY_STREAMINFO, name, pstreaminfo, NULL);
+}
+
+int query_cache_get_tuner_plpinfo(struct query_cache *cache, struct hdhomerun_device_t *hd, char **pplpinfo) {
+    char name[32];
+    snprintf(name, sizeof(name), "/tuner%u/plpinfo", hdhomerun_device_get_tuner(hd));
+    return cached_query(cache, hd, QUERY_PLPINFO, name, pplpinfo, NULL);
+}
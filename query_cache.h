@@ -0,0 +1,48 @@
+/*
+ * query_cache.h
+ *
+ * Short-lived cache for HDHomeRun control queries
+ * Collapses repeated get_var round-trips for the same (device, tuner,
+ * variable) within one refresh cycle into a single request.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef QUERY_CACHE_H
+#define QUERY_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hdhomerun.h"
+#include "hdhomerun_device.h"
+
+#define QUERY_CACHE_DEFAULT_TTL_MS 500
+#define QUERY_CACHE_MAX_ENTRIES 32
+
+// A cache is not thread-safe; give each thread (or each operation) its own.
+// Returned strings stay valid until the entry expires and is refetched,
+// query_cache_invalidate() is called, or the cache is destroyed.
+struct query_cache;
+
+struct query_cache* query_cache_create(int ttl_ms);
+void query_cache_destroy(struct query_cache *cache);
+
+// Drop all cached replies, e.g. after a retune or set_var.
+void query_cache_invalidate(struct query_cache *cache);
+
+// Same return conventions as the hdhomerun_device_* calls they wrap.
+int query_cache_get_var(struct query_cache *cache, struct hdhomerun_device_t *hd,
+                        const char *name, char **pvalue);
+int query_cache_get_tuner_status(struct query_cache *cache, struct hdhomerun_device_t *hd,
+                                 char **pstatus_str, struct hdhomerun_tuner_status_t *status);
+int query_cache_get_tuner_streaminfo(struct query_cache *cache, struct hdhomerun_device_t *hd,
+                                     char **pstreaminfo);
+int query_cache_get_tuner_plpinfo(struct query_cache *cache, struct hdhomerun_device_t *hd,
+                                  char **pplpinfo);
+
+#endif // QUERY_CACHE_H
@@ -0,0 +1,173 @@
+/*
+ * scan_db.c
+ *
+ * On-disk cache of per-channel scan results
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include "scan_db.h"
+
+#define SCAN_DB_HEADER "# hdhomerun_tui scan db v1"
+
+struct scan_db {
+    char path[256];
+    int dead_ttl_sec;
+    bool dirty;
+    int count;
+    int capacity;
+    struct scan_db_entry *entries;
+};
+
+// The file is whitespace separated, so an empty map name is stored as "-"
+static const char* map_key(const char *channelmap) {
+    return (channelmap && channelmap[0]) ? channelmap : "-";
+}
+
+static struct scan_db_entry* find_entry(struct scan_db *db, uint32_t device_id,
+                                        const char *channelmap, unsigned int channel) {
+    const char *key = map_key(channelmap);
+    for (int i = 0; i < db->count; i++) {
+        struct scan_db_entry *e = &db->entries[i];
+        if (e->channel == channel && e->device_id == device_id && strcmp(e->channelmap, key) == 0) return e;
+    }
+    return NULL;
+}
+
+static struct scan_db_entry* append_entry(struct scan_db *db) {
+    if (db->count >= SCAN_DB_MAX_ENTRIES) return NULL;
+    if (db->count == db->capacity) {
+        int capacity = db->capacity ? db->capacity * 2 : 256;
+        struct scan_db_entry *entries = realloc(db->entries, capacity * sizeof(struct scan_db_entry));
+        if (!entries) return NULL;
+        db->entries = entries;
+        db->capacity = capacity;
+    }
+    return &db->entries[db->count++];
+}
+
+/*
+ * load_entries
+ * Reads one entry per line; lines that don't parse are dropped.
+ */
+static void load_entries(struct scan_db *db, FILE *f) {
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+
+        struct scan_db_entry e;
+        memset(&e, 0, sizeof(e));
+        long long last_scan, last_lock;
+        int locked;
+        if (sscanf(line, "%" SCNx32 " %31s %u %lld %lld %d %u %u %u %ld %ld %" SCNx64,
+                   &e.device_id, e.channelmap, &e.channel, &last_scan, &last_lock, &locked,
+                   &e.ss, &e.snq, &e.seq, &e.tsid, &e.bsid, &e.plp_mask) != 12) {
+            continue;
+        }
+        e.last_scan = (time_t)last_scan;
+        e.last_lock = (time_t)last_lock;
+        e.locked = locked != 0;
+
+        struct scan_db_entry *slot = find_entry(db, e.device_id, e.channelmap, e.channel);
+        if (!slot) slot = append_entry(db);
+        if (slot) *slot = e;
+    }
+}
+
+struct scan_db* scan_db_open(const char *path, int dead_ttl_sec) {
+    struct scan_db *db = calloc(1, sizeof(struct scan_db));
+    if (!db) return NULL;
+    snprintf(db->path, sizeof(db->path), "%s", path);
+    db->dead_ttl_sec = dead_ttl_sec;
+
+    FILE *f = fopen(path, "r");
+    if (f) {
+        load_entries(db, f);
+        fclose(f);
+    }
+    return db;
+}
+
+int scan_db_save(struct scan_db *db) {
+    if (!db) return -1;
+    if (!db->dirty) return 0;
+
+    char tmp_path[300];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", db->path);
+    FILE *f = fopen(tmp_path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "%s\n", SCAN_DB_HEADER);
+    fprintf(f, "# device map channel last_scan last_lock locked ss snq seq tsid bsid plp_mask\n");
+    for (int i = 0; i < db->count; i++) {
+        const struct scan_db_entry *e = &db->entries[i];
+        fprintf(f, "%08" PRIX32 " %s %u %lld %lld %d %u %u %u %ld %ld %" PRIx64 "\n",
+                e->device_id, e->channelmap, e->channel, (long long)e->last_scan, (long long)e->last_lock,
+                e->locked ? 1 : 0, e->ss, e->snq, e->seq, e->tsid, e->bsid, e->plp_mask);
+    }
+    // Replace the old file only once the new one is complete
+    if (fclose(f) != 0) { remove(tmp_path); return -1; }
+    if (rename(tmp_path, db->path) != 0) return -1;
+    db->dirty = false;
+    return 0;
+}
+
+void scan_db_close(struct scan_db *db) {
+    if (!db) return;
+    scan_db_save(db);
+    free(db->entries);
+    free(db);
+}
+
+void scan_db_record(struct scan_db *db, const struct scan_db_entry *entry) {
+    if (!db || !entry) return;
+
+    struct scan_db_entry *slot = find_entry(db, entry->device_id, entry->channelmap, entry->channel);
+    time_t last_lock = slot ? slot->last_lock : 0;
+    if (!slot) slot = append_entry(db);
+    if (!slot) return;
+
+    *slot = *entry;
+    snprintf(slot->channelmap, sizeof(slot->channelmap), "%s", map_key(entry->channelmap));
+    if (slot->locked) slot->last_lock = entry->last_scan;
+    else if (!slot->last_lock) slot->last_lock = last_lock;
+    db->dirty = true;
+}
+
+const struct scan_db_entry* scan_db_find(struct scan_db *db, uint32_t device_id,
+                                         const char *channelmap, unsigned int channel) {
+    return db ? find_entry(db, device_id, channelmap, channel) : NULL;
+}
+
+enum scan_db_verdict scan_db_verdict(struct scan_db *db, uint32_t device_id, const char *channelmap,
+                                     unsigned int channel, time_t now) {
+    const struct scan_db_entry *e = scan_db_find(db, device_id, channelmap, channel);
+    if (!e) return SCAN_DB_UNKNOWN;
+    if (e->locked) return SCAN_DB_LIVE;
+    if (now - e->last_scan < db->dead_ttl_sec) return SCAN_DB_DEAD;
+    return SCAN_DB_UNKNOWN;
+}
+
+uint64_t scan_db_plp_mask(const char *plpinfo) {
+    uint64_t mask = 0;
+    const char *line = plpinfo;
+    while (line && *line) {
+        if (isdigit((unsigned char)*line)) { // PLP lines start with "<id>:", skip "bsid="
+            int plp_id = atoi(line);
+            if (plp_id >= 0 && plp_id < 64) mask |= (uint64_t)1 << plp_id;
+        }
+        const char *eol = strchr(line, '\n');
+        line = eol ? eol + 1 : NULL;
+    }
+    return mask;
+}
@@ -0,0 +1,73 @@
+/*
+ * scan_db.h
+ *
+ * On-disk cache of per-channel scan results
+ * Remembers, for each device and channel map, which channels locked and
+ * which had nothing, so seek and band scan can go straight to known-live
+ * channels and skip ones that were recently confirmed dead.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef SCAN_DB_H
+#define SCAN_DB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#define SCAN_DB_DEFAULT_PATH "hdhomerun_tui.scandb"
+#define SCAN_DB_DEFAULT_TTL_SEC (24 * 60 * 60)   // How long a dead result is trusted
+#define SCAN_DB_MAX_ENTRIES 8192
+
+struct scan_db_entry {
+    uint32_t device_id;
+    char channelmap[32];        // e.g. "us-bcast"
+    unsigned int channel;
+
+    time_t last_scan;
+    time_t last_lock;           // 0 if the channel has never locked
+    bool locked;                // Outcome of the most recent scan
+    unsigned int ss, snq, seq;  // Percent, from the most recent scan
+    long tsid;                  // STATUS_VALUE_NONE if not seen
+    long bsid;
+    uint64_t plp_mask;          // ATSC 3.0: bit n set if PLP n was present
+};
+
+enum scan_db_verdict {
+    SCAN_DB_UNKNOWN,            // Never scanned, or the dead result has expired
+    SCAN_DB_LIVE,               // Locked the last time it was scanned
+    SCAN_DB_DEAD,               // No lock on the last scan, within the TTL
+};
+
+// Not thread-safe; only the UI thread uses it.
+struct scan_db;
+
+// Loads path if it exists; a missing or unreadable file gives an empty db.
+struct scan_db* scan_db_open(const char *path, int dead_ttl_sec);
+
+// Writes the db back if anything changed. Returns 0 on success.
+int scan_db_save(struct scan_db *db);
+
+// Saves and frees.
+void scan_db_close(struct scan_db *db);
+
+// Adds or replaces the entry for (device_id, channelmap, channel).
+// last_lock is carried over from the old entry when entry did not lock.
+void scan_db_record(struct scan_db *db, const struct scan_db_entry *entry);
+
+const struct scan_db_entry* scan_db_find(struct scan_db *db, uint32_t device_id,
+                                         const char *channelmap, unsigned int channel);
+
+enum scan_db_verdict scan_db_verdict(struct scan_db *db, uint32_t device_id, const char *channelmap,
+                                     unsigned int channel, time_t now);
+
+// Bit mask of the PLP ids listed in a /tunerN/plpinfo reply.
+uint64_t scan_db_plp_mask(const char *plpinfo);
+
+#endif // SCAN_DB_H
@@ -0,0 +1,79 @@
+/*
+ * status_fields.c
+ *
+ * Single-pass parser for HDHomeRun key=value replies
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "status_fields.h"
+
+static const struct {
+    const char *name;
+    size_t len;
+} status_key_names[STATUS_KEY_COUNT] = {
+    [STATUS_KEY_SS]   = { "ss", 2 },
+    [STATUS_KEY_SNQ]  = { "snq", 3 },
+    [STATUS_KEY_SEQ]  = { "seq", 3 },
+    [STATUS_KEY_BPS]  = { "bps", 3 },
+    [STATUS_KEY_PPS]  = { "pps", 3 },
+    [STATUS_KEY_TE]   = { "te", 2 },
+    [STATUS_KEY_NE]   = { "ne", 2 },
+    [STATUS_KEY_SE]   = { "se", 2 },
+    [STATUS_KEY_TSID] = { "tsid", 4 },
+    [STATUS_KEY_BSID] = { "bsid", 4 },
+};
+
+static int lookup_key(const char *key, size_t len) {
+    for (int k = 0; k < STATUS_KEY_COUNT; k++) {
+        if (status_key_names[k].len == len && memcmp(status_key_names[k].name, key, len) == 0) return k;
+    }
+    return -1;
+}
+
+void status_fields_init(struct status_fields *fields) {
+    fields->present = 0;
+    for (int k = 0; k < STATUS_KEY_COUNT; k++) {
+        fields->value[k] = STATUS_VALUE_NONE;
+        fields->db[k] = STATUS_VALUE_NONE;
+    }
+}
+
+void status_fields_parse(struct status_fields *fields, const char *reply) {
+    if (!reply) return;
+    const char *p = reply;
+
+    while (*p) {
+        while (*p && isspace((unsigned char)*p)) p++;
+        const char *key = p;
+        while (*p && *p != '=' && !isspace((unsigned char)*p)) p++;
+        if (*p != '=') continue;    // Not a key=value token, e.g. "tun:"
+
+        size_t key_len = (size_t)(p - key);
+        const char *value = ++p;
+        while (*p && !isspace((unsigned char)*p)) p++;
+
+        int k = lookup_key(key, key_len);
+        if (k < 0 || status_fields_has(fields, (enum status_key)k)) continue;
+
+        fields->present |= 1u << k;
+        fields->value[k] = (value == p) ? 0 : strtol(value, NULL, 0);
+        const char *paren = memchr(value, '(', (size_t)(p - value));
+        if (paren) fields->db[k] = strtol(paren + 1, NULL, 10);
+    }
+}
+
+long status_fields_lookup(const char *reply, enum status_key key) {
+    struct status_fields fields;
+    status_fields_init(&fields);
+    status_fields_parse(&fields, reply);
+    return fields.value[key];
+}
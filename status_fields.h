@@ -0,0 +1,60 @@
+/*
+ * status_fields.h
+ *
+ * Single-pass parser for HDHomeRun key=value replies
+ * Tokenizes a /tunerN/status, /tunerN/debug, streaminfo or plpinfo reply
+ * once into a fixed struct, so readers index a field instead of scanning
+ * the reply again for every key.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef STATUS_FIELDS_H
+#define STATUS_FIELDS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define STATUS_VALUE_NONE -999
+
+enum status_key {
+    STATUS_KEY_SS,          // Signal strength, with dBm in parentheses on newer models
+    STATUS_KEY_SNQ,         // Signal to noise quality, with dB in parentheses
+    STATUS_KEY_SEQ,
+    STATUS_KEY_BPS,
+    STATUS_KEY_PPS,
+    STATUS_KEY_TE,          // /tunerN/debug error counters
+    STATUS_KEY_NE,
+    STATUS_KEY_SE,
+    STATUS_KEY_TSID,        // streaminfo
+    STATUS_KEY_BSID,        // plpinfo
+    STATUS_KEY_COUNT
+};
+
+struct status_fields {
+    uint32_t present;                   // Bit per status_key
+    long value[STATUS_KEY_COUNT];       // strtol base 0, STATUS_VALUE_NONE if absent
+    long db[STATUS_KEY_COUNT];          // Figure in parentheses, e.g. ss=100(-35dBm)
+};
+
+void status_fields_init(struct status_fields *fields);
+
+// Adds the keys found in reply. Several replies can be parsed into the same
+// struct; the first occurrence of a key wins. Only whole keys match, so
+// "te=" is not found inside "rate=".
+void status_fields_parse(struct status_fields *fields, const char *reply);
+
+// One key from one reply, STATUS_VALUE_NONE if absent. When several keys
+// are needed, parse the reply once instead.
+long status_fields_lookup(const char *reply, enum status_key key);
+
+static inline bool status_fields_has(const struct status_fields *fields, enum status_key key) {
+    return (fields->present & (1u << key)) != 0;
+}
+
+#endif // STATUS_FIELDS_H
@@ -0,0 +1,237 @@
+/*
+ * status_poller.c
+ *
+ * Background tuner status polling for HDHomeRun devices
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "status_poller.h"
+
+struct status_poller {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool stop;
+    bool kicked;
+
+    uint32_t device_id;
+    char ip_str[64];
+    int interval_ms;
+    struct hdhomerun_device_t *hd;  // Owned by the poller thread only
+
+    uint32_t watch_mask;
+    struct tuner_status_snapshot snapshots[STATUS_POLLER_MAX_TUNERS];
+};
+
+/*
+ * copy_reply
+ * Copies a control reply into a fixed buffer, always NUL terminating it.
+ */
+static void copy_reply(char *dst, size_t dst_size, const char *src) {
+    if (!src) src = "";
+    strncpy(dst, src, dst_size - 1);
+    dst[dst_size - 1] = '\0';
+}
+
+/*
+ * poll_tuner
+ * Runs every query the status pane needs for one tuner into a scratch
+ * snapshot. Must be called with the poller lock released.
+ */
+static void poll_tuner(struct status_poller *poller, int tuner_index, struct tuner_status_snapshot *snap) {
+    struct hdhomerun_device_t *hd = poller->hd;
+    char *reply;
+
+    memset(snap, 0, sizeof(*snap));
+    status_fields_init(&snap->fields);
+    hdhomerun_device_set_tuner(hd, tuner_index);
+
+    if (hdhomerun_device_get_tuner_status(hd, &reply, &snap->status) <= 0) {
+        return;
+    }
+    snap->valid = true;
+    copy_reply(snap->raw_status, sizeof(snap->raw_status), reply);
+    status_fields_parse(&snap->fields, snap->raw_status);
+
+    if (hdhomerun_device_get_tuner_streaminfo(hd, &reply) > 0) {
+        snap->has_streaminfo = true;
+        copy_reply(snap->streaminfo, sizeof(snap->streaminfo), reply);
+        status_fields_parse(&snap->fields, snap->streaminfo);
+    }
+
+    if (strstr(snap->status.lock_str, "atsc3") != NULL && hdhomerun_device_get_tuner_plpinfo(hd, &reply) > 0) {
+        snap->has_plpinfo = true;
+        copy_reply(snap->plpinfo, sizeof(snap->plpinfo), reply);
+        status_fields_parse(&snap->fields, snap->plpinfo);
+    }
+
+    if (hdhomerun_device_get_tuner_target(hd, &reply) > 0) {
+        snap->has_target = true;
+        copy_reply(snap->target, sizeof(snap->target), reply);
+    }
+
+    char *vstatus_str;
+    if (hdhomerun_device_get_tuner_vstatus(hd, &vstatus_str, &snap->vstatus) > 0) {
+        snap->has_vstatus = true;
+    }
+}
+
+/*
+ * wait_interval
+ * Sleeps until the next poll is due, returning early on kick or stop.
+ * Called with the poller lock held.
+ */
+static void wait_interval(struct status_poller *poller) {
+    struct timeval now;
+    struct timespec deadline;
+    gettimeofday(&now, NULL);
+    long nsec = now.tv_usec * 1000L + (long)(poller->interval_ms % 1000) * 1000000L;
+    deadline.tv_sec = now.tv_sec + poller->interval_ms / 1000 + nsec / 1000000000L;
+    deadline.tv_nsec = nsec % 1000000000L;
+
+    while (!poller->stop && !poller->kicked) {
+        if (pthread_cond_timedwait(&poller->wake, &poller->lock, &deadline) != 0) break;
+    }
+    poller->kicked = false;
+}
+
+static void* status_poller_thread(void *arg) {
+    struct status_poller *poller = (struct status_poller *)arg;
+    struct tuner_status_snapshot *scratch = malloc(sizeof(*scratch));
+
+    pthread_mutex_lock(&poller->lock);
+    while (!poller->stop && scratch) {
+        uint32_t mask = poller->watch_mask;
+        pthread_mutex_unlock(&poller->lock);
+
+        if (!poller->hd) {
+            poller->hd = hdhomerun_device_create_from_str(poller->ip_str, NULL);
+        }
+
+        for (int t = 0; poller->hd && t < STATUS_POLLER_MAX_TUNERS; t++) {
+            if (!(mask & (1u << t))) continue;
+
+            poll_tuner(poller, t, scratch);
+            clock_gettime(CLOCK_MONOTONIC, &scratch->updated);
+
+            pthread_mutex_lock(&poller->lock);
+            scratch->version = poller->snapshots[t].version + 1;
+            poller->snapshots[t] = *scratch;
+            bool stopping = poller->stop;
+            pthread_mutex_unlock(&poller->lock);
+            if (stopping) break;
+        }
+
+        pthread_mutex_lock(&poller->lock);
+        wait_interval(poller);
+    }
+    pthread_mutex_unlock(&poller->lock);
+
+    if (poller->hd) {
+        hdhomerun_device_destroy(poller->hd);
+        poller->hd = NULL;
+    }
+    free(scratch);
+    return NULL;
+}
+
+struct status_poller* status_poller_create(uint32_t device_id, const char *ip_str, int interval_ms) {
+    struct status_poller *poller = calloc(1, sizeof(struct status_poller));
+    if (!poller) return NULL;
+
+    poller->device_id = device_id;
+    copy_reply(poller->ip_str, sizeof(poller->ip_str), ip_str);
+    poller->interval_ms = (interval_ms > 0) ? interval_ms : STATUS_POLLER_DEFAULT_INTERVAL_MS;
+    pthread_mutex_init(&poller->lock, NULL);
+    pthread_cond_init(&poller->wake, NULL);
+
+    if (pthread_create(&poller->thread, NULL, status_poller_thread, poller) != 0) {
+        pthread_cond_destroy(&poller->wake);
+        pthread_mutex_destroy(&poller->lock);
+        free(poller);
+        return NULL;
+    }
+    return poller;
+}
+
+void status_poller_destroy(struct status_poller *poller) {
+    if (!poller) return;
+
+    pthread_mutex_lock(&poller->lock);
+    poller->stop = true;
+    pthread_cond_signal(&poller->wake);
+    pthread_mutex_unlock(&poller->lock);
+
+    pthread_join(poller->thread, NULL);
+    pthread_cond_destroy(&poller->wake);
+    pthread_mutex_destroy(&poller->lock);
+    free(poller);
+}
+
+uint32_t status_poller_get_device_id(struct status_poller *poller) {
+    return poller ? poller->device_id : 0;
+}
+
+void status_poller_watch_tuner(struct status_poller *poller, int tuner_index, bool watch) {
+    if (!poller || tuner_index < 0 || tuner_index >= STATUS_POLLER_MAX_TUNERS) return;
+
+    pthread_mutex_lock(&poller->lock);
+    uint32_t old_mask = poller->watch_mask;
+    if (watch) poller->watch_mask |= (1u << tuner_index);
+    else poller->watch_mask &= ~(1u << tuner_index);
+    if (poller->watch_mask != old_mask) {
+        poller->kicked = true;
+        pthread_cond_signal(&poller->wake);
+    }
+    pthread_mutex_unlock(&poller->lock);
+}
+
+void status_poller_watch_only(struct status_poller *poller, int tuner_index) {
+    if (tuner_index < 0 || tuner_index >= STATUS_POLLER_MAX_TUNERS) return;
+    status_poller_set_watch_mask(poller, 1u << tuner_index);
+}
+
+void status_poller_set_watch_mask(struct status_poller *poller, uint32_t mask) {
+    if (!poller) return;
+
+    pthread_mutex_lock(&poller->lock);
+    if (poller->watch_mask != mask) {
+        poller->watch_mask = mask;
+        poller->kicked = true;
+        pthread_cond_signal(&poller->wake);
+    }
+    pthread_mutex_unlock(&poller->lock);
+}
+
+void status_poller_kick(struct status_poller *poller) {
+    if (!poller) return;
+
+    pthread_mutex_lock(&poller->lock);
+    poller->kicked = true;
+    pthread_cond_signal(&poller->wake);
+    pthread_mutex_unlock(&poller->lock);
+}
+
+uint64_t status_poller_get_snapshot(struct status_poller *poller, int tuner_index, struct tuner_status_snapshot *out) {
+    if (!out) return 0;
+    if (!poller || tuner_index < 0 || tuner_index >= STATUS_POLLER_MAX_TUNERS) {
+        memset(out, 0, sizeof(*out));
+        return 0;
+    }
+
+    pthread_mutex_lock(&poller->lock);
+    *out = poller->snapshots[tuner_index];
+    pthread_mutex_unlock(&poller->lock);
+    return out->version;
+}
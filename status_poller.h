@@ -0,0 +1,76 @@
+/*
+ * status_poller.h
+ *
+ * Background tuner status polling for HDHomeRun devices
+ * Keeps a cached, versioned status snapshot per tuner so the UI never
+ * has to wait on the control channel while redrawing.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef STATUS_POLLER_H
+#define STATUS_POLLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include "hdhomerun.h"
+#include "hdhomerun_device.h"
+#include "status_fields.h"
+
+#define STATUS_POLLER_MAX_TUNERS 16
+#define STATUS_POLLER_DEFAULT_INTERVAL_MS 250
+#define STATUS_SNAPSHOT_RAW_SIZE 512
+#define STATUS_SNAPSHOT_INFO_SIZE 8192
+
+// Everything draw_status_pane needs for one tuner, copied out of the
+// control replies so it stays valid after the next query.
+struct tuner_status_snapshot {
+    uint64_t version;              // Bumped on every completed refresh, 0 = never polled
+    struct timespec updated;       // CLOCK_MONOTONIC time of the last refresh
+    bool valid;                    // Last get_tuner_status succeeded
+
+    struct hdhomerun_tuner_status_t status;
+    char raw_status[STATUS_SNAPSHOT_RAW_SIZE];
+
+    bool has_streaminfo;
+    char streaminfo[STATUS_SNAPSHOT_INFO_SIZE];
+
+    bool has_plpinfo;              // Only fetched when locked to ATSC 3.0
+    char plpinfo[STATUS_SNAPSHOT_INFO_SIZE];
+
+    bool has_target;
+    char target[128];
+
+    bool has_vstatus;
+    struct hdhomerun_tuner_vstatus_t vstatus;
+
+    struct status_fields fields;   // Parsed once from raw_status, streaminfo and plpinfo
+};
+
+struct status_poller;
+
+// Starts a poller thread with its own control connection to the device.
+struct status_poller* status_poller_create(uint32_t device_id, const char *ip_str, int interval_ms);
+void status_poller_destroy(struct status_poller *poller);
+
+uint32_t status_poller_get_device_id(struct status_poller *poller);
+
+// Select which tuners on the device are refreshed each cycle.
+void status_poller_watch_tuner(struct status_poller *poller, int tuner_index, bool watch);
+void status_poller_watch_only(struct status_poller *poller, int tuner_index);
+void status_poller_set_watch_mask(struct status_poller *poller, uint32_t mask);
+
+// Wake the poller early, e.g. right after a retune.
+void status_poller_kick(struct status_poller *poller);
+
+// Copies the latest snapshot for a tuner. Returns its version (0 if none yet).
+uint64_t status_poller_get_snapshot(struct status_poller *poller, int tuner_index,
+                                    struct tuner_status_snapshot *out);
+
+#endif // STATUS_POLLER_H
@@ -0,0 +1,176 @@
+/*
+ * ts_writer.c
+ *
+ * Background file writer for stream captures
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "ts_writer.h"
+
+#define TS_WRITER_IDLE_SLEEP_NS (2 * 1000000L)
+
+struct ts_writer_slot {
+    size_t used;
+    uint8_t data[TS_WRITER_BUFFER_SIZE];
+};
+
+// head is only advanced by the producer and tail only by the consumer;
+// slot contents are published by the release store on head and handed
+// back by the release store on tail.
+struct ts_writer {
+    pthread_t thread;
+    FILE *f;
+
+    _Atomic uint32_t head;      // Next slot the producer fills
+    _Atomic uint32_t tail;      // Next slot the consumer writes
+    atomic_bool done;           // Producer has finished submitting
+    bool write_failed;
+
+    size_t partial;             // Producer: bytes in the unpublished head slot
+    uint64_t bytes_dropped;     // Producer only
+    int max_depth;              // Producer only
+    _Atomic uint64_t bytes_written;
+
+    struct ts_writer_slot slots[TS_WRITER_BUFFER_COUNT];
+};
+
+static void* ts_writer_thread(void *arg) {
+    struct ts_writer *writer = (struct ts_writer *)arg;
+
+    for (;;) {
+        uint32_t tail = atomic_load_explicit(&writer->tail, memory_order_relaxed);
+        uint32_t head = atomic_load_explicit(&writer->head, memory_order_acquire);
+
+        if (tail == head) {
+            if (atomic_load_explicit(&writer->done, memory_order_acquire) &&
+                tail == atomic_load_explicit(&writer->head, memory_order_acquire)) {
+                break;
+            }
+            struct timespec ts = { 0, TS_WRITER_IDLE_SLEEP_NS };
+            nanosleep(&ts, NULL);
+            continue;
+        }
+
+        struct ts_writer_slot *slot = &writer->slots[tail % TS_WRITER_BUFFER_COUNT];
+        if (!writer->write_failed) {
+            size_t written = fwrite(slot->data, 1, slot->used, writer->f);
+            if (written != slot->used) writer->write_failed = true;
+            atomic_fetch_add_explicit(&writer->bytes_written, written, memory_order_relaxed);
+        }
+        atomic_store_explicit(&writer->tail, tail + 1, memory_order_release);
+    }
+    return NULL;
+}
+
+struct ts_writer* ts_writer_start(FILE *f) {
+    if (!f) return NULL;
+    struct ts_writer *writer = calloc(1, sizeof(struct ts_writer));
+    if (!writer) return NULL;
+
+    writer->f = f;
+    atomic_init(&writer->head, 0);
+    atomic_init(&writer->tail, 0);
+    atomic_init(&writer->done, false);
+    atomic_init(&writer->bytes_written, 0);
+
+    if (pthread_create(&writer->thread, NULL, ts_writer_thread, writer) != 0) {
+        free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+/*
+ * publish_head
+ * Hands the slot being filled to the writer thread.
+ */
+static void publish_head(struct ts_writer *writer) {
+    uint32_t head = atomic_load_explicit(&writer->head, memory_order_relaxed);
+    writer->slots[head % TS_WRITER_BUFFER_COUNT].used = writer->partial;
+    writer->partial = 0;
+    atomic_store_explicit(&writer->head, head + 1, memory_order_release);
+}
+
+bool ts_writer_submit(struct ts_writer *writer, const void *data, size_t len) {
+    const uint8_t *src = (const uint8_t *)data;
+    bool complete = true;
+
+    while (len > 0) {
+        uint32_t head = atomic_load_explicit(&writer->head, memory_order_relaxed);
+        uint32_t tail = atomic_load_explicit(&writer->tail, memory_order_acquire);
+        int depth = (int)(head - tail);
+        if (depth > writer->max_depth) writer->max_depth = depth;
+
+        if (depth >= TS_WRITER_BUFFER_COUNT) {
+            // Every buffer is waiting on the disk; drop rather than stall receive
+            writer->bytes_dropped += len;
+            complete = false;
+            break;
+        }
+
+        struct ts_writer_slot *slot = &writer->slots[head % TS_WRITER_BUFFER_COUNT];
+        size_t n = TS_WRITER_BUFFER_SIZE - writer->partial;
+        if (n > len) n = len;
+        memcpy(slot->data + writer->partial, src, n);
+        writer->partial += n;
+        src += n;
+        len -= n;
+
+        if (writer->partial == TS_WRITER_BUFFER_SIZE) publish_head(writer);
+    }
+
+    // Don't let a partly filled slot sit while the writer is idle
+    if (writer->partial > 0 &&
+        atomic_load_explicit(&writer->head, memory_order_relaxed) == atomic_load_explicit(&writer->tail, memory_order_acquire)) {
+        publish_head(writer);
+    }
+    return complete;
+}
+
+int ts_writer_finish(struct ts_writer *writer, struct ts_writer_stats *stats) {
+    if (!writer) return -1;
+
+    if (writer->partial > 0) {
+        // Wait for room so the tail of the capture isn't dropped
+        while ((int)(atomic_load_explicit(&writer->head, memory_order_relaxed) -
+                     atomic_load_explicit(&writer->tail, memory_order_acquire)) >= TS_WRITER_BUFFER_COUNT) {
+            struct timespec ts = { 0, TS_WRITER_IDLE_SLEEP_NS };
+            nanosleep(&ts, NULL);
+        }
+        publish_head(writer);
+    }
+    atomic_store_explicit(&writer->done, true, memory_order_release);
+    pthread_join(writer->thread, NULL);
+
+    if (fclose(writer->f) != 0) writer->write_failed = true;
+    if (stats) {
+        stats->bytes_written = atomic_load(&writer->bytes_written);
+        stats->bytes_dropped = writer->bytes_dropped;
+        stats->max_depth = writer->max_depth;
+        stats->write_failed = writer->write_failed;
+    }
+
+    int result = (writer->write_failed || writer->bytes_dropped > 0) ? -1 : 0;
+    free(writer);
+    return result;
+}
+
+uint64_t ts_writer_bytes_written(struct ts_writer *writer) {
+    return writer ? atomic_load_explicit(&writer->bytes_written, memory_order_relaxed) : 0;
+}
+
+uint64_t ts_writer_bytes_dropped(struct ts_writer *writer) {
+    return writer ? writer->bytes_dropped : 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * ts_writer.h
+ *
+ * Background file writer for stream captures
+ * The receive loop hands data to a lock-free single-producer/single-consumer
+ * queue of pooled buffers, and a writer thread drains it to disk, so a slow
+ * disk never holds up hdhomerun_device_stream_recv.
+ *
+ * HDHomeRun TUI - Copyright (C) 2025 - Mark J. Colombo
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef TS_WRITER_H
+#define TS_WRITER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TS_WRITER_BUFFER_SIZE (1024 * 1024)
+#define TS_WRITER_BUFFER_COUNT 32           // Must be a power of two
+
+struct ts_writer;
+
+// Takes ownership of f and starts the writer thread.
+struct ts_writer* ts_writer_start(FILE *f);
+
+// Producer side: copies data into the next free pooled buffer(s).
+// Never blocks; returns false if the queue was full and data was dropped.
+bool ts_writer_submit(struct ts_writer *writer, const void *data, size_t len);
+
+struct ts_writer_stats {
+    uint64_t bytes_written;
+    uint64_t bytes_dropped;     // Submitted while every buffer was queued
+    int max_depth;              // Most buffers ever waiting on the disk
+    bool write_failed;
+};
+
+// Drains the queue, joins the thread, closes the file and frees the writer.
+// Returns 0 if every byte was written.
+int ts_writer_finish(struct ts_writer *writer, struct ts_writer_stats *stats);
+
+// Safe to call from the producer while the capture runs.
+uint64_t ts_writer_bytes_written(struct ts_writer *writer);
+uint64_t ts_writer_bytes_dropped(struct ts_writer *writer);
+
+#endif // TS_WRITER_H